@@ -84,6 +84,8 @@ import java.util.Map;
 
   public native long[] nativeGetRenderFinishTime(String instanceId);
 
+  public native long[] nativeGetPageMemoryStats(String instanceId);
+
   private native void nativeSetDefaultHeightAndWidthIntoRootDom(String instanceId, float defaultWidth, float defaultHeight, boolean isWidthWrapContent, boolean isHeightWrapContent);
 
   private native void nativeOnInstanceClose(String instanceId);
@@ -104,6 +106,8 @@ import java.util.Map;
 
   private native void nativeMarkDirty(String instanceId, String ref, boolean dirty);
 
+  private native void nativeSetScrollOffset(String instanceId, String ref, float offset);
+
   private native void nativeSetDeviceDisplay(String instanceId, float width, float height, float scale);
 
   private native void nativeRegisterCoreEnv(String key, String value);
@@ -120,6 +124,12 @@ import java.util.Map;
 
   public native String nativeDumpIpcPageQueueInfo();
 
+  /**
+   * Task trace of the WeexCore process, recorded while performance mode is on
+   * (see {@link #setLogType}), as Chrome trace event JSON.
+   */
+  public native String nativeDumpTrace();
+
   /**
    * Update Init Framework Params
    * */
@@ -786,6 +796,11 @@ import java.util.Map;
     return nativeGetRenderFinishTime(instanceId);
   }
 
+  @Override
+  public long[] getPageMemoryStats(String instanceId) {
+    return nativeGetPageMemoryStats(instanceId);
+  }
+
   @Override
   public void setDefaultHeightAndWidthIntoRootDom(String instanceId, float defaultWidth, float defaultHeight, boolean isWidthWrapContent, boolean isHeightWrapContent) {
     nativeSetDefaultHeightAndWidthIntoRootDom(instanceId, defaultWidth, defaultHeight, isWidthWrapContent, isHeightWrapContent);
@@ -831,6 +846,11 @@ import java.util.Map;
     nativeMarkDirty(instanceId, ref, dirty);
   }
 
+  @Override
+  public void setScrollOffset(String instanceId, String ref, float offset) {
+    nativeSetScrollOffset(instanceId, ref, offset);
+  }
+
   @Override
   public void setDeviceDisplay(String instanceId, float width, float height, float scale) {
     nativeSetDeviceDisplay(instanceId, width, height, scale);
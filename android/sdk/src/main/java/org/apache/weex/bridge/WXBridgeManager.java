@@ -446,6 +446,13 @@ public class WXBridgeManager implements Callback, BactchExecutor {
     return "";
   }
 
+  public String dumpTrace(){
+    if (mWXBridge instanceof WXBridge){
+      return ((WXBridge)mWXBridge).nativeDumpTrace();
+    }
+    return "";
+  }
+
   public boolean isRebootExceedLimit(){
     return reInitCount > CRASHREINIT;
   }
@@ -3565,6 +3572,18 @@ public class WXBridgeManager implements Callback, BactchExecutor {
     return new long[]{0, 0, 0};
   }
 
+  /**
+   * Native memory held by a page: render objects, layout nodes, style bytes,
+   * attr bytes, flex lines, posted actions and arena bytes. Empty if the page
+   * is unknown.
+   */
+  public long[] getPageMemoryStats(String instanceId) {
+    if (isJSFrameworkInit()) {
+      return mWXBridge.getPageMemoryStats(instanceId);
+    }
+    return new long[0];
+  }
+
   public void setDeviceDisplay(final String instanceId, final float deviceWidth, final float deviceHeight, final float scale) {
     post(new Runnable() {
       @Override
@@ -3631,6 +3650,17 @@ public class WXBridgeManager implements Callback, BactchExecutor {
       mWXBridge.markDirty(instanceId, ref, dirty);
     }
   }
+
+  public void setScrollOffset(final String instanceId, final String ref, final float offset) {
+    if (isSkipFrameworkInit(instanceId) || isJSFrameworkInit()) {
+      post(new Runnable() {
+        @Override
+        public void run() {
+          mWXBridge.setScrollOffset(instanceId, ref, offset);
+        }
+      });
+    }
+  }
   public void setViewPortWidth(String instanceId,float viewPortWidth){
     if (isSkipFrameworkInit(instanceId) || isJSFrameworkInit()) {
       mWXBridge.setViewPortWidth(instanceId,viewPortWidth);
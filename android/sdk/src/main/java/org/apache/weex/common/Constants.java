@@ -131,6 +131,7 @@ public class Constants {
     String RECYCLE_IMAGE = "recycleImage";
     String LAYOUT = "layout";
     String SPAN_OFFSETS = "spanOffsets";
+    String LAYOUT_WINDOW = "layoutWindow";
     String COLUMN_WIDTH = "columnWidth";
     String COLUMN_COUNT = "columnCount";
     String COLUMN_GAP = "columnGap";
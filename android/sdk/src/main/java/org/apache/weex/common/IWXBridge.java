@@ -186,6 +186,8 @@ public interface IWXBridge extends IWXObject {
 
   long[] getRenderFinishTime(String instanceId);
 
+  long[] getPageMemoryStats(String instanceId);
+
   void setDefaultHeightAndWidthIntoRootDom(String instanceId, float defaultWidth, float defaultHeight, boolean isWidthWrapContent, boolean isHeightWrapContent);
 
   void onInstanceClose(String instanceId);
@@ -206,6 +208,8 @@ public interface IWXBridge extends IWXObject {
 
   void markDirty(String instanceId, String ref, boolean dirty);
 
+  void setScrollOffset(String instanceId, String ref, float offset);
+
   void setDeviceDisplay(String instanceId, float width, float height, float scale);
 
   void registerCoreEnv(String key, String value);
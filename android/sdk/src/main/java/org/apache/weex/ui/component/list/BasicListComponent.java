@@ -47,6 +47,7 @@ import android.widget.LinearLayout;
 import org.apache.weex.WXEnvironment;
 import org.apache.weex.WXSDKInstance;
 import org.apache.weex.annotation.JSMethod;
+import org.apache.weex.bridge.WXBridgeManager;
 import org.apache.weex.common.Constants;
 import org.apache.weex.common.ICheckBindingScroller;
 import org.apache.weex.common.OnWXScrollListener;
@@ -347,6 +348,12 @@ public abstract class BasicListComponent<T extends ViewGroup & ListComponentView
       @Override
       public void onScrolled(RecyclerView recyclerView, int dx, int dy) {
         super.onScrolled(recyclerView, dx, dy);
+        if (WXUtils.getBoolean(getAttrs().get(Constants.Name.LAYOUT_WINDOW), false)) {
+          int offset = getOrientation() == Constants.Orientation.VERTICAL
+              ? recyclerView.computeVerticalScrollOffset()
+              : recyclerView.computeHorizontalScrollOffset();
+          WXBridgeManager.getInstance().setScrollOffset(getInstanceId(), getRef(), offset);
+        }
         List<OnWXScrollListener> listeners = getInstance().getWXScrollListeners();
         if (listeners != null && listeners.size() > 0) {
           try {
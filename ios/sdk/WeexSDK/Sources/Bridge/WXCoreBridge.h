@@ -75,18 +75,18 @@ namespace WeexCore
         int RemoveEvent(const char* pageId, const char* ref, const char *event) override;
         
         int CreateBody(const char* pageId, const char *componentType, const char* ref,
-                           std::map<std::string, std::string> *styles,
-                           std::map<std::string, std::string> *attributes,
-                           std::set<std::string> *events,
+                           SmallStringMap *styles,
+                           SmallStringMap *attributes,
+                           SmallStringSet *events,
                            const WXCoreMargin &margins,
                            const WXCorePadding &paddings,
                            const WXCoreBorderWidth &borders) override;
         
         int AddElement(const char* pageId, const char *componentType, const char* ref,
                            int &index, const char* parentRef,
-                           std::map<std::string, std::string> *styles,
-                           std::map<std::string, std::string> *attributes,
-                           std::set<std::string> *events,
+                           SmallStringMap *styles,
+                           SmallStringMap *attributes,
+                           SmallStringSet *events,
                            const WXCoreMargin &margins,
                            const WXCorePadding &paddings,
                            const WXCoreBorderWidth &borders,
@@ -94,8 +94,8 @@ namespace WeexCore
         
         int AddChildToRichtext(const char* pageId, const char *nodeType, const char* ref,
                                  const char* parentRef, const char* richtextRef,
-                                 std::map<std::string, std::string> *styles,
-                                 std::map<std::string, std::string> *attributes) override;
+                                 SmallStringMap *styles,
+                                 SmallStringMap *attributes) override;
 
         int Layout(const char* pageId, const char* ref,
                        float top, float bottom, float left, float right,
@@ -229,6 +229,9 @@ namespace WeexCore
 // DO NOT call this method directly, you should use WXSDKInstance
 + (void)setViewportWidth:(NSString*)pageId width:(CGFloat)width;
 
+// Scroll offset of a list with layoutWindow set, call it on component thread
++ (void)setScrollOffset:(NSString*)pageId ref:(NSString*)ref offset:(CGFloat)offset;
+
 // DO NOT call this method directly, you should use WXSDKInstance
 + (void)setPageRequired:(NSString *)pageId width:(CGFloat)width height:(CGFloat)height;
 
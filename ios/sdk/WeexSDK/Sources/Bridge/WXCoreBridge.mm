@@ -538,9 +538,9 @@ break; \
     }
         
     int IOSSide::CreateBody(const char* pageId, const char *componentType, const char* ref,
-                                     std::map<std::string, std::string> *styles,
-                                     std::map<std::string, std::string> *attributes,
-                                     std::set<std::string> *events,
+                                     SmallStringMap *styles,
+                                     SmallStringMap *attributes,
+                                     SmallStringSet *events,
                                      const WXCoreMargin &margins,
                                      const WXCorePadding &paddings,
                                      const WXCoreBorderWidth &borders)
@@ -581,9 +581,9 @@ break; \
         
     int IOSSide::AddElement(const char* pageId, const char *componentType, const char* ref,
                            int &index, const char* parentRef,
-                           std::map<std::string, std::string> *styles,
-                           std::map<std::string, std::string> *attributes,
-                           std::set<std::string> *events,
+                           SmallStringMap *styles,
+                           SmallStringMap *attributes,
+                           SmallStringSet *events,
                            const WXCoreMargin &margins,
                            const WXCorePadding &paddings,
                            const WXCoreBorderWidth &borders,
@@ -628,8 +628,8 @@ break; \
     
     int IOSSide::AddChildToRichtext(const char* pageId, const char *nodeType, const char* ref,
                             const char* parentRef, const char* richtextRef,
-                            std::map<std::string, std::string> *styles,
-                            std::map<std::string, std::string> *attributes)
+                            SmallStringMap *styles,
+                            SmallStringMap *attributes)
     {
         RenderPageBase *page = RenderManager::GetInstance()->GetPage(pageId);
         if (page == nullptr) {
@@ -1629,6 +1629,14 @@ static UnicornRenderFunc unicornRenderFunction = nullptr;
     }
 }
 
++ (void)setScrollOffset:(NSString*)pageId ref:(NSString*)ref offset:(CGFloat)offset
+{
+    [WXCoreBridge install];
+    if (platformBridge) {
+        platformBridge->core_side()->SetScrollOffset([pageId UTF8String] ?: "", [ref UTF8String] ?: "", (float)offset);
+    }
+}
+
 + (void)setPageRequired:(NSString *)pageId width:(CGFloat)width height:(CGFloat)height
 {
     [WXCoreBridge install];
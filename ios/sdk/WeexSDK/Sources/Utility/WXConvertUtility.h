@@ -28,6 +28,11 @@
 #include <unordered_map>
 #include <set>
 
+namespace WeexCore {
+    class SmallStringMap;
+    class SmallStringSet;
+}
+
 #define NSSTRING(cstr) ((__bridge_transfer NSString*)(CFStringCreateWithCString(NULL, (const char *)(cstr), kCFStringEncodingUTF8)))
 #define NSSTRING_NO_COPY(cstr) ((__bridge_transfer NSString*)(CFStringCreateWithCStringNoCopy(NULL, (const char *)(cstr), kCFStringEncodingUTF8, kCFAllocatorNull)))
 
@@ -41,8 +46,12 @@ NSMutableDictionary* _Nonnull NSDICTIONARY(std::unordered_map<std::string, std::
 
 NSMutableDictionary* _Nonnull NSDICTIONARY(std::vector<std::pair<std::string, std::string>>* _Nullable vec);
 
+NSMutableDictionary* _Nonnull NSDICTIONARY(WeexCore::SmallStringMap* _Nullable map);
+
 NSMutableArray* _Nonnull NSARRAY(std::set<std::string>* _Nullable set);
 
+NSMutableArray* _Nonnull NSARRAY(WeexCore::SmallStringSet* _Nullable set);
+
 NSMutableArray* _Nonnull NSARRAY(std::vector<std::unordered_map<std::string, std::string>> refs);
 
 void ConvertToCString(id _Nonnull obj, void (^ _Nonnull callback)(const char* _Nullable));
@@ -25,6 +25,7 @@
 
 #include <vector>
 #include <string>
+#include "core/common/small_string_map.h"
 
 static NSString* const JSONSTRING_SUFFIX = @"\t\n\t\r";
 static NSString* const OBJC_MRC_SUFFIX = @"\t\t\n\r";
@@ -227,6 +228,21 @@ NSMutableDictionary* NSDICTIONARY(std::vector<std::pair<std::string, std::string
     return result;
 }
 
+NSMutableDictionary* NSDICTIONARY(WeexCore::SmallStringMap* map)
+{
+    if (map == nullptr || map->size() == 0)
+        return [[NSMutableDictionary alloc] init];
+    
+    NSMutableDictionary* result = [[NSMutableDictionary alloc] initWithCapacity:map->size()];
+    for (auto& p : *map) {
+        id object = TO_OBJECT(NSSTRING(p.second.c_str()));
+        if (object) {
+            [result setObject:object forKey:NSSTRING(p.first.c_str())];
+        }
+    }
+    return result;
+}
+
 NSMutableArray* NSARRAY(std::set<std::string>* set)
 {
     if (set == nullptr || set->size() == 0)
@@ -242,6 +258,21 @@ NSMutableArray* NSARRAY(std::set<std::string>* set)
     return result;
 }
 
+NSMutableArray* NSARRAY(WeexCore::SmallStringSet* set)
+{
+    if (set == nullptr || set->size() == 0)
+        return [[NSMutableArray alloc] init];
+    
+    NSMutableArray* result = [[NSMutableArray alloc] initWithCapacity:set->size()];
+    for (auto& s : *set) {
+        id object = TO_OBJECT(NSSTRING(s.c_str()));
+        if (object) {
+            [result addObject:object];
+        }
+    }
+    return result;
+}
+
 NSMutableArray* NSARRAY(std::vector<std::unordered_map<std::string, std::string>> refs)
 {
     if (refs.size() == 0)
@@ -387,7 +387,7 @@ std::unique_ptr<IPCResult> AndroidBridgeInMultiProcess::CreateBody(
   auto component_type = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1));
   auto ref = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 2));
   // styles
-  std::map<std::string, std::string> styles;
+  SmallStringMap styles;
   if (arguments->getType(3) != IPCType::VOID) {
     auto styles_data = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 3));
     wson_parser styles_parser = wson_parser(styles_data.get());
@@ -402,7 +402,7 @@ std::unique_ptr<IPCResult> AndroidBridgeInMultiProcess::CreateBody(
     }
   }
   // attributes
-  std::map<std::string, std::string> attributes;
+  SmallStringMap attributes;
   if (arguments->getType(4) != IPCType::VOID) {
     auto attributes_data =
         std::unique_ptr<char[]>(getArumentAsCStr(arguments, 4));
@@ -419,7 +419,7 @@ std::unique_ptr<IPCResult> AndroidBridgeInMultiProcess::CreateBody(
     }
   }
   // events
-  std::set<std::string> events;
+  SmallStringSet events;
   if (arguments->getType(5) != IPCType::VOID) {
     auto events_data = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 5));
     wson_parser events_parser = wson_parser(events_data.get());
@@ -482,7 +482,7 @@ std::unique_ptr<IPCResult> AndroidBridgeInMultiProcess::AddElement(
   int index = getArgumentAsInt32(arguments, 3);
   auto parent_ref = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 4));
   // styles
-  std::map<std::string, std::string> styles;
+  SmallStringMap styles;
   if (arguments->getType(5) != IPCType::VOID) {
     auto styles_data = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 5));
     wson_parser styles_parser = wson_parser(styles_data.get());
@@ -497,7 +497,7 @@ std::unique_ptr<IPCResult> AndroidBridgeInMultiProcess::AddElement(
     }
   }
   // attributes
-  std::map<std::string, std::string> attributes;
+  SmallStringMap attributes;
   if (arguments->getType(6) != IPCType::VOID) {
     auto attributes_data =
         std::unique_ptr<char[]>(getArumentAsCStr(arguments, 6));
@@ -514,7 +514,7 @@ std::unique_ptr<IPCResult> AndroidBridgeInMultiProcess::AddElement(
     }
   }
   // events
-  std::set<std::string> events;
+  SmallStringSet events;
   if (arguments->getType(7) != IPCType::VOID) {
     auto events_data = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 7));
     wson_parser events_parser = wson_parser(events_data.get());
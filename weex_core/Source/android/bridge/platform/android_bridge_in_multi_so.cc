@@ -213,9 +213,9 @@ int AndroidBridgeInMultiSo::CallRemoveEvent(const char *pageId, const char *ref,
 
 int AndroidBridgeInMultiSo::CallCreateBody(
     const char *pageId, const char *componentType, const char *ref,
-    std::map<std::string, std::string> *styles,
-    std::map<std::string, std::string> *attributes,
-    std::set<std::string> *events, const WXCoreMargin &margins,
+    SmallStringMap *styles,
+    SmallStringMap *attributes,
+    SmallStringSet *events, const WXCoreMargin &margins,
     const WXCorePadding &paddings, const WXCoreBorderWidth &borders) {
   return WeexCoreManager::Instance()
       ->getPlatformBridge()
@@ -226,9 +226,9 @@ int AndroidBridgeInMultiSo::CallCreateBody(
 
 int AndroidBridgeInMultiSo::CallAddElement(
     const char *pageId, const char *componentType, const char *ref, int &index,
-    const char *parentRef, std::map<std::string, std::string> *styles,
-    std::map<std::string, std::string> *attributes,
-    std::set<std::string> *events, const WXCoreMargin &margins,
+    const char *parentRef, SmallStringMap *styles,
+    SmallStringMap *attributes,
+    SmallStringSet *events, const WXCoreMargin &margins,
     const WXCorePadding &paddings, const WXCoreBorderWidth &borders,
     bool willLayout) {
   return WeexCoreManager::Instance()
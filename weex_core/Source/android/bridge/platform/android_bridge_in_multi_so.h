@@ -73,18 +73,18 @@ class AndroidBridgeInMultiSo : public PlatformBridge {
 
   static int CallCreateBody(const char* pageId, const char* componentType,
                             const char* ref,
-                            std::map<std::string, std::string>* styles,
-                            std::map<std::string, std::string>* attributes,
-                            std::set<std::string>* events,
+                            SmallStringMap* styles,
+                            SmallStringMap* attributes,
+                            SmallStringSet* events,
                             const WXCoreMargin& margins,
                             const WXCorePadding& paddings,
                             const WXCoreBorderWidth& borders);
 
   static int CallAddElement(const char* pageId, const char* componentType,
                             const char* ref, int& index, const char* parentRef,
-                            std::map<std::string, std::string>* styles,
-                            std::map<std::string, std::string>* attributes,
-                            std::set<std::string>* events,
+                            SmallStringMap* styles,
+                            SmallStringMap* attributes,
+                            SmallStringSet* events,
                             const WXCoreMargin& margins,
                             const WXCorePadding& paddings,
                             const WXCoreBorderWidth& borders,
@@ -121,8 +121,8 @@ int AndroidSide::CallNative(const char *page_id, const char *task,
   return flag;
 }
 int AndroidSide::AddChildToRichtext(const char *pageId, const char *nodeType, const char *ref, const char *parentRef,
-                                    const char *richtextRef, std::map<std::string, std::string> *styles,
-                                    std::map<std::string, std::string> *attributes) {
+                                    const char *richtextRef, SmallStringMap *styles,
+                                    SmallStringMap *attributes) {
     JNIEnv *env = base::android::AttachCurrentThread();
     if (env == nullptr)
         return -1;
@@ -306,9 +306,9 @@ int AndroidSide::RemoveEvent(const char *page_id, const char *ref,
 
 int AndroidSide::CreateBody(const char *page_id, const char *component_type,
                             const char *ref,
-                            std::map<std::string, std::string> *styles,
-                            std::map<std::string, std::string> *attributes,
-                            std::set<std::string> *events,
+                            SmallStringMap *styles,
+                            SmallStringMap *attributes,
+                            SmallStringSet *events,
                             const WXCoreMargin &margins,
                             const WXCorePadding &paddings,
                             const WXCoreBorderWidth &borders) {
@@ -327,9 +327,9 @@ int AndroidSide::CreateBody(const char *page_id, const char *component_type,
 
 int AndroidSide::AddElement(const char *page_id, const char *component_type,
                             const char *ref, int &index, const char *parentRef,
-                            std::map<std::string, std::string> *styles,
-                            std::map<std::string, std::string> *attributes,
-                            std::set<std::string> *events,
+                            SmallStringMap *styles,
+                            SmallStringMap *attributes,
+                            SmallStringSet *events,
                             const WXCoreMargin &margins,
                             const WXCorePadding &paddings,
                             const WXCoreBorderWidth &borders, bool willLayout) {
@@ -67,22 +67,22 @@ class AndroidSide : public PlatformBridge::PlatformSide {
   int RemoveEvent(const char* page_id, const char* ref,
                   const char* event) override;
   int CreateBody(const char* pageId, const char* componentType, const char* ref,
-                 std::map<std::string, std::string>* styles,
-                 std::map<std::string, std::string>* attributes,
-                 std::set<std::string>* events, const WXCoreMargin& margins,
+                 SmallStringMap* styles,
+                 SmallStringMap* attributes,
+                 SmallStringSet* events, const WXCoreMargin& margins,
                  const WXCorePadding& paddings,
                  const WXCoreBorderWidth& borders) override;
 
   int AddElement(const char* pageId, const char* componentType, const char* ref,
                  int& index, const char* parentRef,
-                 std::map<std::string, std::string>* styles,
-                 std::map<std::string, std::string>* attributes,
-                 std::set<std::string>* events, const WXCoreMargin& margins,
+                 SmallStringMap* styles,
+                 SmallStringMap* attributes,
+                 SmallStringSet* events, const WXCoreMargin& margins,
                  const WXCorePadding& paddings,
                  const WXCoreBorderWidth& borders, bool willLayout) override;
   int AddChildToRichtext(const char *pageId, const char *nodeType, const char *ref, const char *parentRef,
-                         const char *richtextRef, std::map<std::string, std::string> *styles,
-                         std::map<std::string, std::string> *attributes) override;
+                         const char *richtextRef, SmallStringMap *styles,
+                         SmallStringMap *attributes) override;
   int RemoveChildFromRichtext(const char *pageId, const char *ref, const char *parent_ref,
                               const char *richtext_ref) override;
   int UpdateRichtextStyle(const char *pageId, const char *ref,
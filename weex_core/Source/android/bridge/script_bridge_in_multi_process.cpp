@@ -35,44 +35,35 @@
 #include "base/android/jni/android_jni.h"
 #include "core/bridge/script/core_side_in_script.h"
 #include "core/manager/weex_core_manager.h"
+#include "core/parser/dom_wson.h"
+#include "core/render/manager/render_manager.h"
 #include "third_party/IPC/IPCArguments.h"
+#include "third_party/IPC/IPCBatch.h"
 #include "third_party/IPC/IPCHandler.h"
 #include "third_party/IPC/IPCMessageJS.h"
 #include "third_party/IPC/IPCResult.h"
+#include "third_party/IPC/IPCSchema.h"
 
 namespace WeexCore {
 
-static std::unique_ptr<IPCResult> HandleSetJSVersion(IPCArguments *arguments) {
+using namespace IPCProxySchema;
+
+static std::unique_ptr<IPCResult> HandleSetJSVersion(
+    const IPCMessageView<SetJSFVersion> &message) {
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
-      weex::base::MakeCopyable([version = std::unique_ptr<char[]>(
-          getArumentAsCStr(arguments, 0))] {
+      weex::base::MakeCopyable([args = IPCMessageCopy<SetJSFVersion>(message)] {
         WeexCoreManager::Instance()->script_bridge()->core_side()->SetJSVersion(
-            version.get());
+            args.get<0>());
       }));
 
   return createVoidResult();
 }
 
 static std::unique_ptr<IPCResult> HandleReportException(
-    IPCArguments *arguments) {
-  const char *pageId = nullptr;
-  const char *func = nullptr;
-  const char *exceptionInfo = nullptr;
-
-  if (arguments->getType(0) == IPCType::BYTEARRAY) {
-    const IPCByteArray *instanceIDBA = arguments->getByteArray(0);
-    pageId = instanceIDBA->content;
-  }
-
-  if (arguments->getType(1) == IPCType::BYTEARRAY) {
-    const IPCByteArray *funcBA = arguments->getByteArray(1);
-    func = funcBA->content;
-  }
-
-  if (arguments->getType(2) == IPCType::BYTEARRAY) {
-    const IPCByteArray *exceptionInfoBA = arguments->getByteArray(2);
-    exceptionInfo = exceptionInfoBA->content;
-  }
+    const IPCMessageView<ReportException> &message) {
+  const char *pageId = message.get<0>();
+  const char *func = message.get<1>();
+  const char *exceptionInfo = message.get<2>();
 
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
       weex::base::MakeCopyable([pageId = std::string(pageId == nullptr ? "" : pageId),
@@ -88,12 +79,12 @@ static std::unique_ptr<IPCResult> HandleReportException(
   return createVoidResult();
 }
 
-static std::unique_ptr<IPCResult> HandleCallNativeLog(IPCArguments *arguments) {
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
+static std::unique_ptr<IPCResult> HandleCallNativeLog(
+    const IPCMessageView<NativeLog> &message) {
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
-      weex::base::MakeCopyable([str_array = std::move(arg1)] {
+      weex::base::MakeCopyable([args = IPCMessageCopy<NativeLog>(message)] {
         WeexCoreManager::Instance()->script_bridge()->core_side()->NativeLog(
-            str_array.get());
+            args.get<0>());
       }));
 
   //  const char *str_array = getArumentAsCStr(arguments, 0);
@@ -102,14 +93,12 @@ static std::unique_ptr<IPCResult> HandleCallNativeLog(IPCArguments *arguments) {
   return createInt32Result(static_cast<int32_t>(true));
 }
 
-static std::unique_ptr<IPCResult> HandleSetTimeout(IPCArguments *arguments) {
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
-  auto arg2 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1));
+static std::unique_ptr<IPCResult> HandleSetTimeout(
+    const IPCMessageView<SetTimeout> &message) {
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
-      weex::base::MakeCopyable([callbackID = std::move(arg1),
-                                   time = std::move(arg2)] {
+      weex::base::MakeCopyable([args = IPCMessageCopy<SetTimeout>(message)] {
         WeexCoreManager::Instance()->script_bridge()->core_side()->SetTimeout(
-            callbackID.get(), time.get());
+            args.get<0>(), args.get<1>());
       }));
 
   //  char *callbackID = getArumentAsCStr(arguments, 0);
@@ -132,16 +121,12 @@ static std::unique_ptr<IPCResult> HandleSetTimeout(IPCArguments *arguments) {
   return createInt32Result(static_cast<int32_t>(true));
 }
 
-static std::unique_ptr<IPCResult> HandleSetInterval(IPCArguments *arguments) {
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
-  auto arg2 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1));
-  auto arg3 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 2));
+static std::unique_ptr<IPCResult> HandleSetInterval(
+    const IPCMessageView<SetInterval> &message) {
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
-      weex::base::MakeCopyable([pageId = std::move(arg1),
-                                   callbackID = std::move(arg2),
-                                   time = std::move(arg3)] {
+      weex::base::MakeCopyable([args = IPCMessageCopy<SetInterval>(message)] {
         WeexCoreManager::Instance()->script_bridge()->core_side()->SetInterval(
-            pageId.get(), callbackID.get(), time.get());
+            args.get<0>(), args.get<1>(), args.get<2>());
       }));
 
   //  const char *pageId = getArumentAsCStr(arguments, 0);
@@ -172,56 +157,38 @@ static std::unique_ptr<IPCResult> HandleSetInterval(IPCArguments *arguments) {
   return createInt32Result(1);
 }
 
-static std::unique_ptr<IPCResult> HandleClearInterval(IPCArguments *arguments) {
-  const char *pageId = getArumentAsCStr(arguments, 0);
-  const char *callbackID = getArumentAsCStr(arguments, 1);
-  long id = atoi(callbackID);
-
-  if (pageId != nullptr) {
-    delete[] pageId;
-    pageId = nullptr;
-  }
-  if (callbackID != nullptr) {
-    delete[] callbackID;
-    callbackID = nullptr;
-  }
+static std::unique_ptr<IPCResult> HandleClearInterval(
+    const IPCMessageView<ClearInterval> &message) {
   return createVoidResult();
 }
 
-static std::unique_ptr<IPCResult> HandleCallNative(IPCArguments *arguments) {
+static std::unique_ptr<IPCResult> HandleCallNative(
+    const IPCMessageView<CallNative> &message) {
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
-      weex::base::MakeCopyable(
-          [pageId = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0)),
-              task = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1)),
-              callback = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 2))] {
-            if (pageId != nullptr && task != nullptr) {
-              WeexCoreManager::Instance()
-                  ->script_bridge()
-                  ->core_side()
-                  ->CallNative(pageId.get(), task.get(), callback.get());
-            }
-          }));
+      weex::base::MakeCopyable([args = IPCMessageCopy<CallNative>(message)] {
+        if (args.get<0>() != nullptr && args.get<1>() != nullptr) {
+          WeexCoreManager::Instance()->script_bridge()->core_side()->CallNative(
+              args.get<0>(), args.get<1>(), args.get<2>());
+        }
+      }));
   return createInt32Result(0);
 }
 
 static std::unique_ptr<IPCResult> HandleCallGCanvasLinkNative(
-    IPCArguments *arguments) {
-
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
-  auto typeStr = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1));
-  int type = atoi(typeStr.get());
-  auto arg3 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 2));
+    const IPCMessageView<CallGCanvasLink> &message) {
+  // The script thread is blocked on |event|, so the view stays valid.
+  int type = atoi(message.get<1>() == nullptr ? "\0" : message.get<1>());
   weex::base::WaitableEvent event;
   char *retVal = nullptr;
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
       weex::base::MakeCopyable(
-          [pageId = std::move(arg1), t = type,
-              args = std::move(arg3), returnResult = &retVal, e = &event] {
+          [&message, t = type, returnResult = &retVal, e = &event] {
             *returnResult =
                 const_cast<char *>(WeexCoreManager::Instance()
                     ->script_bridge()
                     ->core_side()
-                    ->CallGCanvasLinkNative(pageId.get(), t, args.get()));
+                    ->CallGCanvasLinkNative(message.get<0>(), t,
+                                            message.get<2>()));
             e->Signal();
           }));
 
@@ -255,22 +222,19 @@ static std::unique_ptr<IPCResult> HandleCallGCanvasLinkNative(
   return ret;
 }
 
-static std::unique_ptr<IPCResult> HandleT3DLinkNative(IPCArguments *arguments) {
-
-  auto typeStr = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
-  int type = atoi(typeStr.get());
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1));
+static std::unique_ptr<IPCResult> HandleT3DLinkNative(
+    const IPCMessageView<CallT3DLink> &message) {
+  int type = atoi(message.get<0>() == nullptr ? "\0" : message.get<0>());
   weex::base::WaitableEvent event;
   char *retVal = nullptr;
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
       weex::base::MakeCopyable(
-          [args = std::move(arg1), t = type,
-              returnResult = &retVal, e = &event] {
+          [&message, t = type, returnResult = &retVal, e = &event] {
             *returnResult =
                 const_cast<char *>(WeexCoreManager::Instance()
                     ->script_bridge()
                     ->core_side()
-                    ->CallT3DLinkNative(t, args.get()));
+                    ->CallT3DLinkNative(t, message.get<1>()));
             e->Signal();
           }));
 
@@ -303,31 +267,21 @@ static std::unique_ptr<IPCResult> HandleT3DLinkNative(IPCArguments *arguments) {
 }
 
 static std::unique_ptr<IPCResult> HandleCallNativeModule(
-    IPCArguments *arguments) {
-  int argumentsDataLength = getArumentAsCStrLen(arguments, 3);
-  int optionsDataLength = getArumentAsCStrLen(arguments, 4);
-
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
-  auto arg2 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1));
-  auto arg3 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 2));
-  auto arg4 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 3));
-  auto arg5 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 4));
-
+    const IPCMessageView<CallNativeModule> &message) {
+  // Synchronous, the arguments are read in place while this thread waits.
   weex::base::WaitableEvent event;
   std::unique_ptr<ValueWithType> ret;
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
       weex::base::MakeCopyable(
-          [pageId = std::move(arg1), module = std::move(arg2),
-              method = std::move(arg3), argumentsData = std::move(arg4),
-              optionsData = std::move(arg5), length1 = argumentsDataLength,
-              length2 = optionsDataLength, result = &ret, e = &event] {
+          [&message, result = &ret, e = &event] {
             *result =
                 WeexCoreManager::Instance()
                     ->script_bridge()
                     ->core_side()
-                    ->CallNativeModule(pageId.get(), module.get(), method.get(),
-                                       argumentsData.get(), length1,
-                                       optionsData.get(), length2);
+                    ->CallNativeModule(message.get<0>(), message.get<1>(),
+                                       message.get<2>(), message.get<3>(),
+                                       message.length<3>(), message.get<4>(),
+                                       message.length<4>());
             e->Signal();
           }));
 
@@ -373,33 +327,19 @@ static std::unique_ptr<IPCResult> HandleCallNativeModule(
 }
 
 static std::unique_ptr<IPCResult> HandleCallNativeComponent(
-    IPCArguments *arguments) {
-  //  char *pageId = getArumentAsCStr(arguments, 0);
-  //  char *ref = getArumentAsCStr(arguments, 1);
-  //  char *method = getArumentAsCStr(arguments, 2);
-  //  char *argumentsData = getArumentAsCStr(arguments, 3);
-  int argumentsDataLength = getArumentAsCStrLen(arguments, 3);
-  //  char *optionsData = getArumentAsCStr(arguments, 4);
-  int optionsDataLength = getArumentAsCStrLen(arguments, 4);
-
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
-  auto arg2 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1));
-  auto arg3 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 2));
-  auto arg4 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 3));
-  auto arg5 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 4));
+    const IPCMessageView<CallNativeComponent> &message) {
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
       weex::base::MakeCopyable(
-          [pageId = std::move(arg1), ref = std::move(arg2),
-              method = std::move(arg3), argumentsData = std::move(arg4),
-              optionsData = std::move(arg5), l1 = argumentsDataLength,
-              l2 = optionsDataLength] {
-            if (pageId != nullptr && ref != nullptr && method != nullptr) {
+          [args = IPCMessageCopy<CallNativeComponent>(message)] {
+            if (args.get<0>() != nullptr && args.get<1>() != nullptr &&
+                args.get<2>() != nullptr) {
               WeexCoreManager::Instance()
                   ->script_bridge()
                   ->core_side()
-                  ->CallNativeComponent(pageId.get(), ref.get(), method.get(),
-                                        argumentsData.get(), l1,
-                                        optionsData.get(), l2);
+                  ->CallNativeComponent(args.get<0>(), args.get<1>(),
+                                        args.get<2>(), args.get<3>(),
+                                        args.length<3>(), args.get<4>(),
+                                        args.length<4>());
             }
           }));
 
@@ -446,14 +386,11 @@ static std::unique_ptr<IPCResult> HandleCallNativeComponent(
 }
 
 static std::unique_ptr<IPCResult> FunctionCallCreateBody(
-    IPCArguments *arguments) {
+    const IPCMessageView<CallCreateBody> &message) {
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
-      weex::base::MakeCopyable([page_id = std::unique_ptr<char[]>(
-          getArumentAsCStr(arguments, 0)),
-                                   dom_str = std::unique_ptr<char[]>(
-                                       getArumentAsCStr(arguments, 1))] {
+      weex::base::MakeCopyable([args = IPCMessageCopy<CallCreateBody>(message)] {
         WeexCoreManager::Instance()->script_bridge()->core_side()->CreateBody(
-            page_id.get(), dom_str.get(), strlen(dom_str.get()));
+            args.get<0>(), args.get<1>(), args.length<1>());
       }));
 
   //  auto page_id = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
@@ -470,24 +407,17 @@ static std::unique_ptr<IPCResult> FunctionCallCreateBody(
 }
 
 static std::unique_ptr<IPCResult> HandleCallAddElement(
-    IPCArguments *arguments) {
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
-  auto arg2 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1));
-  auto arg3 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 2));
-  auto arg4 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 3));
+    const IPCMessageView<CallAddElement> &message) {
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
-      weex::base::MakeCopyable([page_id = std::move(arg1),
-                                   parent_ref = std::move(arg2),
-                                   dom_str = std::move(arg3),
-                                   index_cstr = std::move(arg4)] {
+      weex::base::MakeCopyable([args = IPCMessageCopy<CallAddElement>(message)] {
         const char *index_char =
-            index_cstr.get() == nullptr ? "\0" : index_cstr.get();
+            args.get<3>() == nullptr ? "\0" : args.get<3>();
         int index = atoi(index_char);
-        if (page_id.get() != nullptr && parent_ref.get() != nullptr &&
-            dom_str.get() != nullptr && index >= -1) {
+        if (args.get<0>() != nullptr && args.get<1>() != nullptr &&
+            args.get<2>() != nullptr && index >= -1) {
           WeexCoreManager::Instance()->script_bridge()->core_side()->AddElement(
-              page_id.get(), parent_ref.get(), dom_str.get(),
-              strlen(dom_str.get()), index_char);
+              args.get<0>(), args.get<1>(), args.get<2>(), args.length<2>(),
+              index_char);
         }
       }));
 
@@ -536,18 +466,16 @@ static std::unique_ptr<IPCResult> HandleCallAddElement(
 }
 
 static std::unique_ptr<IPCResult> FunctionCallRemoveElement(
-    IPCArguments *arguments) {
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
-  auto arg2 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1));
-  if (arg1.get() == nullptr || arg2.get() == nullptr)
+    const IPCMessageView<CallRemoveElement> &message) {
+  if (message.get<0>() == nullptr || message.get<1>() == nullptr)
     return createInt32Result(0);
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
       weex::base::MakeCopyable(
-          [pageId = std::move(arg1), ref = std::move(arg2)] {
+          [args = IPCMessageCopy<CallRemoveElement>(message)] {
             WeexCoreManager::Instance()
                 ->script_bridge()
                 ->core_side()
-                ->RemoveElement(pageId.get(), ref.get());
+                ->RemoveElement(args.get<0>(), args.get<1>());
           }));
 
   //  char *pageId = getArumentAsCStr(arguments, 0);
@@ -568,21 +496,22 @@ static std::unique_ptr<IPCResult> FunctionCallRemoveElement(
 }
 
 static std::unique_ptr<IPCResult> FunctionCallMoveElement(
-    IPCArguments *arguments) {
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
-  auto arg2 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1));
-  auto arg3 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 2));
-  auto arg4 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 3));
-  int index = atoi(arg4.get());
-  if (arg1 == nullptr || arg2 == nullptr || arg3 == nullptr ||
-      arg4 == nullptr || index < -1)
+    const IPCMessageView<CallMoveElement> &message) {
+  if (message.get<0>() == nullptr || message.get<1>() == nullptr ||
+      message.get<2>() == nullptr || message.get<3>() == nullptr)
+    return createInt32Result(0);
+  int index = atoi(message.get<3>());
+  if (index < -1)
     return createInt32Result(0);
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
-      weex::base::MakeCopyable([pageId = std::move(arg1), ref = std::move(arg2),
-                                   parentRef = std::move(arg3), index = index] {
-        WeexCoreManager::Instance()->script_bridge()->core_side()->MoveElement(
-            pageId.get(), ref.get(), parentRef.get(), index);
-      }));
+      weex::base::MakeCopyable(
+          [args = IPCMessageCopy<CallMoveElement>(message), index = index] {
+            WeexCoreManager::Instance()
+                ->script_bridge()
+                ->core_side()
+                ->MoveElement(args.get<0>(), args.get<1>(), args.get<2>(),
+                              index);
+          }));
 
   //  char *pageId = getArumentAsCStr(arguments, 0);
   //  char *ref = getArumentAsCStr(arguments, 1);
@@ -605,17 +534,14 @@ static std::unique_ptr<IPCResult> FunctionCallMoveElement(
 }
 
 static std::unique_ptr<IPCResult> FunctionCallAddEvent(
-    IPCArguments *arguments) {
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
-  auto arg2 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1));
-  auto arg3 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 2));
-  if (arg1 == nullptr || arg2 == nullptr || arg3 == nullptr)
+    const IPCMessageView<CallAddEvent> &message) {
+  if (message.get<0>() == nullptr || message.get<1>() == nullptr ||
+      message.get<2>() == nullptr)
     return createInt32Result(0);
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
-      weex::base::MakeCopyable([pageId = std::move(arg1), ref = std::move(arg2),
-                                   event = std::move(arg3)] {
+      weex::base::MakeCopyable([args = IPCMessageCopy<CallAddEvent>(message)] {
         WeexCoreManager::Instance()->script_bridge()->core_side()->AddEvent(
-            pageId.get(), ref.get(), event.get());
+            args.get<0>(), args.get<1>(), args.get<2>());
       }));
 
   //  char *pageId = getArumentAsCStr(arguments, 0);
@@ -635,17 +561,14 @@ static std::unique_ptr<IPCResult> FunctionCallAddEvent(
 }
 
 static std::unique_ptr<IPCResult> FunctionCallRemoveEvent(
-    IPCArguments *arguments) {
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
-  auto arg2 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1));
-  auto arg3 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 2));
-  if (arg1 == nullptr || arg2 == nullptr || arg3 == nullptr)
+    const IPCMessageView<CallRemoveEvent> &message) {
+  if (message.get<0>() == nullptr || message.get<1>() == nullptr ||
+      message.get<2>() == nullptr)
     return createInt32Result(0);
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
-      weex::base::MakeCopyable([pageId = std::move(arg1), ref = std::move(arg2),
-                                   event = std::move(arg3)] {
+      weex::base::MakeCopyable([args = IPCMessageCopy<CallRemoveEvent>(message)] {
         WeexCoreManager::Instance()->script_bridge()->core_side()->RemoveEvent(
-            pageId.get(), ref.get(), event.get());
+            args.get<0>(), args.get<1>(), args.get<2>());
       }));
 
   //  char *pageId = getArumentAsCStr(arguments, 0);
@@ -665,21 +588,14 @@ static std::unique_ptr<IPCResult> FunctionCallRemoveEvent(
 }
 
 static std::unique_ptr<IPCResult> FunctionCallUpdateStyle(
-    IPCArguments *arguments) {
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
-  auto arg2 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1));
-  auto arg3 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 2));
-  if (arg1 == nullptr || arg2 == nullptr || arg3 == nullptr)
+    const IPCMessageView<CallUpdateStyle> &message) {
+  if (message.get<0>() == nullptr || message.get<1>() == nullptr ||
+      message.get<2>() == nullptr)
     return createInt32Result(0);
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
-      weex::base::MakeCopyable([page_id = std::move(arg1),
-                                   ref = std::move(arg2), data = std::move(arg3)] {
-        if (page_id.get() == nullptr || ref.get() == nullptr ||
-            data.get() == nullptr)
-          return;
-
+      weex::base::MakeCopyable([args = IPCMessageCopy<CallUpdateStyle>(message)] {
         WeexCoreManager::Instance()->script_bridge()->core_side()->UpdateStyle(
-            page_id.get(), ref.get(), data.get(), strlen(data.get()));
+            args.get<0>(), args.get<1>(), args.get<2>(), args.length<2>());
       }));
   //  char *pageId = getArumentAsCStr(arguments, 0);
   //  char *ref = getArumentAsCStr(arguments, 1);
@@ -698,19 +614,14 @@ static std::unique_ptr<IPCResult> FunctionCallUpdateStyle(
 }
 
 static std::unique_ptr<IPCResult> FunctionCallUpdateAttrs(
-    IPCArguments *arguments) {
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
-  auto arg2 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1));
-  auto arg3 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 2));
+    const IPCMessageView<CallUpdateAttrs> &message) {
+  if (message.get<0>() == nullptr || message.get<1>() == nullptr ||
+      message.get<2>() == nullptr)
+    return createInt32Result(0);
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
-      weex::base::MakeCopyable([page_id = std::move(arg1),
-                                   ref = std::move(arg2), data = std::move(arg3)] {
-        if (page_id.get() == nullptr || ref.get() == nullptr ||
-            data.get() == nullptr)
-          return;
-
+      weex::base::MakeCopyable([args = IPCMessageCopy<CallUpdateAttrs>(message)] {
         WeexCoreManager::Instance()->script_bridge()->core_side()->UpdateAttrs(
-            page_id.get(), ref.get(), data.get(), strlen(data.get()));
+            args.get<0>(), args.get<1>(), args.get<2>(), args.length<2>());
       }));
   //  char *pageId = getArumentAsCStr(arguments, 0);
   //  char *ref = getArumentAsCStr(arguments, 1);
@@ -728,15 +639,137 @@ static std::unique_ptr<IPCResult> FunctionCallUpdateAttrs(
   return createInt32Result(0);
 }
 
-static std::unique_ptr<IPCResult> FunctionCallCreateFinish(
-    IPCArguments *arguments) {
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
+// Style or attr updates of one ref, merged until a structural dom action
+// is met in the batch.
+struct PendingDomUpdate {
+  const char *ref;
+  bool is_style;
+  const char *data;
+  int length;
+  std::vector<std::pair<std::string, std::string>> *pairs;
+};
+
+static void MergeDomUpdate(std::vector<PendingDomUpdate> &pending,
+                           bool is_style, const char *ref, const char *data,
+                           int length) {
+  for (auto &update : pending) {
+    if (update.is_style != is_style || strcmp(update.ref, ref) != 0) continue;
+    if (update.pairs == nullptr) {
+      update.pairs = Wson2Pairs(update.data);
+      if (update.pairs == nullptr) {
+        update.pairs = new std::vector<std::pair<std::string, std::string>>();
+      }
+    }
+    std::unique_ptr<std::vector<std::pair<std::string, std::string>>> pairs(
+        Wson2Pairs(data));
+    if (pairs == nullptr) return;
+    // A repeated key moves to the end, so the merged pairs keep the order of
+    // the last writes; a shorthand set after its longhand must still win.
+    for (auto &pair : *pairs) {
+      for (auto it = update.pairs->begin(); it != update.pairs->end(); ++it) {
+        if (it->first == pair.first) {
+          update.pairs->erase(it);
+          break;
+        }
+      }
+      update.pairs->push_back(std::move(pair));
+    }
+    return;
+  }
+  pending.push_back({ref, is_style, data, length, nullptr});
+}
+
+static void ApplyDomUpdates(const char *page_id,
+                            std::vector<PendingDomUpdate> &pending) {
+  auto core_side = WeexCoreManager::Instance()->script_bridge()->core_side();
+  for (auto &update : pending) {
+    if (update.pairs == nullptr) {
+      if (update.is_style) {
+        core_side->UpdateStyle(page_id, update.ref, update.data, update.length);
+      } else {
+        core_side->UpdateAttrs(page_id, update.ref, update.data, update.length);
+      }
+    } else if (update.is_style) {
+      RenderManager::GetInstance()->UpdateStyle(page_id, update.ref,
+                                                update.pairs);
+    } else {
+      RenderManager::GetInstance()->UpdateAttr(page_id, update.ref,
+                                               update.pairs);
+    }
+  }
+  pending.clear();
+}
+
+static void ApplyDomBatch(const char *page_id, const char *batch,
+                          size_t length) {
+  auto core_side = WeexCoreManager::Instance()->script_bridge()->core_side();
+  std::vector<PendingDomUpdate> pending;
+  IPCBatchReader reader(batch, length);
+  while (reader.next()) {
+    auto msg = static_cast<IPCProxyMsg>(reader.msg());
+    if (msg == IPCProxyMsg::CALLUPDATESTYLE ||
+        msg == IPCProxyMsg::CALLUPDATEATTRS) {
+      if (reader.argc() < 2) continue;
+      MergeDomUpdate(pending, msg == IPCProxyMsg::CALLUPDATESTYLE,
+                     reader.arg(0), reader.arg(1), reader.argLength(1));
+      continue;
+    }
+    ApplyDomUpdates(page_id, pending);
+    switch (msg) {
+      case IPCProxyMsg::CALLCREATEBODY:
+        core_side->CreateBody(page_id, reader.arg(0), reader.argLength(0));
+        break;
+      case IPCProxyMsg::CALLADDELEMENT: {
+        int index = atoi(reader.arg(2) == nullptr ? "\0" : reader.arg(2));
+        if (index >= -1) {
+          core_side->AddElement(page_id, reader.arg(0), reader.arg(1),
+                                reader.argLength(1), reader.arg(2));
+        }
+      } break;
+      case IPCProxyMsg::CALLREMOVEELEMENT:
+        core_side->RemoveElement(page_id, reader.arg(0));
+        break;
+      case IPCProxyMsg::CALLMOVEELEMENT: {
+        int index = atoi(reader.arg(2) == nullptr ? "\0" : reader.arg(2));
+        if (index >= -1) {
+          core_side->MoveElement(page_id, reader.arg(0), reader.arg(1), index);
+        }
+      } break;
+      case IPCProxyMsg::CALLADDEVENT:
+        core_side->AddEvent(page_id, reader.arg(0), reader.arg(1));
+        break;
+      case IPCProxyMsg::CALLREMOVEEVENT:
+        core_side->RemoveEvent(page_id, reader.arg(0), reader.arg(1));
+        break;
+      case IPCProxyMsg::CALLCREATEFINISH:
+        core_side->CreateFinish(page_id);
+        break;
+      default:
+        LOGE("ApplyDomBatch: unexpected msg %d", reader.msg());
+        break;
+    }
+  }
+  ApplyDomUpdates(page_id, pending);
+}
+
+static std::unique_ptr<IPCResult> FunctionCallDomBatch(
+    const IPCMessageView<CallDomBatch> &message) {
+  if (message.get<0>() == nullptr || message.get<1>() == nullptr)
+    return createInt32Result(0);
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
-      weex::base::MakeCopyable([page_id = std::move(arg1)] {
-        if (page_id.get() == nullptr) return;
+      weex::base::MakeCopyable([args = IPCMessageCopy<CallDomBatch>(message)] {
+        ApplyDomBatch(args.get<0>(), args.get<1>(), args.length<1>());
+      }));
+  return createInt32Result(0);
+}
 
+static std::unique_ptr<IPCResult> FunctionCallCreateFinish(
+    const IPCMessageView<CallCreateFinish> &message) {
+  if (message.get<0>() == nullptr) return createInt32Result(0);
+  WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
+      weex::base::MakeCopyable([args = IPCMessageCopy<CallCreateFinish>(message)] {
         WeexCoreManager::Instance()->script_bridge()->core_side()->CreateFinish(
-            page_id.get());
+            args.get<0>());
       }));
   //  char *pageId = getArumentAsCStr(arguments, 0);
   //
@@ -750,20 +783,14 @@ static std::unique_ptr<IPCResult> FunctionCallCreateFinish(
 }
 
 static std::unique_ptr<IPCResult> FunctionCallUpdateFinish(
-    IPCArguments *arguments) {
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
-  auto arg2 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1));
-  auto arg3 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 2));
+    const IPCMessageView<CallUpdateFinish> &message) {
   weex::base::WaitableEvent event;
   int result = -1;
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
-      weex::base::MakeCopyable([pageId = std::move(arg1),
-                                   task = std::move(arg2),
-                                   callback = std::move(arg3), ret = &result,
-                                   event = &event] {
+      weex::base::MakeCopyable([&message, ret = &result, event = &event] {
         WeexCoreManager::Instance()->script_bridge()->core_side()->UpdateFinish(
-            pageId.get(), task.get(), strlen(task.get()), callback.get(),
-            strlen(callback.get()));
+            message.get<0>(), message.get<1>(), message.length<1>(),
+            message.get<2>(), message.length<2>());
         event->Signal();
       }));
   event.Wait();
@@ -800,18 +827,13 @@ static std::unique_ptr<IPCResult> FunctionCallUpdateFinish(
 }
 
 static std::unique_ptr<IPCResult> FunctionCallRefreshFinish(
-    IPCArguments *arguments) {
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
-  auto arg2 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1));
-  auto arg3 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 2));
+    const IPCMessageView<CallRefreshFinish> &message) {
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
-      weex::base::MakeCopyable([pageId = std::move(arg1),
-                                   task = std::move(arg2),
-                                   callback = std::move(arg3)] {
+      weex::base::MakeCopyable([args = IPCMessageCopy<CallRefreshFinish>(message)] {
         WeexCoreManager::Instance()
             ->script_bridge()
             ->core_side()
-            ->RefreshFinish(pageId.get(), task.get(), callback.get());
+            ->RefreshFinish(args.get<0>(), args.get<1>(), args.get<2>());
       }));
 
   //  char *pageId = getArumentAsCStr(arguments, 0);
@@ -842,63 +864,43 @@ static std::unique_ptr<IPCResult> FunctionCallRefreshFinish(
   return createInt32Result(1);
 }
 
-static std::unique_ptr<IPCResult> HandlePostMessage(IPCArguments *arguments) {
-  //  char *jData = getArumentAsCStr(arguments, 0);
-  //  char *jVmId = getArumentAsCStr(arguments, 1);
-  //  WeexCoreManager::Instance()->script_bridge()->core_side()->PostMessage(jVmId,
-  //                                                                         jData);
-  int i = getArumentAsCStrLen(arguments, 0);
+static std::unique_ptr<IPCResult> HandlePostMessage(
+    const IPCMessageView<PostMessage> &message) {
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
-      weex::base::MakeCopyable([jData = std::unique_ptr<char[]>(
-          getArumentAsCStr(arguments, 0)),
-                                   length = i,
-                                   jVmId = std::unique_ptr<char[]>(
-                                       getArumentAsCStr(arguments, 1))] {
+      weex::base::MakeCopyable([args = IPCMessageCopy<PostMessage>(message)] {
         WeexCoreManager::Instance()->script_bridge()->core_side()->PostMessage(
-            jVmId.get(), jData.get(), length);
+            args.get<1>(), args.get<0>(), args.length<0>());
       }));
   return createInt32Result(static_cast<int32_t>(true));
 }
 
-std::unique_ptr<IPCResult> HandleDispatchMessage(IPCArguments *arguments) {
-  //  char *jClientId = getArumentAsCStr(arguments, 0);
-  //  char *jData = getArumentAsCStr(arguments, 1);
-  //  char *jCallback = getArumentAsCStr(arguments, 2);
-  //  char *jVmId = getArumentAsCStr(arguments, 3);
-  //  WeexCoreManager::Instance()->script_bridge()->core_side()->DispatchMessage(
-  //      jClientId, jVmId, jData, jCallback);
-  int i = getArumentAsCStrLen(arguments, 1);
+std::unique_ptr<IPCResult> HandleDispatchMessage(
+    const IPCMessageView<DispatchMessage> &message) {
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
       weex::base::MakeCopyable(
-          [clientId = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0)),
-              dataS = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1)),
-              length = i,
-              callbackS = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 2)),
-              vmId = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 3))] {
+          [args = IPCMessageCopy<DispatchMessage>(message)] {
             WeexCoreManager::Instance()
                 ->script_bridge()
                 ->core_side()
-                ->DispatchMessage(clientId.get(), dataS.get(), length,
-                                  callbackS.get(), vmId.get());
+                ->DispatchMessage(args.get<0>(), args.get<1>(),
+                                  args.length<1>(), args.get<2>(),
+                                  args.get<3>());
           }));
   return createInt32Result(static_cast<int32_t>(true));
 }
 
-std::unique_ptr<IPCResult> HandleDispatchMessageSync(IPCArguments *arguments) {
-  int i = getArumentAsCStrLen(arguments, 1);
+std::unique_ptr<IPCResult> HandleDispatchMessageSync(
+    const IPCMessageView<DispatchMessageSync> &message) {
   weex::base::WaitableEvent event;
   std::unique_ptr<WeexJSResult> result;
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
       weex::base::MakeCopyable(
-          [clientId = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0)),
-              dataS = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1)),
-              vmId = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 2)),
-              length = i, e = &event, r = &result]() {
+          [&message, e = &event, r = &result]() {
             *r = WeexCoreManager::Instance()
                 ->script_bridge()
                 ->core_side()
-                ->DispatchMessageSync(clientId.get(), dataS.get(), length,
-                                      vmId.get());
+                ->DispatchMessageSync(message.get<0>(), message.get<1>(),
+                                      message.length<1>(), message.get<2>());
             e->Signal();
           }));
   event.Wait();
@@ -909,18 +911,17 @@ std::unique_ptr<IPCResult> HandleDispatchMessageSync(IPCArguments *arguments) {
   }
 }
 
-std::unique_ptr<IPCResult> OnReceivedResult(IPCArguments *arguments) {
-  auto callbackId = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
-  long callback_id = atol(std::move(callbackId).get());
+std::unique_ptr<IPCResult> HandleReceivedResult(
+    const IPCMessageView<OnReceivedResult> &message) {
+  long callback_id =
+      atol(message.get<0>() == nullptr ? "\0" : message.get<0>());
   std::unique_ptr<WeexJSResult> result;
   result.reset(new WeexJSResult);
-  if (arguments->getCount() > 1 && arguments->getType(1) == IPCType::BYTEARRAY &&
-      arguments->getByteArray(1)->length > 0) {
-    result->length = arguments->getByteArray(1)->length;
+  if (message.get<1>() != nullptr && message.length<1>() > 0) {
+    result->length = message.length<1>();
     char *string = new char[result->length + 1];
     result->data.reset(string);
-    memset(string, 0, result->length);
-    memcpy(string, arguments->getByteArray(1)->content, result->length);
+    memcpy(string, message.get<1>(), result->length);
     string[result->length] = '\0';
   }
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
@@ -935,32 +936,31 @@ std::unique_ptr<IPCResult> OnReceivedResult(IPCArguments *arguments) {
   return createInt32Result(static_cast<int32_t>(true));
 }
 
-std::unique_ptr<IPCResult> UpdateComponentData(IPCArguments *arguments) {
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
-  auto arg2 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1));
-  auto arg3 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 2));
+std::unique_ptr<IPCResult> HandleUpdateComponentData(
+    const IPCMessageView<UpdateComponentData> &message) {
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
       weex::base::MakeCopyable(
-          [page_id = std::move(arg1), cid = std::move(arg2), json_data = std::move(arg3)]() {
+          [args = IPCMessageCopy<UpdateComponentData>(message)]() {
             WeexCoreManager::Instance()
                 ->script_bridge()
                 ->core_side()
-                ->UpdateComponentData(page_id.get(), cid.get(), json_data.get());
+                ->UpdateComponentData(args.get<0>(), args.get<1>(),
+                                      args.get<2>());
           }));
   return createInt32Result(static_cast<int32_t>(true));
 }
 
-std::unique_ptr<IPCResult> HeartBeat(IPCArguments *arguments) {
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
+std::unique_ptr<IPCResult> HandleHeartBeat(
+    const IPCMessageView<HeartBeat> &message) {
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
       weex::base::MakeCopyable(
-          [pageId = std::move(arg1)]() {
-            if (pageId != nullptr) {
-              LOGE("HeartBeat %s", pageId.get());
+          [args = IPCMessageCopy<HeartBeat>(message)]() {
+            if (args.get<0>() != nullptr) {
+              LOGE("HeartBeat %s", args.get<0>());
               WeexCoreManager::Instance()
                   ->script_bridge()
                   ->core_side()
-                  ->CallNative(pageId.get(), "HeartBeat", "HeartBeat");
+                  ->CallNative(args.get<0>(), "HeartBeat", "HeartBeat");
             }
           }));
   return createInt32Result(static_cast<int32_t>(true));
@@ -1014,27 +1014,20 @@ std::unique_ptr<IPCResult> HandleJSActionCallBack(IPCArguments *arguments) {
   return createVoidResult();
 }
 
-std::unique_ptr<IPCResult> HandleLogDetail(IPCArguments *arguments) {
-  auto arg1 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 0));
-  auto arg2 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 1));
-  auto arg3 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 2));
-  auto arg4 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 3));
-  auto arg5 = std::unique_ptr<char[]>(getArumentAsCStr(arguments, 4));
-
+std::unique_ptr<IPCResult> HandleLogDetail(
+    const IPCMessageView<PostLogDetail> &message) {
   WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
       weex::base::MakeCopyable(
-          [level_str = std::move(arg1), tag_ptr = std::move(arg2),
-              file_ptr = std::move(arg3), line_ptr = std::move(arg4), log_ptr = std::move(arg5)]() {
-            int level = (level_str == nullptr || level_str.get() == nullptr)
-                        ? ((int) (WeexCore::LogLevel::Debug)) : atoi(level_str.get());
-            long line =
-                (line_ptr == nullptr || line_ptr.get() == nullptr) ? 0 : atol(line_ptr.get());
+          [args = IPCMessageCopy<PostLogDetail>(message)]() {
+            int level = args.get<0>() == nullptr
+                        ? ((int) (WeexCore::LogLevel::Debug)) : atoi(args.get<0>());
+            long line = args.get<3>() == nullptr ? 0 : atol(args.get<3>());
 
             weex::base::LogImplement::getLog()->log((WeexCore::LogLevel) level,
-                                                    tag_ptr.get(),
-                                                    file_ptr.get(),
+                                                    args.get<1>(),
+                                                    args.get<2>(),
                                                     line,
-                                                    log_ptr.get());
+                                                    args.get<4>());
           }));
   return createInt32Result(static_cast<int32_t>(true));
 }
@@ -1070,68 +1063,38 @@ ScriptBridgeInMultiProcess::~ScriptBridgeInMultiProcess() {
 }
 
 void ScriptBridgeInMultiProcess::RegisterIPCCallback(IPCHandler *handler) {
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::SETJSFVERSION),
-                           HandleSetJSVersion);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::REPORTEXCEPTION),
-                           HandleReportException);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::CALLNATIVE),
-                           HandleCallNative);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::CALLNATIVEMODULE),
-                           HandleCallNativeModule);
-  handler->registerHandler(
-      static_cast<uint32_t>(IPCProxyMsg::CALLNATIVECOMPONENT),
-      HandleCallNativeComponent);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::CALLADDELEMENT),
-                           HandleCallAddElement);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::SETTIMEOUT),
-                           HandleSetTimeout);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::NATIVELOG),
-                           HandleCallNativeLog);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::CALLCREATEBODY),
-                           FunctionCallCreateBody);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::CALLUPDATEFINISH),
-                           FunctionCallUpdateFinish);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::CALLCREATEFINISH),
-                           FunctionCallCreateFinish);
-  handler->registerHandler(
-      static_cast<uint32_t>(IPCProxyMsg::CALLREFRESHFINISH),
-      FunctionCallRefreshFinish);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::CALLUPDATEATTRS),
-                           FunctionCallUpdateAttrs);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::CALLUPDATESTYLE),
-                           FunctionCallUpdateStyle);
-  handler->registerHandler(
-      static_cast<uint32_t>(IPCProxyMsg::CALLREMOVEELEMENT),
-      FunctionCallRemoveElement);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::CALLMOVEELEMENT),
-                           FunctionCallMoveElement);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::CALLADDEVENT),
-                           FunctionCallAddEvent);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::CALLREMOVEEVENT),
-                           FunctionCallRemoveEvent);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::CALLGCANVASLINK),
-                           HandleCallGCanvasLinkNative);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::CALLT3DLINK),
-                           HandleT3DLinkNative);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::SETINTERVAL),
-                           HandleSetInterval);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::CLEARINTERVAL),
-                           HandleClearInterval);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::POSTMESSAGE),
-                           HandlePostMessage);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::DISPATCHMESSAGE),
-                           HandleDispatchMessage);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::DISPATCHMESSAGESYNC),
-                           HandleDispatchMessageSync);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::ONRECEIVEDRESULT),
-                           OnReceivedResult);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::UPDATECOMPONENTDATA),
-                           UpdateComponentData);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::HEARTBEAT),
-                           HeartBeat);
-  handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::POSTLOGDETAIL),
-                           HandleLogDetail);
-
+  registerIPCHandler(handler, HandleSetJSVersion);
+  registerIPCHandler(handler, HandleReportException);
+  registerIPCHandler(handler, HandleCallNative);
+  registerIPCHandler(handler, HandleCallNativeModule);
+  registerIPCHandler(handler, HandleCallNativeComponent);
+  registerIPCHandler(handler, HandleCallAddElement);
+  registerIPCHandler(handler, HandleSetTimeout);
+  registerIPCHandler(handler, HandleCallNativeLog);
+  registerIPCHandler(handler, FunctionCallCreateBody);
+  registerIPCHandler(handler, FunctionCallUpdateFinish);
+  registerIPCHandler(handler, FunctionCallCreateFinish);
+  registerIPCHandler(handler, FunctionCallRefreshFinish);
+  registerIPCHandler(handler, FunctionCallUpdateAttrs);
+  registerIPCHandler(handler, FunctionCallUpdateStyle);
+  registerIPCHandler(handler, FunctionCallRemoveElement);
+  registerIPCHandler(handler, FunctionCallMoveElement);
+  registerIPCHandler(handler, FunctionCallAddEvent);
+  registerIPCHandler(handler, FunctionCallRemoveEvent);
+  registerIPCHandler(handler, FunctionCallDomBatch);
+  registerIPCHandler(handler, HandleCallGCanvasLinkNative);
+  registerIPCHandler(handler, HandleT3DLinkNative);
+  registerIPCHandler(handler, HandleSetInterval);
+  registerIPCHandler(handler, HandleClearInterval);
+  registerIPCHandler(handler, HandlePostMessage);
+  registerIPCHandler(handler, HandleDispatchMessage);
+  registerIPCHandler(handler, HandleDispatchMessageSync);
+  registerIPCHandler(handler, HandleReceivedResult);
+  registerIPCHandler(handler, HandleUpdateComponentData);
+  registerIPCHandler(handler, HandleHeartBeat);
+  registerIPCHandler(handler, HandleLogDetail);
+
+  // Variable arity, dispatched on its second argument.
   handler->registerHandler(static_cast<uint32_t>(IPCProxyMsg::JSACTIONCALLBACK),
                            HandleJSActionCallBack);
 }
@@ -116,9 +116,9 @@ int PlatformSideInMultiSo::RemoveEvent(const char *page_id, const char *ref,
 
 int PlatformSideInMultiSo::CreateBody(
     const char *page_id, const char *component_type, const char *ref,
-    std::map<std::string, std::string> *styles,
-    std::map<std::string, std::string> *attributes,
-    std::set<std::string> *events, const WXCoreMargin &margins,
+    SmallStringMap *styles,
+    SmallStringMap *attributes,
+    SmallStringSet *events, const WXCoreMargin &margins,
     const WXCorePadding &paddings, const WXCoreBorderWidth &borders) {
   return platform_expose_functions_->create_body(page_id, component_type, ref,
                                                  styles, attributes, events,
@@ -128,9 +128,9 @@ int PlatformSideInMultiSo::CreateBody(
 int PlatformSideInMultiSo::AddElement(
     const char *page_id, const char *component_type, const char *ref,
     int &index, const char *parentRef,
-    std::map<std::string, std::string> *styles,
-    std::map<std::string, std::string> *attributes,
-    std::set<std::string> *events, const WXCoreMargin &margins,
+    SmallStringMap *styles,
+    SmallStringMap *attributes,
+    SmallStringSet *events, const WXCoreMargin &margins,
     const WXCorePadding &paddings, const WXCoreBorderWidth &borders,
     bool willLayout) {
   return platform_expose_functions_->add_element(
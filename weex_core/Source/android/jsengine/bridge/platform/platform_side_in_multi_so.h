@@ -73,17 +73,17 @@ class PlatformSideInMultiSo : public WeexCore::PlatformBridge::PlatformSide {
   int RemoveEvent(const char* page_id, const char* ref,
                   const char* event) override;
   int CreateBody(const char* pageId, const char* componentType, const char* ref,
-                 std::map<std::string, std::string>* styles,
-                 std::map<std::string, std::string>* attributes,
-                 std::set<std::string>* events, const WXCoreMargin& margins,
+                 SmallStringMap* styles,
+                 SmallStringMap* attributes,
+                 SmallStringSet* events, const WXCoreMargin& margins,
                  const WXCorePadding& paddings,
                  const WXCoreBorderWidth& borders) override;
 
   int AddElement(const char* pageId, const char* componentType, const char* ref,
                  int& index, const char* parentRef,
-                 std::map<std::string, std::string>* styles,
-                 std::map<std::string, std::string>* attributes,
-                 std::set<std::string>* events, const WXCoreMargin& margins,
+                 SmallStringMap* styles,
+                 SmallStringMap* attributes,
+                 SmallStringSet* events, const WXCoreMargin& margins,
                  const WXCorePadding& paddings,
                  const WXCoreBorderWidth& borders, bool willLayout) override;
   int Layout(const char* page_id, const char* ref, float top,
@@ -287,9 +287,9 @@ int PlatformSideInMultiProcess::RemoveEvent(const char *page_id,
 
 int PlatformSideInMultiProcess::CreateBody(
     const char *page_id, const char *component_type, const char *ref,
-    std::map<std::string, std::string> *styles,
-    std::map<std::string, std::string> *attributes,
-    std::set<std::string> *events, const WXCoreMargin &margins,
+    SmallStringMap *styles,
+    SmallStringMap *attributes,
+    SmallStringSet *events, const WXCoreMargin &margins,
     const WXCorePadding &paddings, const WXCoreBorderWidth &borders) {
   WeexIPCClient *pClient = client_;
   
@@ -372,9 +372,9 @@ int PlatformSideInMultiProcess::CreateBody(
 int PlatformSideInMultiProcess::AddElement(
     const char *page_id, const char *component_type, const char *ref,
     int &index, const char *parentRef,
-    std::map<std::string, std::string> *styles,
-    std::map<std::string, std::string> *attributes,
-    std::set<std::string> *events, const WXCoreMargin &margins,
+    SmallStringMap *styles,
+    SmallStringMap *attributes,
+    SmallStringSet *events, const WXCoreMargin &margins,
     const WXCorePadding &paddings, const WXCoreBorderWidth &borders,
     bool willLayout) {
 
@@ -26,6 +26,7 @@
 #include "android/jsengine/weex_ipc_server.h"
 #include "android/jsengine/weex_jsc_utils.h"
 #include "android/jsengine/object/weex_env.h"
+#include "base/time_utils.h"
 #include "base/utils/log_utils.h"
 #include "third_party/IPC/Buffering/IPCBuffer.h"
 #include "third_party/IPC/IPCException.h"
@@ -34,10 +35,35 @@
 #include "third_party/IPC/IPCType.h"
 #include "third_party/IPC/Serializing/IPCSerializer.h"
 #include "third_party/IPC/IPCMessageJS.h"
+#include "third_party/IPC/IPCSchema.h"
 
 namespace weex {
 namespace bridge {
 namespace js {
+// A batch is sent as soon as one of these limits is reached, otherwise it
+// waits for the end of the current js task or a finish action.
+static const size_t kDomBatchMaxActions = 256;
+static const size_t kDomBatchMaxBytes = 64 * 1024;
+static const long long kDomBatchMaxDelayMs = 16;
+
+namespace {
+// Feeds the arguments encoded by an IPCSchema into an IPCTask.
+struct IPCTaskSink {
+  explicit IPCTaskSink(BackToWeexCoreQueue::IPCTask *task) : task(task) {}
+  void add(const char *data, size_t length) { task->addParams(data, length); }
+  BackToWeexCoreQueue::IPCTask *task;
+};
+
+template <typename Schema, typename... Params>
+BackToWeexCoreQueue::IPCTask *NewIPCTask(Params &&... params) {
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      new BackToWeexCoreQueue::IPCTask(Schema::kMsg);
+  IPCTaskSink sink(ipc_task);
+  Schema::encode(sink, std::forward<Params>(params)...);
+  return ipc_task;
+}
+}  // namespace
+
 CoreSideInMultiProcess::CoreSideInMultiProcess(WeexIPCClient *client)
     : client_(client) {}
 
@@ -47,11 +73,9 @@ CoreSideInMultiProcess::~CoreSideInMultiProcess() {}
 
 void CoreSideInMultiProcess::CallNative(const char *page_id, const char *task,
                                         const char *callback) {
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::CALLNATIVE);
-  ipc_task->addParams(page_id);
-  ipc_task->addParams(task);
-  ipc_task->addParams(callback);
+  FlushDomActions();
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::CallNative>(page_id, task, callback);
   WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
 }
 
@@ -59,13 +83,12 @@ std::unique_ptr<ValueWithType> CoreSideInMultiProcess::CallNativeModule(
     const char *page_id, const char *module, const char *method,
     const char *arguments, int arguments_length, const char *options,
     int options_length) {
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::CALLNATIVEMODULE);
-  ipc_task->addParams(page_id);
-  ipc_task->addParams(module);
-  ipc_task->addParams(method);
-  ipc_task->addParams(arguments, arguments_length);
-  ipc_task->addParams(options, options_length);
+  FlushDomActions();
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::CallNativeModule>(
+          page_id, module, method,
+          IPCBytesParam(arguments, arguments_length),
+          IPCBytesParam(options, options_length));
   auto future = std::unique_ptr<BackToWeexCoreQueue::Future>(
       new BackToWeexCoreQueue::Future());
   ipc_task->set_future(future.get());
@@ -102,14 +125,13 @@ void CoreSideInMultiProcess::CallNativeComponent(
     const char *page_id, const char *ref, const char *method,
     const char *arguments, int arguments_length, const char *options,
     int options_length) {
+  FlushDomActions();
 
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::CALLNATIVECOMPONENT);
-  ipc_task->addParams(page_id);
-  ipc_task->addParams(ref);
-  ipc_task->addParams(method);
-  ipc_task->addParams(arguments, arguments_length);
-  ipc_task->addParams(options, options_length);
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::CallNativeComponent>(
+          page_id, ref, method,
+          IPCBytesParam(arguments, arguments_length),
+          IPCBytesParam(options, options_length));
   WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
 //                if (result->getType() != IPCType::INT32) {
 //                    LOGE("functionCallNativeComponent: unexpected result: %d",
@@ -121,54 +143,44 @@ void CoreSideInMultiProcess::AddElement(const char *page_id,
                                         const char *parent_ref,
                                         const char *dom_str, int dom_str_length,
                                         const char *index_str) {
-
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::CALLADDELEMENT);
-  ipc_task->addParams(page_id);
-  ipc_task->addParams(parent_ref);
-  ipc_task->addParams(dom_str, dom_str_length);
-  ipc_task->addParams(index_str);
-  WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
+  AppendDomAction(page_id, IPCProxyMsg::CALLADDELEMENT,
+                  {{parent_ref, 0}, {dom_str, static_cast<size_t>(dom_str_length)},
+                   {index_str, 0}});
 }
 
 void CoreSideInMultiProcess::SetTimeout(const char *callback_id,
                                         const char *time) {
+  FlushDomActions();
 
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::SETTIMEOUT);
-  ipc_task->addParams(callback_id);
-  ipc_task->addParams(time);
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::SetTimeout>(callback_id, time);
   WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
 }
 
 void CoreSideInMultiProcess::NativeLog(const char *str_array) {
+  FlushDomActions();
 
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::NATIVELOG);
-  ipc_task->addParams(str_array);
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::NativeLog>(str_array);
   WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
 }
 
 void CoreSideInMultiProcess::CreateBody(const char *page_id,
                                         const char *dom_str,
                                         int dom_str_length) {
-
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::CALLCREATEBODY);
-  ipc_task->addParams(page_id);
-  ipc_task->addParams(dom_str, dom_str_length);
-  WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
+  AppendDomAction(page_id, IPCProxyMsg::CALLCREATEBODY,
+                  {{dom_str, static_cast<size_t>(dom_str_length)}});
 }
 
 int CoreSideInMultiProcess::UpdateFinish(const char *page_id, const char *task,
                                          int task_length, const char *callback,
                                          int callback_length) {
+  FlushDomActions();
 
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::CALLUPDATEFINISH);
-  ipc_task->addParams(page_id);
-  ipc_task->addParams(task, task_length);
-  ipc_task->addParams(callback, callback_length);
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::CallUpdateFinish>(
+          page_id, IPCBytesParam(task, task_length),
+          IPCBytesParam(callback, callback_length));
   auto future = std::unique_ptr<BackToWeexCoreQueue::Future>(
       new BackToWeexCoreQueue::Future());
   ipc_task->set_future(future.get());
@@ -184,21 +196,15 @@ int CoreSideInMultiProcess::UpdateFinish(const char *page_id, const char *task,
 }
 
 void CoreSideInMultiProcess::CreateFinish(const char *page_id) {
-
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::CALLCREATEFINISH);
-  ipc_task->addParams(page_id);
-  WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
+  AppendDomAction(page_id, IPCProxyMsg::CALLCREATEFINISH, {}, true);
 }
 
 int CoreSideInMultiProcess::RefreshFinish(const char *page_id, const char *task,
                                           const char *callback) {
+  FlushDomActions();
 
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::CALLREFRESHFINISH);
-  ipc_task->addParams(page_id);
-  ipc_task->addParams(task);
-  ipc_task->addParams(callback);
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::CallRefreshFinish>(page_id, task, callback);
   auto future = std::unique_ptr<BackToWeexCoreQueue::Future>(
       new BackToWeexCoreQueue::Future());
   ipc_task->set_future(future.get());
@@ -215,80 +221,48 @@ int CoreSideInMultiProcess::RefreshFinish(const char *page_id, const char *task,
 
 void CoreSideInMultiProcess::UpdateAttrs(const char *page_id, const char *ref,
                                          const char *data, int data_length) {
-
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::CALLUPDATEATTRS);
-  ipc_task->addParams(page_id);
-  ipc_task->addParams(ref);
-  ipc_task->addParams(data, data_length);
-  WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
+  AppendDomAction(page_id, IPCProxyMsg::CALLUPDATEATTRS,
+                  {{ref, 0}, {data, static_cast<size_t>(data_length)}});
 }
 
 void CoreSideInMultiProcess::UpdateStyle(const char *page_id, const char *ref,
                                          const char *data, int data_length) {
-
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::CALLUPDATESTYLE);
-  ipc_task->addParams(page_id);
-  ipc_task->addParams(ref);
-  ipc_task->addParams(data, data_length);
-  WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
+  AppendDomAction(page_id, IPCProxyMsg::CALLUPDATESTYLE,
+                  {{ref, 0}, {data, static_cast<size_t>(data_length)}});
 }
 
 void CoreSideInMultiProcess::RemoveElement(const char *page_id,
                                            const char *ref) {
-
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::CALLREMOVEELEMENT);
-  ipc_task->addParams(page_id);
-  ipc_task->addParams(ref);
-  WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
+  AppendDomAction(page_id, IPCProxyMsg::CALLREMOVEELEMENT, {{ref, 0}});
 }
 
 void CoreSideInMultiProcess::MoveElement(const char *page_id, const char *ref,
                                          const char *parent_ref, int index) {
-
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::CALLMOVEELEMENT);
-  ipc_task->addParams(page_id);
-  ipc_task->addParams(ref);
-  ipc_task->addParams(parent_ref);
   auto temp = std::to_string(index);
-  ipc_task->addParams(temp.c_str(), temp.length());
-  WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
+  AppendDomAction(page_id, IPCProxyMsg::CALLMOVEELEMENT,
+                  {{ref, 0}, {parent_ref, 0}, {temp.c_str(), temp.length()}});
 }
 
 void CoreSideInMultiProcess::AddEvent(const char *page_id, const char *ref,
                                       const char *event) {
-
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::CALLADDEVENT);
-  ipc_task->addParams(page_id);
-  ipc_task->addParams(ref);
-  ipc_task->addParams(event);
-  WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
+  AppendDomAction(page_id, IPCProxyMsg::CALLADDEVENT,
+                  {{ref, 0}, {event, 0}});
 }
 
 void CoreSideInMultiProcess::RemoveEvent(const char *page_id, const char *ref,
                                          const char *event) {
-
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::CALLREMOVEEVENT);
-  ipc_task->addParams(page_id);
-  ipc_task->addParams(ref);
-  ipc_task->addParams(event);
-  WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
+  AppendDomAction(page_id, IPCProxyMsg::CALLREMOVEEVENT,
+                  {{ref, 0}, {event, 0}});
 }
 
 const char *CoreSideInMultiProcess::CallGCanvasLinkNative(
     const char *context_id, int type, const char *arg) {
+  FlushDomActions();
 
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::CALLGCANVASLINK);
-  ipc_task->addParams(context_id);
   auto temp = std::to_string(type);
-  ipc_task->addParams(temp.c_str(), temp.length());
-  ipc_task->addParams(arg);
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::CallGCanvasLink>(context_id, temp.c_str(),
+                                                   arg);
   auto future = std::unique_ptr<BackToWeexCoreQueue::Future>(
       new BackToWeexCoreQueue::Future());
   ipc_task->set_future(future.get());
@@ -330,12 +304,10 @@ const char *CoreSideInMultiProcess::CallGCanvasLinkNative(
 int CoreSideInMultiProcess::SetInterval(const char *page_id,
                                         const char *callback_id,
                                         const char *time) {
+  FlushDomActions();
 
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::SETINTERVAL);
-  ipc_task->addParams(page_id);
-  ipc_task->addParams(callback_id);
-  ipc_task->addParams(time);
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::SetInterval>(page_id, callback_id, time);
   auto future = std::unique_ptr<BackToWeexCoreQueue::Future>(
       new BackToWeexCoreQueue::Future());
   ipc_task->set_future(future.get());
@@ -351,22 +323,20 @@ int CoreSideInMultiProcess::SetInterval(const char *page_id,
 
 void CoreSideInMultiProcess::ClearInterval(const char *page_id,
                                            const char *callback_id) {
+  FlushDomActions();
 
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::CLEARINTERVAL);
-  ipc_task->addParams(page_id);
-  ipc_task->addParams(callback_id);
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::ClearInterval>(page_id, callback_id);
   WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
 }
 
 const char *CoreSideInMultiProcess::CallT3DLinkNative(int type,
                                                       const char *arg) {
+  FlushDomActions();
 
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::CALLT3DLINK);
   auto temp = std::to_string(type);
-  ipc_task->addParams(temp.c_str(), temp.length());
-  ipc_task->addParams(arg);
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::CallT3DLink>(temp.c_str(), arg);
   auto future = std::unique_ptr<BackToWeexCoreQueue::Future>(
       new BackToWeexCoreQueue::Future());
   ipc_task->set_future(future.get());
@@ -401,11 +371,11 @@ const char *CoreSideInMultiProcess::CallT3DLinkNative(int type,
 
 void CoreSideInMultiProcess::PostMessage(const char *vim_id, const char *data,
                                          int dataLength) {
+  FlushDomActions();
 
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::POSTMESSAGE);
-  ipc_task->addParams(data, dataLength);
-  ipc_task->addParams(vim_id);
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::PostMessage>(IPCBytesParam(data, dataLength),
+                                              vim_id);
   WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
 }
 
@@ -414,13 +384,11 @@ void CoreSideInMultiProcess::DispatchMessage(const char *client_id,
                                              int dataLength,
                                              const char *callback,
                                              const char *vm_id) {
+  FlushDomActions();
 
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::DISPATCHMESSAGE);
-  ipc_task->addParams(client_id);
-  ipc_task->addParams(data, dataLength);
-  ipc_task->addParams(callback);
-  ipc_task->addParams(vm_id);
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::DispatchMessage>(
+          client_id, IPCBytesParam(data, dataLength), callback, vm_id);
   WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
 }
 
@@ -429,12 +397,11 @@ CoreSideInMultiProcess::DispatchMessageSync(const char *client_id,
                                             const char *data,
                                             int dataLength,
                                             const char *vm_id) {
+  FlushDomActions();
 
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::DISPATCHMESSAGESYNC);
-  ipc_task->addParams(client_id);
-  ipc_task->addParams(data, dataLength);
-  ipc_task->addParams(vm_id);
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::DispatchMessageSync>(
+          client_id, IPCBytesParam(data, dataLength), vm_id);
   auto future = std::unique_ptr<BackToWeexCoreQueue::Future>(
       new BackToWeexCoreQueue::Future());
   ipc_task->set_future(future.get());
@@ -455,44 +422,40 @@ CoreSideInMultiProcess::DispatchMessageSync(const char *client_id,
 void CoreSideInMultiProcess::ReportException(const char *page_id,
                                              const char *func,
                                              const char *exception_string) {
+  FlushDomActions();
 
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::REPORTEXCEPTION);
-  ipc_task->addParams(page_id);
-  ipc_task->addParams(func);
-  ipc_task->addParams(exception_string);
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::ReportException>(page_id, func,
+                                                  exception_string);
   WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
 }
 
 void CoreSideInMultiProcess::SetJSVersion(const char *js_version) {
+  FlushDomActions();
 
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::SETJSFVERSION);
-  ipc_task->addParams(js_version);
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::SetJSFVersion>(js_version);
   WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
 }
 
 void CoreSideInMultiProcess::OnReceivedResult(long callback_id,
                                               std::unique_ptr<WeexJSResult> &result) {
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::ONRECEIVEDRESULT);
-
+  FlushDomActions();
   auto temp = std::to_string(callback_id);
-  ipc_task->addParams(temp.c_str(), temp.length());
-  if (result != nullptr) {
-    ipc_task->addParams(result->data.get(), result->length);
-  }
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::OnReceivedResult>(
+          temp.c_str(),
+          result != nullptr ? IPCBytesParam(result->data.get(), result->length)
+                            : IPCBytesParam(nullptr, 0));
   WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
 }
 
 void CoreSideInMultiProcess::UpdateComponentData(const char *page_id, const char *cid,
                                                  const char *json_data) {
+  FlushDomActions();
 
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::UPDATECOMPONENTDATA);
-  ipc_task->addParams(page_id);
-  ipc_task->addParams(cid);
-  ipc_task->addParams(json_data);
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::UpdateComponentData>(page_id, cid, json_data);
   WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
 }
 
@@ -506,19 +469,58 @@ bool CoreSideInMultiProcess::Log(int level, const char *tag,
     return false;
   }
 
-  BackToWeexCoreQueue::IPCTask *ipc_task = new BackToWeexCoreQueue::IPCTask(
-      IPCProxyMsg::POSTLOGDETAIL);
   auto level_str = std::to_string(level);
-  ipc_task->addParams(level_str.c_str(), level_str.length());
-  ipc_task->addParams(tag);
-  ipc_task->addParams(file);
   auto line_str = std::to_string(line);
-  ipc_task->addParams(line_str.c_str(), line_str.length());
-  ipc_task->addParams(log);
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::PostLogDetail>(
+          level_str.c_str(), tag, file, line_str.c_str(), log);
   WeexEnv::getEnv()->m_back_to_weex_core_thread->addTask(ipc_task);
   return true;
 }
 
+void CoreSideInMultiProcess::AppendDomAction(
+    const char *page_id, IPCProxyMsg msg,
+    std::initializer_list<DomActionArg> args, bool flush) {
+  std::lock_guard<std::mutex> guard(dom_batch_mutex_);
+  std::string key(page_id == nullptr ? "" : page_id);
+  DomActionBatch &batch = dom_batches_[key];
+  long long now = getCurrentTime();
+  if (batch.writer.empty()) {
+    batch.start_time = now;
+  }
+  batch.writer.begin(static_cast<uint32_t>(msg),
+                     static_cast<uint32_t>(args.size()));
+  for (auto &arg : args) {
+    batch.writer.add(arg.data, arg.length);
+  }
+  if (flush || batch.writer.count() >= kDomBatchMaxActions ||
+      batch.writer.length() >= kDomBatchMaxBytes ||
+      now - batch.start_time >= kDomBatchMaxDelayMs) {
+    SendDomActionBatch(key, batch);
+  }
+}
+
+void CoreSideInMultiProcess::FlushDomActions() {
+  std::lock_guard<std::mutex> guard(dom_batch_mutex_);
+  for (auto &it : dom_batches_) {
+    SendDomActionBatch(it.first, it.second);
+  }
+  dom_batches_.clear();
+}
+
+void CoreSideInMultiProcess::SendDomActionBatch(const std::string &page_id,
+                                                DomActionBatch &batch) {
+  if (batch.writer.empty()) {
+    return;
+  }
+  BackToWeexCoreQueue::IPCTask *ipc_task =
+      NewIPCTask<IPCProxySchema::CallDomBatch>(
+          page_id.c_str(),
+          IPCBytesParam(batch.writer.data(), batch.writer.length()));
+  WeexEnv::getEnv()->m_back_to_weex_core_thread.get()->addTask(ipc_task);
+  batch.writer.clear();
+}
+
 }  // namespace js
 }  // namespace bridge
 }  // namespace weex
@@ -23,9 +23,15 @@
 #ifndef WEEXV8_MULTI_PROCESS_CORE_SIDE_H
 #define WEEXV8_MULTI_PROCESS_CORE_SIDE_H
 
+#include <initializer_list>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
 #include "android/jsengine/weex_ipc_client.h"
 #include "core/bridge/script_bridge.h"
+#include "third_party/IPC/IPCBatch.h"
+#include "third_party/IPC/IPCMessageJS.h"
 
 class WeexJSServer;
 namespace weex {
@@ -121,8 +127,31 @@ class CoreSideInMultiProcess : public WeexCore::ScriptBridge::CoreSide {
            unsigned long line,
            const char *log) override;
 
+  // Sends every pending dom action batch to WeexCore. Called at the end of
+  // each js task, and before any message which is not a dom action so that
+  // the order seen by WeexCore is kept.
+  void FlushDomActions();
+
  private:
+  struct DomActionArg {
+    const char *data;
+    size_t length;
+  };
+
+  struct DomActionBatch {
+    IPCBatchWriter writer;
+    long long start_time = 0;
+  };
+
+  void AppendDomAction(const char *page_id, IPCProxyMsg msg,
+                       std::initializer_list<DomActionArg> args,
+                       bool flush = false);
+  void SendDomActionBatch(const std::string &page_id,
+                          DomActionBatch &batch);
+
   WeexIPCClient *client_;
+  std::mutex dom_batch_mutex_;
+  std::map<std::string, DomActionBatch> dom_batches_;
   DISALLOW_COPY_AND_ASSIGN(CoreSideInMultiProcess);
 };
 }  // namespace js
@@ -26,6 +26,7 @@
 #include "core/bridge/script_bridge.h"
 #ifdef USE_JS_RUNTIME
 #include "js_runtime/weex/task/weex_task_queue.h"
+#include "js_runtime/weex/task/weex_task_queue_pool.h"
 #else
 #include "android/jsengine/task/weex_task_queue.h"
 #endif
@@ -103,6 +104,13 @@ namespace weex {
                int64_t JsAction(long ctxContainer, int32_t jsActionType, const char *arg) override ;
 
             private:
+#ifdef USE_JS_RUNTIME
+                // Instance placement over weexTaskQueue_ and the extra
+                // runtimes, backup thread instances are bound in it too.
+                WeexTaskQueuePool queuePool_;
+
+                WeexTaskQueue *backUpTaskQueue();
+#else
                 std::vector<std::string> usingBackThreadId;
 
                 void useBackUpWeexRuntime(std::string id);
@@ -110,6 +118,7 @@ namespace weex {
                 bool shouldUseBackUpWeexRuntime(std::string id);
 
                 void deleteBackUpRuntimeInstance(std::string id);
+#endif
 
                 WeexTaskQueue *taskQueue(const char *id, bool log);
 
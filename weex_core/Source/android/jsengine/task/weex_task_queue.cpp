@@ -37,6 +37,11 @@ void WeexTaskQueue::run(WeexTask *task) {
     task->run(weexRuntime);
     task->timeCalculator->taskEnd();
     delete task;
+    if (isMultiProgress) {
+        // dom actions produced by this task are sent to WeexCore as one batch.
+        static_cast<weex::bridge::js::CoreSideInMultiProcess *>(
+                WeexEnv::getEnv()->scriptBridge()->core_side())->FlushDomActions();
+    }
 }
 
 
@@ -20,6 +20,8 @@
 // Created by Darin on 06/07/2018.
 //
 #include "android/jsengine/weex_ipc_client.h"
+#include "android/jsengine/object/weex_env.h"
+#include "third_party/IPC/IPCMessageJS.h"
 
 #include <sys/mman.h>
 #include <errno.h>
@@ -28,7 +30,7 @@
 #include "base/utils/log_utils.h"
 
 WeexIPCClient::WeexIPCClient(int fd) {
-    void *base = mmap(nullptr, IPCFutexPageQueue::ipc_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    void *base = mmap(nullptr, IPCFutexPageQueue::ipc_mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
     if (base == MAP_FAILED) {
         int _errno = errno;
         close(fd);
@@ -36,7 +38,9 @@ WeexIPCClient::WeexIPCClient(int fd) {
     }
 
 
-    futexPageQueue.reset(new IPCFutexPageQueue(base, IPCFutexPageQueue::ipc_size, 1));
+    futexPageQueue.reset(new IPCFutexPageQueue(base, IPCFutexPageQueue::ipc_mapping_size, 1));
+    if (WeexEnv::getEnv()->enableTrace())
+        futexPageQueue->tracer()->setEnabled(true, IPCProxyMsgName, IPCJSMsgName);
     handler = std::move(createIPCHandler());
     sender = std::move(createIPCSender(futexPageQueue.get(), handler.get()));
     serializer = std::move(createIPCSerializer());
@@ -24,7 +24,10 @@
 #include "core/manager/weex_core_manager.h"
 #include "android/jsengine/weex_jsc_utils.h"
 #include "base/log_defines.h"
+#include "base/trace/trace_log.h"
 #include "android/jsengine/object/log_utils_jss.h"
+#include "third_party/IPC/IPCMessageJS.h"
+#include "third_party/IPC/IPCTracer.h"
 #ifdef USE_JS_RUNTIME
 #include "base/crash/crash_handler.h"
 #include <unistd.h>
@@ -51,14 +54,19 @@ WeexJSServer::WeexJSServerImpl::WeexJSServerImpl(int serverFd, int clientFd, boo
     WeexEnv::getEnv()->setIpcClientFd(clientFd);
     WeexEnv::getEnv()->setEnableTrace(enableTrace);
     int _fd = serverFd;
-    void *base = mmap(nullptr, IPCFutexPageQueue::ipc_size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+    void *base = mmap(nullptr, IPCFutexPageQueue::ipc_mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
     if (base == MAP_FAILED) {
         int _errno = errno;
         close(_fd);
         //throw IPCException("failed to map ashmem region: %s", strerror(_errno));
     }
     close(_fd);
-    futexPageQueue.reset(new IPCFutexPageQueue(base, IPCFutexPageQueue::ipc_size, 1));
+    futexPageQueue.reset(new IPCFutexPageQueue(base, IPCFutexPageQueue::ipc_mapping_size, 1));
+    IPCTracer::setFlowHooks(weex::base::TraceLog::CurrentFlowId, weex::base::TraceLog::SetCurrentFlowId);
+    if (enableTrace) {
+        futexPageQueue->tracer()->setEnabled(true, IPCProxyMsgName, IPCJSMsgName);
+        weex::base::TraceLog::GetInstance()->SetEnabled(true);
+    }
     handler = std::move(createIPCHandler());
     sender = std::move(createIPCSender(futexPageQueue.get(), handler.get()));
     listener = std::move(createIPCListener(futexPageQueue.get(), handler.get()));
@@ -170,7 +170,7 @@ static void *newIPCServer(void *_td) {
 
     IPCHandler *handler = server->handler.get();
     std::unique_ptr<IPCFutexPageQueue> futexPageQueue(
-            new IPCFutexPageQueue(base, IPCFutexPageQueue::ipc_size, 0));
+            new IPCFutexPageQueue(base, IPCFutexPageQueue::ipc_mapping_size, 0));
     const std::unique_ptr<IPCHandler> &testHandler = createIPCHandler();
     std::unique_ptr<IPCSender> sender(createIPCSender(futexPageQueue.get(), handler));
     std::unique_ptr<IPCListener> listener =std::move(createIPCListener(futexPageQueue.get(), handler)) ;
@@ -212,7 +212,7 @@ IPCSender *WeexJSConnection::start(bool reinit) {
   }
 
   std::unique_ptr<IPCFutexPageQueue> futexPageQueue(
-          new IPCFutexPageQueue(base, IPCFutexPageQueue::ipc_size, 0));
+          new IPCFutexPageQueue(base, IPCFutexPageQueue::ipc_mapping_size, 0));
   std::unique_ptr<IPCSender> sender(createIPCSender(futexPageQueue.get(), client_->handler.get()));
   m_impl->serverSender = std::move(sender);
   m_impl->futexPageQueue = std::move(futexPageQueue);
@@ -275,7 +275,7 @@ IPCSender *WeexJSConnection::start(bool reinit) {
   }
   if (child == -1) {
     int myerrno = errno;
-    munmap(base, IPCFutexPageQueue::ipc_size);
+    munmap(base, IPCFutexPageQueue::ipc_mapping_size);
     throw IPCException("failed to fork: %s", strerror(myerrno));
   } else if (child == 0) {
     __android_log_print(ANDROID_LOG_ERROR,"weex","weexcore fork child success\n");
@@ -616,7 +616,7 @@ void *WeexConnInfo::mmap_for_ipc() {
   int initTimes = 1;
   void *base = MAP_FAILED;
   do {
-    fd = memfd_create(fileName.c_str(), IPCFutexPageQueue::ipc_size);
+    fd = memfd_create(fileName.c_str(), IPCFutexPageQueue::ipc_mapping_size);
     if (-1 == fd) {
       if (this->is_client) {
         throw IPCException("failed to create ashmem region: %s", strerror(errno));
@@ -625,7 +625,7 @@ void *WeexConnInfo::mmap_for_ipc() {
         return base;
       }
     }
-    base = mmap(nullptr, IPCFutexPageQueue::ipc_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+    base = mmap(nullptr, IPCFutexPageQueue::ipc_mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED,
                 fd, 0);
     if (base == MAP_FAILED) {
       close(fd);
@@ -71,4 +71,14 @@ void HashSet::Add(JNIEnv* env, const std::set<std::string>& set) {
     env->DeleteLocalRef(jni_value);
   }
 }
+
+void HashSet::Add(JNIEnv* env, const SmallStringSet& set) {
+  jstring jni_value;
+
+  for (const std::string& value : set) {
+    jni_value = env->NewStringUTF(value.c_str());
+    Java_HashSet_add(env, jni_object(), jni_value);
+    env->DeleteLocalRef(jni_value);
+  }
+}
 }  // namespace WeexCore
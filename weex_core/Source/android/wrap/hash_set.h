@@ -24,6 +24,7 @@
 #include <set>
 #include <string>
 #include "base/android/jni/jni_object_wrap.h"
+#include "core/common/small_string_map.h"
 
 namespace WeexCore {
 class HashSet : public JNIObjectWrap {
@@ -33,6 +34,7 @@ class HashSet : public JNIObjectWrap {
   virtual ~HashSet();
 
   void Add(JNIEnv* env, const std::set<std::string>& set);
+  void Add(JNIEnv* env, const SmallStringSet& set);
 
  private:
   DISALLOW_COPY_AND_ASSIGN(HashSet);
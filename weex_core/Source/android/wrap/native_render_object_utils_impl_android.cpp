@@ -107,8 +107,9 @@ static jint LayoutRenderObject(JNIEnv* env, jclass jcaller,
     }
 
     RenderObject *render = convert_long_to_render_object(ptr);
+    RenderList* renderList = nullptr;
     if(render->type() == WeexCore::kRenderCell || render->type() == WeexCore::kRenderCellSlot){
-        RenderList* renderList = static_cast<RenderList*>(render->getParent());
+        renderList = static_cast<RenderList*>(render->getParent());
         if(renderList != nullptr){
             if(renderList->TakeColumnCount() > 1  && renderList->TakeColumnWidth() > 0){
                 renderPageSize.first = renderList->TakeColumnWidth();
@@ -121,9 +122,13 @@ static jint LayoutRenderObject(JNIEnv* env, jclass jcaller,
         render->setStyleWidthLevel(CSS_STYLE);
     }
 
-  render->LayoutBeforeImpl();
-    render->calculateLayout(renderPageSize);
-    render->LayoutAfterImpl();
+    if(renderList != nullptr){
+        renderList->LayoutCell(render, renderPageSize);
+    }else{
+        render->LayoutBeforeImpl();
+        render->calculateLayout(renderPageSize);
+        render->LayoutAfterImpl();
+    }
 
     return (jint)render->getLayoutHeight();
 }
@@ -22,6 +22,9 @@
 #include "core/render/manager/render_manager.h"
 #include "base/time_calculator.h"
 #include "base/log_defines.h"
+#include "base/message_loop/message_loop.h"
+#include "base/thread/waitable_event.h"
+#include "base/trace/trace_log.h"
 
 #include "android/wrap/log_utils.h"
 #include "android/base/string/string_utils.h"
@@ -46,6 +49,9 @@
 #include "core/bridge/eagle_bridge.h"
 #include "core/common/view_utils.h"
 #include "third_party/json11/json11.hpp"
+#include "third_party/IPC/IPCFutexPageQueue.h"
+#include "third_party/IPC/IPCMessageJS.h"
+#include "third_party/IPC/IPCTracer.h"
 #include "core/moniter/render_performance.h"
 #include "core/render/page/render_page_base.h"
 #include "third_party/IPC/IPCFutexPageQueue.h"
@@ -234,6 +240,38 @@ static void MarkDirty(JNIEnv* env, jobject jcaller, jstring instanceId,
       jString2StrFast(env, instanceId), jString2StrFast(env, ref));
 }
 
+static void SetScrollOffset(JNIEnv* env, jobject jcaller, jstring instanceId,
+                            jstring ref, jfloat offset) {
+  WeexCoreManager::Instance()->getPlatformBridge()->core_side()->SetScrollOffset(
+      jString2StrFast(env, instanceId), jString2StrFast(env, ref), offset);
+}
+
+// Call on main thread. The counters are read on the WeexCore thread, which
+// owns the render pages.
+static jlongArray GetPageMemoryStats(JNIEnv* env, jobject jcaller,
+                                     jstring instanceId) {
+  std::string page_id = jString2StrFast(env, instanceId);
+  std::vector<int64_t> stats;
+  weex::base::WaitableEvent event;
+  WeexCoreManager::Instance()->script_thread()->message_loop()->PostTask(
+      [&page_id, &stats, &event] {
+        stats = WeexCoreManager::Instance()
+                    ->getPlatformBridge()
+                    ->core_side()
+                    ->GetPageMemoryStats(page_id);
+        event.Signal();
+      });
+  event.Wait();
+
+  jlongArray jStats = env->NewLongArray(static_cast<jsize>(stats.size()));
+  if (jStats != nullptr && !stats.empty()) {
+    std::vector<jlong> ret(stats.begin(), stats.end());
+    env->SetLongArrayRegion(jStats, 0, static_cast<jsize>(ret.size()),
+                            ret.data());
+  }
+  return jStats;
+}
+
 static void RegisterCoreEnv(JNIEnv* env, jobject jcaller, jstring key,
                             jstring value) {
   WeexCoreManager::Instance()
@@ -282,6 +320,19 @@ static void SetLogType(JNIEnv* env, jobject jcaller, jfloat logLevel,
   bool flag = isPerf == 1;
   weex::base::LogImplement::getLog()->setPerfMode(flag);
   LOGE("WeexCore setLog Level %d in Performance mode %s debug %d", l, flag ? "true" : "false", (int)WeexCore::LogLevel::Debug);
+  // ipc latency histograms and task traces are only collected in
+  // performance mode.
+  IPCTracer::setFlowHooks(weex::base::TraceLog::CurrentFlowId,
+                          weex::base::TraceLog::SetCurrentFlowId);
+  weex::base::TraceLog::GetInstance()->SetEnabled(flag);
+  if (WeexCoreManager::Instance()->client_queue_ != nullptr) {
+    WeexCoreManager::Instance()->client_queue_->tracer()->setEnabled(
+        flag, IPCJSMsgName, IPCProxyMsgName);
+  }
+  if (WeexCoreManager::Instance()->server_queue_ != nullptr) {
+    WeexCoreManager::Instance()->server_queue_->tracer()->setEnabled(
+        flag, IPCJSMsgName, IPCProxyMsgName);
+  }
   WeexCoreManager::Instance()
       ->getPlatformBridge()
       ->core_side()
@@ -292,15 +343,29 @@ static jstring nativeDumpIpcPageQueueInfo(JNIEnv* env, jobject jcaller){
     std::string client_quene_msg;
     if (WeexCoreManager::Instance()->client_queue_ != nullptr){
         WeexCoreManager::Instance()->client_queue_->dumpPageInfo(client_quene_msg);
+        std::string trace_msg;
+        WeexCoreManager::Instance()->client_queue_->dumpTraceInfo(trace_msg);
+        client_quene_msg += "\n" + trace_msg;
     }
     std::string server_quene_msg;
     if (WeexCoreManager::Instance()->server_queue_ != nullptr){
         WeexCoreManager::Instance()->server_queue_->dumpPageInfo(server_quene_msg);
+        std::string trace_msg;
+        WeexCoreManager::Instance()->server_queue_->dumpTraceInfo(trace_msg);
+        server_quene_msg += "\n" + trace_msg;
     }
     std::string result ;
     result = "{client:"+client_quene_msg+"}\n"+"{server:"+server_quene_msg+"}";
     return env->NewStringUTF(result.c_str());
 }
+
+// Chrome trace event JSON of the tasks this process ran while performance
+// mode was on, for chrome://tracing or Perfetto.
+static jstring nativeDumpTrace(JNIEnv* env, jobject jcaller) {
+  std::string json;
+  weex::base::TraceLog::GetInstance()->ExportJson(&json);
+  return env->NewStringUTF(json.c_str());
+}
 static void ReloadPageLayout(JNIEnv *env, jobject jcaller,
                               jstring instanceId){
   WeexCoreManager::Instance()->getPlatformBridge()->core_side()->RelayoutUsingRawCssStyles(jString2StrFast(env,instanceId));
@@ -882,9 +947,9 @@ int WXBridge::Layout(JNIEnv* env, const char* page_id, const char* ref, int top,
 int WXBridge::AddElement(JNIEnv* env, const char* page_id,
                          const char* component_type, const char* ref,
                          int& index, const char* parentRef,
-                         std::map<std::string, std::string>* styles,
-                         std::map<std::string, std::string>* attributes,
-                         std::set<std::string>* events,
+                         SmallStringMap* styles,
+                         SmallStringMap* attributes,
+                         SmallStringSet* events,
                          const WXCoreMargin& margins,
                          const WXCorePadding& paddings,
                          const WXCoreBorderWidth& borders, bool willLayout) {
@@ -948,9 +1013,9 @@ int WXBridge::AddElement(JNIEnv* env, const char* page_id,
 
 int WXBridge::CreateBody(JNIEnv* env, const char* page_id,
                          const char* component_type, const char* ref,
-                         std::map<std::string, std::string>* styles,
-                         std::map<std::string, std::string>* attributes,
-                         std::set<std::string>* events,
+                         SmallStringMap* styles,
+                         SmallStringMap* attributes,
+                         SmallStringSet* events,
                          const WXCoreMargin& margins,
                          const WXCorePadding& paddings,
                          const WXCoreBorderWidth& borders) {
@@ -1037,7 +1102,7 @@ int WXBridge::AddEvent(JNIEnv* env, const char* page_id, const char* ref,
 
 int WXBridge::AddChildToRichtext(JNIEnv* env, const char *pageId, const char *nodeType,
         const char *ref,const char *parentRef,const char *richtextRef,
-        std::map<std::string, std::string> *styles,std::map<std::string, std::string> *attributes) {
+        SmallStringMap *styles,SmallStringMap *attributes) {
     auto jPageId = base::android::ScopedLocalJavaRef<jstring>(env, env->NewStringUTF(pageId));
     auto jParentPef = base::android::ScopedLocalJavaRef<jstring >(env, env->NewStringUTF(parentRef));
     auto jRef = base::android::ScopedLocalJavaRef<jstring >(env, env->NewStringUTF(ref));
@@ -64,7 +64,7 @@ class WXBridge : public JNIObjectWrap {
                   std::vector<std::pair<std::string, std::string>> *border);
   int AddChildToRichtext(JNIEnv* env, const char *pageId, const char *nodeType,
           const char *ref,const char *parentRef,const char *richtextRef,
-          std::map<std::string, std::string> *styles,std::map<std::string, std::string> *attributes);
+          SmallStringMap *styles,SmallStringMap *attributes);
   int RemoveChildFromRichtext(JNIEnv* env, const char *pageId, const char *ref, const char *parent_ref,
                                           const char *richtext_ref);
   int UpdateRichtextStyle(JNIEnv* env, const char *pageId, const char *ref,
@@ -78,15 +78,15 @@ class WXBridge : public JNIObjectWrap {
              bool isRTL, int index);
   int AddElement(JNIEnv *env, const char *page_id, const char *component_type,
                  const char *ref, int &index, const char *parentRef,
-                 std::map<std::string, std::string> *styles,
-                 std::map<std::string, std::string> *attributes,
-                 std::set<std::string> *events, const WXCoreMargin &margins,
+                 SmallStringMap *styles,
+                 SmallStringMap *attributes,
+                 SmallStringSet *events, const WXCoreMargin &margins,
                  const WXCorePadding &paddings,
                  const WXCoreBorderWidth &borders, bool willLayout);
   int CreateBody(JNIEnv *env, const char *page_id, const char *component_type,
-                 const char *ref, std::map<std::string, std::string> *styles,
-                 std::map<std::string, std::string> *attributes,
-                 std::set<std::string> *events, const WXCoreMargin &margins,
+                 const char *ref, SmallStringMap *styles,
+                 SmallStringMap *attributes,
+                 SmallStringSet *events, const WXCoreMargin &margins,
                  const WXCorePadding &paddings,
                  const WXCoreBorderWidth &borders);
   int RemoveEvent(JNIEnv *env, const char *page_id, const char *ref,
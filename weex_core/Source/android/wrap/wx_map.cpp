@@ -92,4 +92,17 @@ void WXMap::Put(JNIEnv* env, const std::map<std::string, std::string>& map) {
     env->DeleteLocalRef(jni_key);
   }
 }
+
+void WXMap::Put(JNIEnv* env, const SmallStringMap& map) {
+  jstring jni_key;
+  jbyteArray jni_value;
+
+  for (const SmallStringMap::value_type& entry : map) {
+    jni_key = env->NewStringUTF(entry.first.c_str());
+    jni_value = newJByteArray(env, entry.second.c_str());
+    Java_WXMap_put(env, jni_object(), jni_key, jni_value);
+    env->DeleteLocalRef(jni_value);
+    env->DeleteLocalRef(jni_key);
+  }
+}
 }  // namespace WeexCore
@@ -27,6 +27,7 @@
 #include "base/android/jni/scoped_java_ref.h"
 #include "base/android/jni/jni_object_wrap.h"
 #include "base/common.h"
+#include "core/common/small_string_map.h"
 
 namespace WeexCore {
 class WXMap : public JNIObjectWrap {
@@ -38,6 +39,7 @@ class WXMap : public JNIObjectWrap {
   void Put(JNIEnv* env,
            const std::vector<std::pair<std::string, std::string>>& vector);
   void Put(JNIEnv* env, const std::map<std::string, std::string>& map);
+  void Put(JNIEnv* env, const SmallStringMap& map);
 
  private:
   DISALLOW_COPY_AND_ASSIGN(WXMap);
@@ -106,6 +106,9 @@ static jlongArray GetFirstScreenRenderTime(JNIEnv *env, jobject jcaller,
 static jlongArray GetRenderFinishTime(JNIEnv *env, jobject jcaller,
                                       jstring instanceId);
 
+static jlongArray GetPageMemoryStats(JNIEnv *env, jobject jcaller,
+                                     jstring instanceId);
+
 static void SetDefaultHeightAndWidthIntoRootDom(JNIEnv *env, jobject jcaller,
                                                 jstring instanceId,
                                                 jfloat defaultWidth,
@@ -155,6 +158,11 @@ static void MarkDirty(JNIEnv *env, jobject jcaller,
                       jstring ref,
                       jboolean dirty);
 
+static void SetScrollOffset(JNIEnv *env, jobject jcaller,
+                            jstring instanceId,
+                            jstring ref,
+                            jfloat offset);
+
 static void SetDeviceDisplay(JNIEnv *env, jobject jcaller,
                              jstring instanceId, jfloat width, jfloat height, jfloat scale);
 
@@ -193,6 +201,7 @@ static void SetLogType(JNIEnv* env, jobject jcaller, jfloat type,
                        jfloat isPerf);
 
 static jstring nativeDumpIpcPageQueueInfo(JNIEnv* env, jobject jcaller);
+static jstring nativeDumpTrace(JNIEnv* env, jobject jcaller);
 static void ReloadPageLayout(JNIEnv *env, jobject jcaller,
                              jstring instanceId);
 static void SetDeviceDisplayOfPage(JNIEnv *env, jobject jcaller,
@@ -1244,6 +1253,11 @@ static const JNINativeMethod kMethodsWXBridge[] = {
      "Ljava/lang/String;"
      ")"
      "[J", reinterpret_cast<void *>(GetRenderFinishTime)},
+    {"nativeGetPageMemoryStats",
+     "("
+     "Ljava/lang/String;"
+     ")"
+     "[J", reinterpret_cast<void *>(GetPageMemoryStats)},
     {"nativeSetDefaultHeightAndWidthIntoRootDom",
      "("
      "Ljava/lang/String;"
@@ -1313,6 +1327,13 @@ static const JNINativeMethod kMethodsWXBridge[] = {
      "Z"
      ")"
      "V", reinterpret_cast<void *>(MarkDirty)},
+    {"nativeSetScrollOffset",
+     "("
+     "Ljava/lang/String;"
+     "Ljava/lang/String;"
+     "F"
+     ")"
+     "V", reinterpret_cast<void *>(SetScrollOffset)},
     {"nativeSetDeviceDisplay",
      "("
      "Ljava/lang/String;"
@@ -1379,6 +1400,10 @@ static const JNINativeMethod kMethodsWXBridge[] = {
     "("
     ")"
     "Ljava/lang/String;", reinterpret_cast<void*>(nativeDumpIpcPageQueueInfo) },
+    { "nativeDumpTrace",
+    "("
+    ")"
+    "Ljava/lang/String;", reinterpret_cast<void*>(nativeDumpTrace) },
     {"nativeReloadPageLayout",
      "("
      "Ljava/lang/String;"
@@ -18,6 +18,7 @@
  */
 
 #include "log_defines.h"
+#include <cstdarg>
 #include <string>
 #include <array>
 
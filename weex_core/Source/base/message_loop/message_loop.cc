@@ -18,13 +18,19 @@
  */
 
 #include "base/message_loop/message_loop.h"
+
+#include <algorithm>
 #include "base/thread/thread_local.h"
+#include "base/trace/trace_event.h"
 #ifdef __ANDROID__
 #include "base/message_loop/message_pump_android.h"
 #elif OS_IOS
 #include "base/message_loop/message_pump_darwin.h"
 #endif
 #include "base/message_loop/message_pump_posix.h"
+#ifdef __linux__
+#include "base/message_loop/message_pump_linux.h"
+#endif
 
 namespace weex {
 namespace base {
@@ -32,7 +38,12 @@ namespace base {
 ThreadLocal<MessageLoop> s_tl_message_loop;
 
 MessageLoop::MessageLoop(Type type)
-    : delayed_tasks_(), type_(type), delayed_tasks_mutex_() {
+    : delayed_tasks_(),
+      due_tasks_(),
+      next_sequence_(0),
+      stats_(),
+      type_(type),
+      delayed_tasks_mutex_() {
   switch (type) {
     case PLATFORM:
 #ifdef __ANDROID__ 
@@ -45,6 +56,11 @@ MessageLoop::MessageLoop(Type type)
       message_pump_ = std::unique_ptr<MessagePump>(new MessagePumpPosix());
       break;
     case IO:
+#ifdef __linux__
+      message_pump_ = std::unique_ptr<MessagePump>(new MessagePumpLinux());
+#else
+      message_pump_ = std::unique_ptr<MessagePump>(new MessagePumpPosix());
+#endif
       break;
   }
 }
@@ -60,62 +76,134 @@ void MessageLoop::Run() {
 
 void MessageLoop::Stop() { message_pump_->Stop(); }
 
+#ifdef __linux__
+bool MessageLoop::WatchFileDescriptor(int fd, MessagePumpLinux::WatchMode mode,
+                                      MessagePumpLinux::FdWatcher* watcher) {
+  if (type_ != IO) return false;
+  return static_cast<MessagePumpLinux*>(message_pump_.get())
+      ->WatchFileDescriptor(fd, mode, watcher);
+}
+
+bool MessageLoop::StopWatchingFileDescriptor(int fd) {
+  if (type_ != IO) return false;
+  return static_cast<MessagePumpLinux*>(message_pump_.get())
+      ->StopWatchingFileDescriptor(fd);
+}
+#endif
+
 void MessageLoop::DoWork() {
-  std::vector<Closure> closure_list;
+  // Swapped out so a task running a nested loop gets a buffer of its own.
+  std::vector<DelayedTask> due;
+  due.swap(due_tasks_);
   {
     std::lock_guard<std::mutex> lock(delayed_tasks_mutex_);
 
     if (delayed_tasks_.empty()) {
+      due_tasks_.swap(due);
       return;
     }
 
     auto now = TimePoint::Now();
     while (!delayed_tasks_.empty()) {
-      const auto& top = delayed_tasks_.top();
-      if (top.time_point > now) {
+      if (delayed_tasks_.front().time_point > now) {
         break;
       }
-      closure_list.emplace_back(std::move(top.task));
-      delayed_tasks_.pop();
+      std::pop_heap(delayed_tasks_.begin(), delayed_tasks_.end(),
+                    DelayedTaskCompare());
+      DelayedTask& top = delayed_tasks_.back();
+      if (top.cancelled && top.cancelled->load(std::memory_order_relaxed)) {
+        ++stats_.tasks_cancelled;
+      } else {
+        if (top.delayed) {
+          int64_t lateness = (now - top.time_point).ToMicroseconds();
+          ++stats_.delayed_tasks_run;
+          stats_.total_lateness_us += lateness;
+          if (lateness > stats_.max_lateness_us) {
+            stats_.max_lateness_us = lateness;
+          }
+        }
+        due.emplace_back(std::move(top));
+      }
+      delayed_tasks_.pop_back();
     }
+    stats_.tasks_run += due.size();
+    stats_.queue_depth = delayed_tasks_.size();
 
     if (!delayed_tasks_.empty()) {
-      message_pump_->ScheduleDelayedWork(delayed_tasks_.top().time_point - now);
+      message_pump_->ScheduleDelayedWork(delayed_tasks_.front().time_point -
+                                         now);
     }
   }
 
-  for (const auto& closure : closure_list) {
-    closure();
+  for (const auto& delayed_task : due) {
+    // Cancel() may have come in after the task was taken off the heap.
+    if (delayed_task.cancelled &&
+        delayed_task.cancelled->load(std::memory_order_relaxed)) {
+      continue;
+    }
+    if (delayed_task.trace_flow_id == 0) {
+      delayed_task.task();
+      continue;
+    }
+    ScopedTraceFlow flow(delayed_task.trace_flow_id);
+    TRACE_EVENT("weex.core", "MessageLoop::RunTask");
+    delayed_task.task();
   }
+  due.clear();
+  due_tasks_.swap(due);
 }
 
-void MessageLoop::PostTask(const Closure& closure) {
-  PostDelayedTask(closure, 0);
+void MessageLoop::PostTask(Closure closure) {
+  PostDelayedTask(std::move(closure), 0);
 }
 
-void MessageLoop::PostPriorityTask(TaskPriority p, const Closure& closure) {
-  PostPriorityDelayedTask(p, closure, 0);
+void MessageLoop::PostPriorityTask(TaskPriority p, Closure closure) {
+  PostPriorityDelayedTask(p, std::move(closure), 0);
 }
 
-void MessageLoop::PostDelayedTask(const Closure& closure, int64_t delayed_ms) {
-  PostPriorityDelayedTask(TaskPriority::NORMAL, closure, delayed_ms);
+void MessageLoop::PostDelayedTask(Closure closure, int64_t delayed_ms) {
+  PostPriorityDelayedTask(TaskPriority::NORMAL, std::move(closure), delayed_ms);
 }
 
-void MessageLoop::PostPriorityDelayedTask(TaskPriority p,
-                                          const Closure& closure,
+void MessageLoop::PostPriorityDelayedTask(TaskPriority p, Closure closure,
                                           int64_t delayed_ms) {
+  PostTaskInternal(p, std::move(closure), delayed_ms, nullptr);
+}
+
+MessageLoop::TaskHandle MessageLoop::PostCancelableDelayedTask(
+    Closure closure, int64_t delayed_ms) {
+  std::shared_ptr<std::atomic<bool>> cancelled(new std::atomic<bool>(false));
+  PostTaskInternal(TaskPriority::NORMAL, std::move(closure), delayed_ms,
+                   cancelled);
+  return TaskHandle(std::move(cancelled));
+}
+
+MessageLoop::Stats MessageLoop::GetStats() {
+  std::lock_guard<std::mutex> lock(delayed_tasks_mutex_);
+  return stats_;
+}
+
+void MessageLoop::PostTaskInternal(
+    TaskPriority p, Closure closure, int64_t delayed_ms,
+    std::shared_ptr<std::atomic<bool>> cancelled) {
   TimePoint time_point =
       TimePoint::Now() + TimeUnit::FromMilliseconds(delayed_ms);
+  uint64_t trace_flow_id =
+      TraceLog::IsEnabled() ? TraceLog::CurrentFlowId() : 0;
   std::lock_guard<std::mutex> lock(delayed_tasks_mutex_);
   // If the time of top task don't change, we don't need to reschedule.
-  if (!delayed_tasks_.empty()) {
-    auto old_top_time = delayed_tasks_.top().time_point;
-    delayed_tasks_.push({p, std::move(closure), std::move(time_point)});
-    if (old_top_time > delayed_tasks_.top().time_point) {
-      message_pump_->ScheduleWork();
-    }
-  } else {
-    delayed_tasks_.push({p, std::move(closure), std::move(time_point)});
+  bool reschedule = delayed_tasks_.empty() ||
+                    delayed_tasks_.front().time_point > time_point;
+  delayed_tasks_.emplace_back(p, next_sequence_++, delayed_ms > 0,
+                              std::move(closure), time_point,
+                              std::move(cancelled), trace_flow_id);
+  std::push_heap(delayed_tasks_.begin(), delayed_tasks_.end(),
+                 DelayedTaskCompare());
+  stats_.queue_depth = delayed_tasks_.size();
+  if (stats_.queue_depth > stats_.max_queue_depth) {
+    stats_.max_queue_depth = stats_.queue_depth;
+  }
+  if (reschedule) {
     message_pump_->ScheduleWork();
   }
 }
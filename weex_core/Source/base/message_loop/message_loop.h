@@ -19,13 +19,17 @@
 #ifndef BASE_MESSAGE_LOOP_MESSAGE_LOOP_H
 #define BASE_MESSAGE_LOOP_MESSAGE_LOOP_H
 
+#include <stdint.h>
+#include <atomic>
 #include <memory>
-#include <deque>
 #include <mutex>
-#include <queue>
+#include <vector>
 #include "base/closure.h"
 #include "base/common.h"
 #include "base/message_loop/message_pump.h"
+#ifdef __linux__
+#include "base/message_loop/message_pump_linux.h"
+#endif
 #include "base/time_point.h"
 
 namespace weex {
@@ -41,46 +45,108 @@ class MessageLoop : public MessagePump::Delegate {
     UI = 10,
     NORMAL = 5,
   };
+
+  // Returned by PostCancelableDelayedTask. Cancel() keeps the task from
+  // running if it has not started yet and may be called from any thread,
+  // also after the loop is gone.
+  class TaskHandle {
+   public:
+    TaskHandle() {}
+    void Cancel() {
+      if (cancelled_) cancelled_->store(true, std::memory_order_relaxed);
+    }
+    bool IsValid() const { return cancelled_ != nullptr; }
+
+   private:
+    friend class MessageLoop;
+    explicit TaskHandle(std::shared_ptr<std::atomic<bool>> cancelled)
+        : cancelled_(std::move(cancelled)) {}
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+  };
+
+  struct Stats {
+    // Tasks waiting in the queue now, and the most there have been.
+    size_t queue_depth = 0;
+    size_t max_queue_depth = 0;
+    uint64_t tasks_run = 0;
+    uint64_t tasks_cancelled = 0;
+    // How long after their due time delayed tasks started, in microseconds.
+    uint64_t delayed_tasks_run = 0;
+    int64_t total_lateness_us = 0;
+    int64_t max_lateness_us = 0;
+  };
+
   MessageLoop(Type type);
   ~MessageLoop();
 
   static MessageLoop* GetCurrent();
 
   // The unit of the priority task is milliseconds
-  void PostTask(const Closure& closure);
-  void PostPriorityTask(TaskPriority p, const Closure& closure);
-  void PostDelayedTask(const Closure& closure, int64_t delayed_ms);
-  void PostPriorityDelayedTask(TaskPriority p, const Closure& closure,
+  void PostTask(Closure closure);
+  void PostPriorityTask(TaskPriority p, Closure closure);
+  void PostDelayedTask(Closure closure, int64_t delayed_ms);
+  void PostPriorityDelayedTask(TaskPriority p, Closure closure,
                                int64_t delayed_ms);
+  TaskHandle PostCancelableDelayedTask(Closure closure, int64_t delayed_ms);
+
+  Stats GetStats();
 
   void Run();
   void Stop();
 
+#ifdef __linux__
+  // Only IO loops watch file descriptors, other types return false. See
+  // MessagePumpLinux for the threading rules.
+  bool WatchFileDescriptor(int fd, MessagePumpLinux::WatchMode mode,
+                           MessagePumpLinux::FdWatcher* watcher);
+  bool StopWatchingFileDescriptor(int fd);
+#endif
+
   inline Type type() { return type_; }
 
  private:
   void DoWork();
 
+  void PostTaskInternal(TaskPriority p, Closure closure, int64_t delayed_ms,
+                        std::shared_ptr<std::atomic<bool>> cancelled);
+
+  // Tasks are moved in and out of a binary heap kept in a vector, which
+  // std::priority_queue cannot do since top() is const.
   struct DelayedTask {
     TimePoint time_point;
     size_t priority;
+    uint64_t sequence;
+    bool delayed;
     Closure task;
-    DelayedTask(size_t p_priority, Closure p_task, TimePoint p_time_point)
-        : priority(p_priority),
+    std::shared_ptr<std::atomic<bool>> cancelled;
+    // Trace flow of the posting thread, carried over to the task.
+    uint64_t trace_flow_id;
+    DelayedTask(size_t p_priority, uint64_t p_sequence, bool p_delayed,
+                Closure p_task, TimePoint p_time_point,
+                std::shared_ptr<std::atomic<bool>> p_cancelled,
+                uint64_t p_trace_flow_id)
+        : time_point(p_time_point),
+          priority(p_priority),
+          sequence(p_sequence),
+          delayed(p_delayed),
           task(std::move(p_task)),
-          time_point(p_time_point) {}
+          cancelled(std::move(p_cancelled)),
+          trace_flow_id(p_trace_flow_id) {}
   };
+  // Orders the heap so the earliest task is on top, then the higher
+  // priority, then the one posted first.
   struct DelayedTaskCompare {
-    bool operator()(const DelayedTask& a, const DelayedTask& b) {
-      return a.time_point == b.time_point
-                 ? a.priority < b.priority
-                 : a.time_point > b.time_point;
+    bool operator()(const DelayedTask& a, const DelayedTask& b) const {
+      if (a.time_point != b.time_point) return a.time_point > b.time_point;
+      if (a.priority != b.priority) return a.priority < b.priority;
+      return a.sequence > b.sequence;
     };
   };
-  using DelayedTaskQueue =
-      std::priority_queue<DelayedTask, std::deque<DelayedTask>,
-                          DelayedTaskCompare>;
-  DelayedTaskQueue delayed_tasks_;
+  std::vector<DelayedTask> delayed_tasks_;
+  // Due tasks of one DoWork, kept to reuse its capacity.
+  std::vector<DelayedTask> due_tasks_;
+  uint64_t next_sequence_;
+  Stats stats_;
   Type type_;
   std::unique_ptr<MessagePump> message_pump_;
   std::mutex delayed_tasks_mutex_;
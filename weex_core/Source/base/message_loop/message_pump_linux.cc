@@ -0,0 +1,174 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "base/message_loop/message_pump_linux.h"
+#ifdef __linux__
+
+#include <errno.h>
+#include <stdint.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include "base/log_defines.h"
+
+namespace weex {
+namespace base {
+
+namespace {
+const int kMaxEvents = 16;
+
+uint32_t ToEpollEvents(MessagePumpLinux::WatchMode mode) {
+  uint32_t events = 0;
+  if (mode & MessagePumpLinux::WATCH_READ) events |= EPOLLIN;
+  if (mode & MessagePumpLinux::WATCH_WRITE) events |= EPOLLOUT;
+  return events;
+}
+
+void Drain(int fd) {
+  uint64_t count;
+  while (read(fd, &count, sizeof(count)) < 0 && errno == EINTR) {
+  }
+}
+}  // namespace
+
+MessagePumpLinux::MessagePumpLinux()
+    : epoll_fd_(epoll_create1(EPOLL_CLOEXEC)),
+      wakeup_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      timer_fd_(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)),
+      stop_request_(false) {
+  if (epoll_fd_ < 0 || wakeup_fd_ < 0 || timer_fd_ < 0) {
+    LOGE("MessagePumpLinux init failed, errno %d", errno);
+    return;
+  }
+  struct epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.fd = wakeup_fd_;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &event);
+  event.data.fd = timer_fd_;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, timer_fd_, &event);
+}
+
+MessagePumpLinux::~MessagePumpLinux() {
+  if (timer_fd_ >= 0) close(timer_fd_);
+  if (wakeup_fd_ >= 0) close(wakeup_fd_);
+  if (epoll_fd_ >= 0) close(epoll_fd_);
+}
+
+void MessagePumpLinux::Run(Delegate* delegate) {
+  struct epoll_event events[kMaxEvents];
+  // Work posted before Run only scheduled a wakeup, start by doing it.
+  bool has_work = true;
+  for (;;) {
+    if (stop_request_.load(std::memory_order_acquire)) break;
+    if (has_work) {
+      delegate->DoWork();
+      has_work = false;
+      continue;
+    }
+
+    int count = epoll_wait(epoll_fd_, events, kMaxEvents, -1);
+    if (count < 0) {
+      if (errno == EINTR) continue;
+      LOGE("MessagePumpLinux epoll_wait failed, errno %d", errno);
+      break;
+    }
+    for (int i = 0; i < count; ++i) {
+      int fd = events[i].data.fd;
+      if (fd == wakeup_fd_ || fd == timer_fd_) {
+        Drain(fd);
+        has_work = true;
+        continue;
+      }
+
+      FdWatcher* watcher = nullptr;
+      WatchMode mode;
+      {
+        std::lock_guard<std::mutex> lock(watches_mutex_);
+        auto it = watches_.find(fd);
+        if (it == watches_.end()) continue;
+        watcher = it->second.watcher;
+        mode = it->second.mode;
+      }
+      uint32_t ready = events[i].events;
+      if ((mode & WATCH_READ) && (ready & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+        watcher->OnFileCanReadWithoutBlocking(fd);
+      }
+      if ((mode & WATCH_WRITE) && (ready & EPOLLOUT)) {
+        // The read callback may have stopped the watch.
+        std::unique_lock<std::mutex> lock(watches_mutex_);
+        auto it = watches_.find(fd);
+        if (it == watches_.end() || it->second.watcher != watcher) continue;
+        lock.unlock();
+        watcher->OnFileCanWriteWithoutBlocking(fd);
+      }
+    }
+  }
+}
+
+void MessagePumpLinux::Stop() {
+  stop_request_.store(true, std::memory_order_release);
+  ScheduleWork();
+}
+
+void MessagePumpLinux::ScheduleWork() {
+  uint64_t one = 1;
+  while (write(wakeup_fd_, &one, sizeof(one)) < 0 && errno == EINTR) {
+  }
+}
+
+void MessagePumpLinux::ScheduleDelayedWork(TimeUnit delayed_time) {
+  int64_t nanos = delayed_time.ToNanoseconds();
+  // A zero it_value disarms the timer, so round up to the smallest delay.
+  if (nanos <= 0) nanos = 1;
+  struct itimerspec spec = {};
+  spec.it_value.tv_sec = nanos / 1000000000;
+  spec.it_value.tv_nsec = nanos % 1000000000;
+  timerfd_settime(timer_fd_, 0, &spec, nullptr);
+}
+
+bool MessagePumpLinux::WatchFileDescriptor(int fd, WatchMode mode,
+                                           FdWatcher* watcher) {
+  if (fd < 0 || watcher == nullptr) return false;
+  std::lock_guard<std::mutex> lock(watches_mutex_);
+  struct epoll_event event = {};
+  event.events = ToEpollEvents(mode);
+  event.data.fd = fd;
+  bool exists = watches_.find(fd) != watches_.end();
+  if (epoll_ctl(epoll_fd_, exists ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd,
+                &event) != 0) {
+    LOGE("MessagePumpLinux watch fd %d failed, errno %d", fd, errno);
+    return false;
+  }
+  watches_[fd] = {mode, watcher};
+  return true;
+}
+
+bool MessagePumpLinux::StopWatchingFileDescriptor(int fd) {
+  std::lock_guard<std::mutex> lock(watches_mutex_);
+  auto it = watches_.find(fd);
+  if (it == watches_.end()) return false;
+  watches_.erase(it);
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+  return true;
+}
+}  // namespace base
+}  // namespace weex
+
+#endif
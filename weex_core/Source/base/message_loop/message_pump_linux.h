@@ -0,0 +1,85 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CORE_BASE_MESSAGE_LOOP_MESSAGE_PUMP_LINUX_H
+#define CORE_BASE_MESSAGE_LOOP_MESSAGE_PUMP_LINUX_H
+#ifdef __linux__
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include "base/common.h"
+#include "base/message_loop/message_pump.h"
+
+namespace weex {
+namespace base {
+// Pump for MessageLoop::IO. Sleeps in epoll_wait on an eventfd for
+// ScheduleWork, a timerfd for ScheduleDelayedWork and any number of watched
+// file descriptors, so sockets and pipes can be served on a
+// weex::base::Thread instead of a dedicated blocking thread.
+class MessagePumpLinux : public MessagePump {
+ public:
+  enum WatchMode {
+    WATCH_READ = 1 << 0,
+    WATCH_WRITE = 1 << 1,
+    WATCH_READ_WRITE = WATCH_READ | WATCH_WRITE,
+  };
+
+  // Called on the pump thread. A hang up or error is reported as readable so
+  // the watcher finds out from its next read.
+  class FdWatcher {
+   public:
+    virtual ~FdWatcher() {}
+    virtual void OnFileCanReadWithoutBlocking(int fd) = 0;
+    virtual void OnFileCanWriteWithoutBlocking(int fd) = 0;
+  };
+
+  MessagePumpLinux();
+  ~MessagePumpLinux();
+  void Run(Delegate* delegate) override;
+  void Stop() override;
+  void ScheduleWork() override;
+  void ScheduleDelayedWork(TimeUnit delayed_time) override;
+
+  // May be called from any thread. Watching an fd again replaces its mode
+  // and watcher. The watcher must outlive the watch; once
+  // StopWatchingFileDescriptor returns on the pump thread it is not called
+  // again for that fd.
+  bool WatchFileDescriptor(int fd, WatchMode mode, FdWatcher* watcher);
+  bool StopWatchingFileDescriptor(int fd);
+
+ private:
+  struct Watch {
+    WatchMode mode;
+    FdWatcher* watcher;
+  };
+
+  int epoll_fd_;
+  int wakeup_fd_;
+  int timer_fd_;
+  std::atomic<bool> stop_request_;
+  std::mutex watches_mutex_;
+  std::unordered_map<int, Watch> watches_;
+  DISALLOW_COPY_AND_ASSIGN(MessagePumpLinux);
+};
+}  // namespace base
+}  // namespace weex
+
+#endif
+#endif  // CORE_BASE_MESSAGE_LOOP_MESSAGE_PUMP_LINUX_H
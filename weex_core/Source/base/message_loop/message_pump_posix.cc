@@ -23,33 +23,51 @@ namespace weex {
 namespace base {
 
 MessagePumpPosix::MessagePumpPosix()
-    : stop_request_(false), condition_(), delayed_time_() {}
+    : stop_request_(false),
+      work_scheduled_(false),
+      condition_(),
+      delayed_time_() {}
 
 MessagePumpPosix::~MessagePumpPosix() {}
 
 void MessagePumpPosix::Run(Delegate* delegate) {
   TimeUnit zero;
+  auto woken = [this] { return work_scheduled_ || stop_request_; };
   for (;;) {
-    if (stop_request_) break;
-    std::unique_lock<std::mutex> lock(mutex_);
-    if (delayed_time_ == zero) {
-      condition_.wait(lock);
-    } else {
-      condition_.wait_for(
-          lock, std::chrono::nanoseconds(delayed_time_.ToNanoseconds()));
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      // ScheduleWork may have come in while DoWork ran, only sleep if not.
+      if (delayed_time_ == zero) {
+        condition_.wait(lock, woken);
+      } else {
+        condition_.wait_for(
+            lock, std::chrono::nanoseconds(delayed_time_.ToNanoseconds()),
+            woken);
+      }
+      if (stop_request_) break;
+      work_scheduled_ = false;
+      delayed_time_ = zero;
     }
-    delayed_time_ = zero;
     delegate->DoWork();
   }
 }
 
-void MessagePumpPosix::Stop() { stop_request_ = true; }
+void MessagePumpPosix::Stop() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stop_request_ = true;
+  condition_.notify_one();
+}
 
-void MessagePumpPosix::ScheduleWork() { condition_.notify_one(); }
+void MessagePumpPosix::ScheduleWork() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  work_scheduled_ = true;
+  condition_.notify_one();
+}
 
 void MessagePumpPosix::ScheduleDelayedWork(TimeUnit delayed_time) {
-  // This method is only used by the same threads as MessageLoop::DoWork, so we
-  // only update the delayed time instead of blocking and waiting.
+  // Only called from MessageLoop::DoWork on the pump thread, Run picks it up
+  // before it sleeps again.
+  std::lock_guard<std::mutex> lock(mutex_);
   delayed_time_ = std::move(delayed_time);
 }
 }  // namespace base
@@ -38,6 +38,7 @@ class MessagePumpPosix : public MessagePump {
 
  private:
   bool stop_request_;
+  bool work_scheduled_;
   std::condition_variable condition_;
   std::mutex mutex_;
   TimeUnit delayed_time_;
@@ -0,0 +1,102 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef BASE_THREAD_EVENT_COUNT_H
+#define BASE_THREAD_EVENT_COUNT_H
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "base/common.h"
+
+namespace weex {
+namespace base {
+
+// Lets a consumer sleep until a lock-free producer publishes something
+// without the producer taking a lock while nobody sleeps:
+//
+//   consumer:                          producer:
+//     while (!(item = queue.Pop())) {    queue.Push(item);
+//       auto key = event.PrepareWait();  event.Notify();
+//       if ((item = queue.Pop())) {
+//         event.CancelWait();
+//         break;
+//       }
+//       event.Wait(key);
+//     }
+//
+// The high half of state_ counts notifications, the low half the threads
+// between PrepareWait and the end of Wait/CancelWait.
+class EventCount {
+ public:
+  class Key {
+   private:
+    friend class EventCount;
+    explicit Key(uint32_t epoch) : epoch_(epoch) {}
+    uint32_t epoch_;
+  };
+
+  EventCount() : state_(0) {}
+
+  void Notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t prev = state_.fetch_add(kAddEpoch, std::memory_order_acq_rel);
+    if ((prev & kWaiterMask) != 0) {
+      std::lock_guard<std::mutex> locker(mutex_);
+      condition_.notify_all();
+    }
+  }
+
+  Key PrepareWait() {
+    uint64_t prev = state_.fetch_add(kAddWaiter, std::memory_order_seq_cst);
+    return Key(static_cast<uint32_t>(prev >> kEpochShift));
+  }
+
+  void CancelWait() {
+    state_.fetch_sub(kAddWaiter, std::memory_order_seq_cst);
+  }
+
+  void Wait(Key key) {
+    {
+      std::unique_lock<std::mutex> locker(mutex_);
+      while (static_cast<uint32_t>(state_.load(std::memory_order_acquire) >>
+                                   kEpochShift) == key.epoch_) {
+        condition_.wait(locker);
+      }
+    }
+    state_.fetch_sub(kAddWaiter, std::memory_order_seq_cst);
+  }
+
+ private:
+  static const int kEpochShift = 32;
+  static const uint64_t kAddWaiter = 1;
+  static const uint64_t kAddEpoch = static_cast<uint64_t>(1) << kEpochShift;
+  static const uint64_t kWaiterMask = kAddEpoch - 1;
+
+  std::atomic<uint64_t> state_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  DISALLOW_COPY_AND_ASSIGN(EventCount);
+};
+
+}  // namespace base
+}  // namespace weex
+#endif  // BASE_THREAD_EVENT_COUNT_H
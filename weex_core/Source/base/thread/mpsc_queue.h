@@ -0,0 +1,107 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef BASE_THREAD_MPSC_QUEUE_H
+#define BASE_THREAD_MPSC_QUEUE_H
+
+#include <atomic>
+
+#include "base/common.h"
+
+namespace weex {
+namespace base {
+
+// Link embedded in every element of an MpscQueue.
+class MpscNode {
+ public:
+  MpscNode() : mpsc_next_(nullptr) {}
+
+ private:
+  template <typename T>
+  friend class MpscQueue;
+  std::atomic<MpscNode*> mpsc_next_;
+};
+
+// Intrusive unbounded multi-producer single-consumer FIFO (Vyukov). Push is
+// one atomic exchange and never blocks or allocates. Pop must only be called
+// from one thread at a time. T must derive from MpscNode and stays owned by
+// the caller, a node can be pushed again once it has been popped.
+//
+// Pop may report empty while a producer is between its exchange and its
+// link store. That producer's notification comes after the store, so a
+// consumer that parks on an EventCount is woken for the element.
+template <typename T>
+class MpscQueue {
+ public:
+  MpscQueue() : head_(&stub_), tail_(&stub_) {}
+
+  // Returns true if the queue looked empty before the push.
+  bool Push(T* element) {
+    MpscNode* node = element;
+    node->mpsc_next_.store(nullptr, std::memory_order_relaxed);
+    MpscNode* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->mpsc_next_.store(node, std::memory_order_release);
+    return prev == &stub_;
+  }
+
+  T* Pop() {
+    MpscNode* tail = tail_;
+    MpscNode* next = tail->mpsc_next_.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+      if (next == nullptr) return nullptr;
+      tail_ = next;
+      tail = next;
+      next = next->mpsc_next_.load(std::memory_order_acquire);
+    }
+    if (next != nullptr) {
+      tail_ = next;
+      return static_cast<T*>(tail);
+    }
+    if (tail != head_.load(std::memory_order_acquire)) return nullptr;
+    PushStub();
+    next = tail->mpsc_next_.load(std::memory_order_acquire);
+    if (next != nullptr) {
+      tail_ = next;
+      return static_cast<T*>(tail);
+    }
+    return nullptr;
+  }
+
+  // Consumer side only.
+  bool Empty() const {
+    return tail_ == &stub_ &&
+           stub_.mpsc_next_.load(std::memory_order_acquire) == nullptr;
+  }
+
+ private:
+  void PushStub() {
+    stub_.mpsc_next_.store(nullptr, std::memory_order_relaxed);
+    MpscNode* prev = head_.exchange(&stub_, std::memory_order_acq_rel);
+    prev->mpsc_next_.store(&stub_, std::memory_order_release);
+  }
+
+  std::atomic<MpscNode*> head_;
+  MpscNode* tail_;
+  MpscNode stub_;
+  DISALLOW_COPY_AND_ASSIGN(MpscQueue);
+};
+
+}  // namespace base
+}  // namespace weex
+#endif  // BASE_THREAD_MPSC_QUEUE_H
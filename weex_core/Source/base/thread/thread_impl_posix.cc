@@ -46,7 +46,7 @@ ThreadImplPosix::ThreadImplPosix(const ThreadParams& params)
 ThreadImplPosix::~ThreadImplPosix() {}
 
 void ThreadImplPosix::Start() {
-  if (message_loop()->type() == MessageLoop::Type::DEFAULT) {
+  if (message_loop()->type() != MessageLoop::Type::PLATFORM) {
     StartupData params(message_loop());
     int error = pthread_create(&handle_, NULL, ThreadFunc, &params);
     if (!error) {
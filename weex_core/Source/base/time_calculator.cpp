@@ -21,7 +21,7 @@
 namespace weex {
 namespace base {
 void weex::base::TimeCalculator::taskEnd() {
-  if (!turnOn()) {
+  if (!m_enabled_ || !turnOn()) {
     return;
   }
 
@@ -36,7 +36,7 @@ void weex::base::TimeCalculator::taskEnd() {
 }
 void weex::base::TimeCalculator::taskStart() {
 
-  if (!turnOn()) {
+  if (!m_enabled_ || !turnOn()) {
     return;
   }
 
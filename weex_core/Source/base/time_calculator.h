@@ -43,17 +43,28 @@ enum Level {
   LOW,
 };
 
+// Does nothing beyond one flag check when perf logging is off at
+// construction, so it is cheap enough to attach to every task.
 class TimeCalculator {
  public:
-  TimeCalculator(TaskPlatform taskPlatform, std::string name, std::string id, Level level = LOW) :
-      m_task_name_(name),
-      m_instance_id_(id),
-      m_destructor_time_(getCurrentTime()),
-      m_constructor_time_(getCurrentTime()),
-      m_task_end_time_(getCurrentTime()),
-      m_task_start_time_(getCurrentTime()),
-      m_task_id_(genTaskId()),
-      m_relative_task_id_(0) {
+  TimeCalculator(TaskPlatform taskPlatform, const std::string &name, const std::string &id, Level level = LOW) :
+      m_task_id_(0),
+      m_relative_task_id_(0),
+      m_constructor_time_(0),
+      m_destructor_time_(0),
+      m_task_start_time_(0),
+      m_task_end_time_(0),
+      m_enabled_(turnOn()) {
+    if (!m_enabled_) {
+      return;
+    }
+    m_task_name_ = name;
+    m_instance_id_ = id;
+    m_constructor_time_ = getCurrentTime();
+    m_task_start_time_ = m_constructor_time_;
+    m_task_end_time_ = m_constructor_time_;
+    m_destructor_time_ = m_constructor_time_;
+    m_task_id_ = genTaskId();
     if (taskPlatform == TaskPlatform::JSS_ENGINE) {
       m_task_platform_ = "JSEngine";
     } else {
@@ -67,6 +78,9 @@ class TimeCalculator {
   }
 
   ~TimeCalculator() {
+    if (!m_enabled_) {
+      return;
+    }
     if (!m_task_end_flag_) {
       m_task_end_time_ = getCurrentTime();
     }
@@ -96,6 +110,11 @@ class TimeCalculator {
     return weex::base::LogImplement::getLog()->perfMode();
   }
 
+  // Whether perf logging was on when this calculator was created.
+  bool enabled() const {
+    return m_enabled_;
+  }
+
  private:
   std::string m_task_name_;
   std::string m_log_tag_;
@@ -108,6 +127,7 @@ class TimeCalculator {
   long long m_task_start_time_;
   long long m_task_end_time_;
   bool m_task_end_flag_ = false;
+  bool m_enabled_;
   std::string m_task_platform_;
   std::string m_final_info_string_;
   std::string args;
@@ -0,0 +1,84 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef BASE_TRACE_TRACE_EVENT_H
+#define BASE_TRACE_TRACE_EVENT_H
+
+#include "base/common.h"
+#include "base/trace/trace_log.h"
+
+// Records a slice for the rest of the scope, bound to the thread's current
+// flow. category must be a string literal, name and arg are copied.
+#define TRACE_EVENT(category, name) \
+  ::weex::base::ScopedTraceEvent TRACE_EVENT_UID(trace_event_)(category, name)
+#define TRACE_EVENT_WITH_ARG(category, name, arg)                            \
+  ::weex::base::ScopedTraceEvent TRACE_EVENT_UID(trace_event_)(category, name, \
+                                                               arg)
+
+#define TRACE_EVENT_UID(prefix) TRACE_EVENT_CONCAT(prefix, __LINE__)
+#define TRACE_EVENT_CONCAT(a, b) TRACE_EVENT_CONCAT_INNER(a, b)
+#define TRACE_EVENT_CONCAT_INNER(a, b) a##b
+
+namespace weex {
+namespace base {
+
+class ScopedTraceEvent {
+ public:
+  ScopedTraceEvent() : category_(nullptr) {}
+  ScopedTraceEvent(const char* category, const char* name,
+                   const char* arg = nullptr)
+      : category_(nullptr) {
+    if (TraceLog::IsEnabled()) Begin(category, name, arg);
+  }
+  ~ScopedTraceEvent() {
+    if (category_) TraceLog::GetInstance()->AddEvent('E', category_, "");
+  }
+
+  // For names that are costly to build, call after checking IsEnabled.
+  void Begin(const char* category, const char* name,
+             const char* arg = nullptr) {
+    category_ = category;
+    uint64_t flow_id = TraceLog::CurrentFlowId();
+    TraceLog::GetInstance()->AddEvent(
+        'B', category, name, arg, flow_id,
+        flow_id ? TraceLog::kFlowIn | TraceLog::kFlowOut : 0);
+  }
+
+ private:
+  const char* category_;
+  DISALLOW_COPY_AND_ASSIGN(ScopedTraceEvent);
+};
+
+// Makes flow_id the thread's current flow for the scope.
+class ScopedTraceFlow {
+ public:
+  explicit ScopedTraceFlow(uint64_t flow_id)
+      : previous_(TraceLog::CurrentFlowId()) {
+    TraceLog::SetCurrentFlowId(flow_id);
+  }
+  ~ScopedTraceFlow() { TraceLog::SetCurrentFlowId(previous_); }
+
+ private:
+  uint64_t previous_;
+  DISALLOW_COPY_AND_ASSIGN(ScopedTraceFlow);
+};
+
+}  // namespace base
+}  // namespace weex
+#endif  // BASE_TRACE_TRACE_EVENT_H
@@ -0,0 +1,264 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "base/trace/trace_log.h"
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#endif
+
+namespace weex {
+namespace base {
+
+namespace {
+
+thread_local uint64_t g_current_flow_id = 0;
+
+void CopyString(char* dst, size_t size, const char* src) {
+  if (src == nullptr) {
+    dst[0] = '\0';
+    return;
+  }
+  size_t length = strnlen(src, size - 1);
+  memcpy(dst, src, length);
+  dst[length] = '\0';
+}
+
+void AppendEscaped(std::string* out, const char* value) {
+  for (const char* p = value; *p; ++p) {
+    char c = *p;
+    if (c == '"' || c == '\\') {
+      out->push_back('\\');
+      out->push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escaped[8];
+      snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+      out->append(escaped);
+    } else {
+      out->push_back(c);
+    }
+  }
+}
+
+}  // namespace
+
+// Single writer ring. Each slot carries a sequence number, odd while the
+// owner writes it and 2 * (index + 1) once event index is complete, so a
+// reader can tell whether its copy is intact. Events are copied in and out
+// as relaxed atomic words, which keeps the concurrent read well defined.
+class TraceLog::ThreadBuffer {
+ public:
+  ThreadBuffer() : head_(0) {
+#ifdef __linux__
+    tid_ = static_cast<int>(syscall(SYS_gettid));
+    name_[0] = '\0';
+    prctl(PR_GET_NAME, name_, 0, 0, 0);
+    name_[sizeof(name_) - 1] = '\0';
+#else
+    tid_ = static_cast<int>(reinterpret_cast<uintptr_t>(pthread_self()));
+    name_[0] = '\0';
+#endif
+    for (auto& slot : slots_) slot.sequence.store(0, std::memory_order_relaxed);
+  }
+
+  void Write(const TraceEvent& event) {
+    uint64_t index = head_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[index % kEventsPerThread];
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    uint64_t words[kWords];
+    memcpy(words, &event, sizeof(event));
+    for (size_t i = 0; i < kWords; ++i) {
+      slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+    head_.store(index + 1, std::memory_order_release);
+  }
+
+  // Appends the intact events, oldest first.
+  void Collect(std::vector<TraceEvent>* events) {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t begin = head > kEventsPerThread ? head - kEventsPerThread : 0;
+    for (uint64_t index = begin; index < head; ++index) {
+      Slot& slot = slots_[index % kEventsPerThread];
+      uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+      if (sequence != 2 * index + 2) continue;
+      uint64_t words[kWords];
+      for (size_t i = 0; i < kWords; ++i) {
+        words[i] = slot.words[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+      TraceEvent event;
+      memcpy(&event, words, sizeof(event));
+      events->push_back(event);
+    }
+  }
+
+  void Clear() { head_.store(0, std::memory_order_release); }
+
+  int tid() const { return tid_; }
+  const char* name() const { return name_; }
+
+ private:
+  static const size_t kWords = (sizeof(TraceEvent) + 7) / 8;
+
+  struct Slot {
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> words[kWords];
+  };
+
+  std::atomic<uint64_t> head_;
+  int tid_;
+  char name_[16];
+  Slot slots_[kEventsPerThread];
+  DISALLOW_COPY_AND_ASSIGN(ThreadBuffer);
+};
+
+std::atomic<bool> TraceLog::enabled_(false);
+
+TraceLog* TraceLog::GetInstance() {
+  // Threads may still record while the process exits, never destroyed.
+  static TraceLog* instance = new TraceLog();
+  return instance;
+}
+
+TraceLog::TraceLog() {}
+
+TraceLog::~TraceLog() {}
+
+uint64_t TraceLog::Now() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + now.tv_nsec;
+}
+
+uint64_t TraceLog::NewFlowId() {
+  static std::atomic<uint32_t> next_id(1);
+  return static_cast<uint64_t>(getpid()) << 32 |
+         next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t TraceLog::CurrentFlowId() { return g_current_flow_id; }
+
+void TraceLog::SetCurrentFlowId(uint64_t flow_id) {
+  g_current_flow_id = flow_id;
+}
+
+void TraceLog::SetEnabled(bool enabled) {
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+TraceLog::ThreadBuffer* TraceLog::CurrentBuffer() {
+  static thread_local ThreadBuffer* buffer = nullptr;
+  if (buffer == nullptr) {
+    buffer = new ThreadBuffer();
+    std::lock_guard<std::mutex> locker(mutex_);
+    buffers_.emplace_back(buffer);
+  }
+  return buffer;
+}
+
+void TraceLog::AddEvent(char phase, const char* category, const char* name,
+                        const char* arg, uint64_t flow_id, int flow_flags) {
+  TraceEvent event;
+  event.category = category;
+  event.timestamp = Now();
+  event.flow_id = flow_id;
+  event.phase = phase;
+  event.flow_flags = static_cast<uint8_t>(flow_flags);
+  CopyString(event.name, TraceEvent::kNameSize, name);
+  CopyString(event.arg, TraceEvent::kArgSize, arg);
+  CurrentBuffer()->Write(event);
+}
+
+void TraceLog::ExportJson(std::string* json) {
+  int pid = getpid();
+  char buffer[160];
+  std::vector<TraceEvent> events;
+  json->append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+  bool first = true;
+  std::lock_guard<std::mutex> locker(mutex_);
+  for (auto& thread : buffers_) {
+    snprintf(buffer, sizeof(buffer),
+             "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":%d,"
+             "\"tid\":%d,\"args\":{\"name\":\"",
+             first ? "" : ",", pid, thread->tid());
+    json->append(buffer);
+    AppendEscaped(json, thread->name());
+    json->append("\"}}");
+    first = false;
+
+    events.clear();
+    thread->Collect(&events);
+    for (const TraceEvent& event : events) {
+      snprintf(buffer, sizeof(buffer),
+               ",{\"ph\":\"%c\",\"pid\":%d,\"tid\":%d,\"ts\":%" PRIu64
+               ".%03u,\"cat\":\"",
+               event.phase, pid, thread->tid(), event.timestamp / 1000,
+               static_cast<unsigned>(event.timestamp % 1000));
+      json->append(buffer);
+      AppendEscaped(json, event.category);
+      json->append("\",\"name\":\"");
+      AppendEscaped(json, event.name);
+      json->push_back('"');
+      if (event.flow_id != 0) {
+        snprintf(buffer, sizeof(buffer),
+                 ",\"bind_id\":\"0x%" PRIx64 "\",\"flow_in\":%s,"
+                 "\"flow_out\":%s",
+                 event.flow_id,
+                 event.flow_flags & kFlowIn ? "true" : "false",
+                 event.flow_flags & kFlowOut ? "true" : "false");
+        json->append(buffer);
+      }
+      if (event.phase == 'i') json->append(",\"s\":\"t\"");
+      if (event.arg[0] != '\0') {
+        json->append(",\"args\":{\"arg\":\"");
+        AppendEscaped(json, event.arg);
+        json->append("\"}");
+      }
+      json->push_back('}');
+    }
+  }
+  json->append("]}");
+}
+
+bool TraceLog::WriteJson(const char* path) {
+  std::string json;
+  ExportJson(&json);
+  FILE* file = fopen(path, "w");
+  if (file == nullptr) return false;
+  bool ok = fwrite(json.data(), 1, json.size(), file) == json.size();
+  return fclose(file) == 0 && ok;
+}
+
+void TraceLog::Clear() {
+  std::lock_guard<std::mutex> locker(mutex_);
+  for (auto& thread : buffers_) thread->Clear();
+}
+
+}  // namespace base
+}  // namespace weex
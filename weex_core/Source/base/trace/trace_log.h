@@ -0,0 +1,113 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef BASE_TRACE_TRACE_LOG_H
+#define BASE_TRACE_TRACE_LOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "base/common.h"
+
+namespace weex {
+namespace base {
+
+// One recorded event. Names and args are copied so callers may pass
+// temporaries; the category must be a string literal.
+struct TraceEvent {
+  static const size_t kNameSize = 48;
+  static const size_t kArgSize = 32;
+
+  const char* category;
+  // CLOCK_MONOTONIC in nanoseconds, comparable between processes.
+  uint64_t timestamp;
+  uint64_t flow_id;
+  char phase;
+  uint8_t flow_flags;
+  char name[kNameSize];
+  char arg[kArgSize];
+};
+
+// Process wide trace recorder shared by the JS thread, the core threads and
+// the IPC layer. Every thread writes into its own ring of the last
+// kEventsPerThread events without locking, so recording costs a clock read
+// and a copy, and a single relaxed load while tracing is off.
+//
+// Work that hops threads or processes is correlated with flow ids: a thread
+// carries a current flow id (see ScopedTraceFlow), slices record it, and
+// MessageLoop, WeexTaskQueue, BackToWeexCoreQueue and the IPC trailer pass
+// it on to the work they hand over. The export is Chrome trace event JSON
+// with v2 flows (bind_id), which chrome://tracing and Perfetto draw as
+// arrows; files of the two processes can be loaded together.
+class TraceLog {
+ public:
+  enum FlowFlags {
+    kFlowIn = 1,
+    kFlowOut = 2,
+  };
+
+  static const size_t kEventsPerThread = 1024;
+
+  static TraceLog* GetInstance();
+
+  static bool IsEnabled() { return enabled_.load(std::memory_order_relaxed); }
+  static uint64_t Now();
+
+  // Unique across processes, the pid is in the high half.
+  static uint64_t NewFlowId();
+  static uint64_t CurrentFlowId();
+  static void SetCurrentFlowId(uint64_t flow_id);
+
+  void SetEnabled(bool enabled);
+
+  void AddEvent(char phase, const char* category, const char* name,
+                const char* arg = nullptr, uint64_t flow_id = 0,
+                int flow_flags = 0);
+
+  // Reads the rings while they are written; a slot overwritten during the
+  // copy is dropped, not torn.
+  void ExportJson(std::string* json);
+  bool WriteJson(const char* path);
+
+  // Only while disabled.
+  void Clear();
+
+ private:
+  class ThreadBuffer;
+
+  TraceLog();
+  ~TraceLog();
+
+  ThreadBuffer* CurrentBuffer();
+
+  static std::atomic<bool> enabled_;
+
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+  DISALLOW_COPY_AND_ASSIGN(TraceLog);
+};
+
+}  // namespace base
+}  // namespace weex
+#endif  // BASE_TRACE_TRACE_LOG_H
@@ -181,7 +181,7 @@ void EagleRenderObject::RemoveEvent(const std::string& event) {
   render_object_impl_->RemoveEvent(event);
 }
 
-std::set<std::string>* EagleRenderObject::events() {
+SmallStringSet* EagleRenderObject::events() {
   return render_object_impl_->events();
 }
 
@@ -38,6 +38,7 @@ enum class EagleModeReturn {
 };
 
 class RenderObject;
+class SmallStringSet;
 
 class EagleRenderObject {
  public:
@@ -52,7 +53,7 @@ class EagleRenderObject {
   void AddEvent(const std::string& event);
   void RemoveEvent(const std::string& event);
   void set_is_richtext_child(const bool is_richtext_child);
-  std::set<std::string>* events();
+  SmallStringSet* events();
 
   void set_page_id(const std::string& page_id);
   void ApplyDefaultStyle();
@@ -90,6 +90,28 @@ void CoreSideInPlatform::SetStyleHeight(const std::string &instance_id,
   static_cast<RenderPage*>(page)->set_is_dirty(true);
 }
 
+void CoreSideInPlatform::SetScrollOffset(const std::string &instance_id,
+                                         const std::string &render_ref,
+                                         float offset) {
+  RenderPageBase *page = RenderManager::GetInstance()->GetPage(instance_id);
+  if (page == nullptr) return;
+  if (!page->is_platform_page()) return;
+
+  RenderObject *render = static_cast<RenderPage*>(page)->GetRenderObject(render_ref);
+  if (render == nullptr) return;
+
+  RenderCreator *creator = RenderCreator::GetInstance();
+  if (!creator->IsAffineType(render->type(), kRenderList) &&
+      !creator->IsAffineType(render->type(), kRenderWaterfall) &&
+      render->type() != kRenderRecycleList) {
+    return;
+  }
+
+  if (static_cast<RenderList*>(render)->SetScrollOffset(offset)) {
+    static_cast<RenderPage*>(page)->set_is_dirty(true);
+  }
+}
+
 void CoreSideInPlatform::SetMargin(const std::string &instance_id,
                                    const std::string &render_ref, int edge,
                                    float value) {
@@ -263,6 +285,16 @@ std::vector<int64_t> CoreSideInPlatform::GetRenderFinishTime(
   }
 }
 
+std::vector<int64_t> CoreSideInPlatform::GetPageMemoryStats(
+    const std::string &instance_id) {
+  RenderPageBase *page = RenderManager::GetInstance()->GetPage(instance_id);
+  if (page == nullptr) {
+    return std::vector<int64_t>();
+  } else {
+    return page->GetMemoryStats();
+  }
+}
+
 void CoreSideInPlatform::SetRenderContainerWrapContent(
     const std::string &instance_id, bool wrap) {
   RenderPageBase *page = RenderManager::GetInstance()->GetPage(instance_id);
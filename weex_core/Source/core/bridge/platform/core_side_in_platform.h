@@ -45,6 +45,8 @@ class CoreSideInPlatform : public PlatformBridge::CoreSide {
                    float value) override;
   void MarkDirty(const std::string &instance_id,
                  const std::string &render_ref) override;
+  void SetScrollOffset(const std::string &instance_id,
+                       const std::string &render_ref, float offset) override;
 
   virtual void SetPageRenderType(const std::string &pageId, const std::string &renderType)override;
   virtual void RemovePageRenderType(const std::string &pageId) override;
@@ -61,6 +63,8 @@ class CoreSideInPlatform : public PlatformBridge::CoreSide {
       const std::string &instance_id) override;
   std::vector<int64_t> GetRenderFinishTime(
       const std::string &instance_id) override;
+  std::vector<int64_t> GetPageMemoryStats(
+      const std::string &instance_id) override;
   void SetRenderContainerWrapContent(const std::string &instance_id,
                                      bool wrap) override;
   void BindMeasurementToRenderObject(long ptr) override;
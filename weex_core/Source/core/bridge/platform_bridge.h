@@ -26,6 +26,7 @@
 #include <vector>
 #include "base/common.h"
 #include "base/closure.h"
+#include "core/common/small_string_map.h"
 #include "include/WeexApiHeader.h"
 
 namespace WeexCore {
@@ -62,6 +63,9 @@ class PlatformBridge {
                              float value) = 0;
     virtual void MarkDirty(const std::string& instance_id,
                            const std::string& render_ref) = 0;
+    // Scroll offset of a list, used by lists that lay out cells in a window.
+    virtual void SetScrollOffset(const std::string& instance_id,
+                                 const std::string& render_ref, float offset) {}
     virtual void SetViewPortWidth(const std::string& instance_id,
                                   float width) = 0;
                                   
@@ -79,6 +83,12 @@ class PlatformBridge {
         const std::string& instance_id) = 0;
     virtual std::vector<int64_t> GetRenderFinishTime(
         const std::string& instance_id) = 0;
+    // Native memory of a page, see RenderMemoryStats::ToVector. Empty if the
+    // page is unknown.
+    virtual std::vector<int64_t> GetPageMemoryStats(
+        const std::string& instance_id) {
+      return std::vector<int64_t>();
+    }
     virtual bool RelayoutUsingRawCssStyles(const std::string& instance_id) = 0; // relayout whole page using raw css styles
     virtual void SetRenderContainerWrapContent(const std::string& instance_id,
                                                bool wrap) = 0;
@@ -208,18 +218,18 @@ class PlatformBridge {
                             const char* event) = 0;
     virtual int CreateBody(const char* pageId, const char* componentType,
                            const char* ref,
-                           std::map<std::string, std::string>* styles,
-                           std::map<std::string, std::string>* attributes,
-                           std::set<std::string>* events,
+                           SmallStringMap* styles,
+                           SmallStringMap* attributes,
+                           SmallStringSet* events,
                            const WXCoreMargin& margins,
                            const WXCorePadding& paddings,
                            const WXCoreBorderWidth& borders) = 0;
 
     virtual int AddElement(const char* pageId, const char* componentType,
                            const char* ref, int& index, const char* parentRef,
-                           std::map<std::string, std::string>* styles,
-                           std::map<std::string, std::string>* attributes,
-                           std::set<std::string>* events,
+                           SmallStringMap* styles,
+                           SmallStringMap* attributes,
+                           SmallStringSet* events,
                            const WXCoreMargin& margins,
                            const WXCorePadding& paddings,
                            const WXCoreBorderWidth& borders,
@@ -227,8 +237,8 @@ class PlatformBridge {
 
       virtual int AddChildToRichtext(const char* pageId, const char *nodeType, const char* ref,
                                        const char* parentRef, const char* richtextRef,
-                                       std::map<std::string, std::string> *styles,
-                                       std::map<std::string, std::string> *attributes) = 0;
+                                       SmallStringMap *styles,
+                                       SmallStringMap *attributes) = 0;
 
     virtual int Layout(const char* page_id, const char* ref, float top,
                        float bottom, float left, float right, float height,
@@ -0,0 +1,66 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef CORE_COMMON_HASH_UTIL_H_
+#define CORE_COMMON_HASH_UTIL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace WeexCore {
+
+constexpr uint64_t kHashSeed = 14695981039346656037ULL;
+
+// FNV-1a over 64-bit words rather than bytes, which is several times faster
+// for the struct-sized inputs it is used on. The result depends on the byte
+// order of the machine, so use HashBytesStable for keys that are written
+// out. Chain calls by passing the previous result as |hash|.
+inline uint64_t HashBytes(const void *data, size_t length,
+                          uint64_t hash = kHashSeed) {
+  const uint64_t prime = 1099511628211ULL;
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  for (; length >= sizeof(uint64_t); length -= sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, bytes, sizeof(word));
+    hash = (hash ^ word) * prime;
+    bytes += sizeof(uint64_t);
+  }
+  for (; length > 0; length--) {
+    hash = (hash ^ *bytes++) * prime;
+  }
+  return hash;
+}
+
+// Plain FNV-1a over bytes: the same bytes give the same hash in every process
+// and on every machine, so it can key data kept on disk. Keeping the hashed
+// bytes themselves stable, e.g. the layout of hashed structs, is up to the
+// caller.
+inline uint64_t HashBytesStable(const void *data, size_t length,
+                                uint64_t hash = kHashSeed) {
+  const uint64_t prime = 1099511628211ULL;
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  for (; length > 0; length--) {
+    hash = (hash ^ *bytes++) * prime;
+  }
+  return hash;
+}
+
+}  // namespace WeexCore
+
+#endif  // CORE_COMMON_HASH_UTIL_H_
@@ -0,0 +1,342 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef CORE_COMMON_SMALL_STRING_MAP_H_
+#define CORE_COMMON_SMALL_STRING_MAP_H_
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <string>
+#include <utility>
+
+#include "core/common/small_vector.h"
+#include "core/css/constants_name.h"
+
+namespace WeexCore {
+
+// Style, attribute and event names mostly come from a small vocabulary. Its
+// names are kept once per process and shared by every container. Any other
+// name is copied into the entry that holds it, so names made up by pages
+// are freed with their nodes instead of piling up in a process-wide pool.
+// The vocabulary is the names listed in core/css/constants_name.h.
+inline const std::pair<const std::string *, const std::string *> &
+KnownNameRange() {
+  static const std::pair<const std::string *, const std::string *> range = [] {
+    static const char *const kNames[] = {
+#define WEEX_CORE_CONSTANT_NAME(identifier, name) name,
+#define WEEX_CORE_PLATFORM_NAME(name) name,
+        WEEX_CORE_CONSTANT_NAMES(WEEX_CORE_CONSTANT_NAME)
+        WEEX_CORE_PLATFORM_NAMES(WEEX_CORE_PLATFORM_NAME)
+#undef WEEX_CORE_PLATFORM_NAME
+#undef WEEX_CORE_CONSTANT_NAME
+    };
+    const size_t count = sizeof(kNames) / sizeof(kNames[0]);
+    std::string *names = new std::string[count];
+    for (size_t i = 0; i < count; ++i) names[i] = kNames[i];
+    std::sort(names, names + count);
+    return std::pair<const std::string *, const std::string *>(
+        names, std::unique(names, names + count));
+  }();
+  return range;
+}
+
+// The shared copy of |name|, nullptr if it is not in the vocabulary.
+inline const std::string *FindKnownName(const std::string &name) {
+  const auto &range = KnownNameRange();
+  const std::string *it = std::lower_bound(range.first, range.second, name);
+  return it != range.second && *it == name ? it : nullptr;
+}
+
+inline bool IsKnownName(const std::string *name) {
+  const auto &range = KnownNameRange();
+  std::less<const std::string *> less;
+  return !less(name, range.first) && less(name, range.second);
+}
+
+// |name| as an entry holds it: the shared copy, or a new one for the entry
+// to give back with ReleaseName.
+inline const std::string &AcquireName(const std::string &name) {
+  const std::string *known = FindKnownName(name);
+  return known != nullptr ? *known : *new std::string(name);
+}
+
+// AcquireName for a name another entry holds, without the lookup.
+inline const std::string &CopyName(const std::string &name) {
+  return IsKnownName(&name) ? name : *new std::string(name);
+}
+
+inline void ReleaseName(const std::string &name) {
+  if (!IsKnownName(&name)) delete &name;
+}
+
+// Heap bytes of a held name.
+inline size_t NameBytes(const std::string &name) {
+  return IsKnownName(&name) ? 0 : sizeof(std::string) + name.size();
+}
+
+// Flat map from names to string values, sorted by key so iteration order
+// matches std::map. The first few entries live inline, the rest in a single
+// heap block, instead of one heap node per entry.
+class SmallStringMap {
+ public:
+  // A key outside the vocabulary is owned by its entry. Copies copy it, but
+  // SmallVector relocates entries when it grows or shifts them, and the
+  // relocated entry takes the key over instead.
+  struct value_type {
+    value_type(const std::string &key, const std::string &value)
+        : first(AcquireName(key)), second(value) {}
+    value_type(const std::string &key, std::string &&value)
+        : first(AcquireName(key)), second(std::move(value)) {}
+    value_type(const value_type &other)
+        : first(CopyName(other.first)), second(other.second) {}
+    value_type(value_type &&other)
+        : first(CopyName(other.first)), second(std::move(other.second)) {}
+    ~value_type() { ReleaseName(first); }
+
+    // Moves |from| into the raw storage at |to| and ends |from|.
+    static void Relocate(value_type *to, value_type *from) {
+      new (to) value_type(from->first, std::move(from->second), Adopt());
+      using std::string;
+      from->second.~string();
+    }
+
+    const std::string &first;
+    std::string second;
+
+   private:
+    struct Adopt {};
+    value_type(const std::string &held, std::string &&value, Adopt)
+        : first(held), second(std::move(value)) {}
+  };
+
+  typedef value_type *iterator;
+  typedef const value_type *const_iterator;
+
+  inline iterator begin() { return entries_.begin(); }
+  inline iterator end() { return entries_.end(); }
+  inline const_iterator begin() const { return entries_.begin(); }
+  inline const_iterator end() const { return entries_.end(); }
+
+  inline size_t size() const { return entries_.size(); }
+  inline bool empty() const { return entries_.empty(); }
+
+  iterator find(const std::string &key) {
+    iterator it = LowerBound(key);
+    return it != end() && it->first == key ? it : end();
+  }
+
+  const_iterator find(const std::string &key) const {
+    return const_cast<SmallStringMap *>(this)->find(key);
+  }
+
+  inline size_t count(const std::string &key) const {
+    return find(key) != end() ? 1 : 0;
+  }
+
+  // Like std::map::insert, an existing value is left untouched.
+  std::pair<iterator, bool> insert(
+      const std::pair<std::string, std::string> &entry) {
+    return Insert(entry.first, entry.second);
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) Insert(first->first, first->second);
+  }
+
+  void InsertOrAssign(const std::string &key, const std::string &value) {
+    iterator it = LowerBound(key);
+    if (it != end() && it->first == key) {
+      it->second = value;
+    } else {
+      entries_.emplace(it, key, value);
+    }
+  }
+
+  std::string &operator[](const std::string &key) {
+    iterator it = LowerBound(key);
+    if (it == end() || it->first != key) {
+      it = entries_.emplace(it, key, std::string());
+    }
+    return it->second;
+  }
+
+  size_t erase(const std::string &key) {
+    iterator it = find(key);
+    if (it == end()) return 0;
+    entries_.erase(it);
+    return 1;
+  }
+
+  inline void clear() { entries_.clear(); }
+
+  // Bytes owned by the map, its values and the keys it holds a copy of.
+  size_t ByteSize() const {
+    size_t bytes = sizeof(*this);
+    if (!entries_.is_inline()) bytes += entries_.capacity() * sizeof(value_type);
+    for (const value_type &entry : entries_) {
+      bytes += NameBytes(entry.first) + entry.second.size();
+    }
+    return bytes;
+  }
+
+ private:
+  static constexpr size_t kInlineCapacity = 3;
+
+  iterator LowerBound(const std::string &key) {
+    return std::lower_bound(
+        begin(), end(), key,
+        [](const value_type &entry, const std::string &k) {
+          return entry.first < k;
+        });
+  }
+
+  std::pair<iterator, bool> Insert(const std::string &key,
+                                   const std::string &value) {
+    iterator it = LowerBound(key);
+    if (it != end() && it->first == key) return std::make_pair(it, false);
+    return std::make_pair(entries_.emplace(it, key, value), true);
+  }
+
+  SmallVector<value_type, kInlineCapacity> entries_;
+};
+
+// Flat sorted set of names, used for the events of a node.
+class SmallStringSet {
+ private:
+  // Held like the keys of SmallStringMap.
+  struct Entry {
+    explicit Entry(const std::string &name) : value(AcquireName(name)) {}
+    Entry(const Entry &other) : value(CopyName(other.value)) {}
+    ~Entry() { ReleaseName(value); }
+
+    static void Relocate(Entry *to, Entry *from) {
+      new (to) Entry(from->value, Adopt());
+    }
+
+    const std::string &value;
+
+   private:
+    struct Adopt {};
+    Entry(const std::string &held, Adopt) : value(held) {}
+  };
+
+ public:
+  class const_iterator {
+   public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef std::string value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const std::string *pointer;
+    typedef const std::string &reference;
+
+    explicit const_iterator(const Entry *it) : it_(it) {}
+
+    inline reference operator*() const { return it_->value; }
+    inline pointer operator->() const { return &it_->value; }
+    inline const_iterator &operator++() {
+      ++it_;
+      return *this;
+    }
+    inline const_iterator operator++(int) {
+      const_iterator old = *this;
+      ++it_;
+      return old;
+    }
+    inline bool operator==(const const_iterator &other) const {
+      return it_ == other.it_;
+    }
+    inline bool operator!=(const const_iterator &other) const {
+      return it_ != other.it_;
+    }
+
+   private:
+    friend class SmallStringSet;
+    const Entry *it_;
+  };
+
+  typedef const_iterator iterator;
+
+  inline const_iterator begin() const {
+    return const_iterator(entries_.begin());
+  }
+  inline const_iterator end() const { return const_iterator(entries_.end()); }
+
+  inline size_t size() const { return entries_.size(); }
+  inline bool empty() const { return entries_.empty(); }
+
+  const_iterator find(const std::string &value) const {
+    const Entry *it = LowerBound(value);
+    return const_iterator(it != entries_.end() && it->value == value
+                              ? it
+                              : entries_.end());
+  }
+
+  inline size_t count(const std::string &value) const {
+    return find(value) != end() ? 1 : 0;
+  }
+
+  std::pair<const_iterator, bool> insert(const std::string &value) {
+    const Entry *it = LowerBound(value);
+    if (it != entries_.end() && it->value == value) {
+      return std::make_pair(const_iterator(it), false);
+    }
+    return std::make_pair(const_iterator(entries_.emplace(it, value)), true);
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) insert(*first);
+  }
+
+  size_t erase(const std::string &value) {
+    const_iterator it = find(value);
+    if (it == end()) return 0;
+    entries_.erase(it.it_);
+    return 1;
+  }
+
+  inline void clear() { entries_.clear(); }
+
+  // Bytes owned by the set and the names it holds a copy of.
+  size_t ByteSize() const {
+    size_t bytes = sizeof(*this);
+    if (!entries_.is_inline()) bytes += entries_.capacity() * sizeof(Entry);
+    for (const Entry &entry : entries_) bytes += NameBytes(entry.value);
+    return bytes;
+  }
+
+ private:
+  static constexpr size_t kInlineCapacity = 2;
+
+  const Entry *LowerBound(const std::string &value) const {
+    return std::lower_bound(
+        entries_.begin(), entries_.end(), value,
+        [](const Entry &entry, const std::string &v) {
+          return entry.value < v;
+        });
+  }
+
+  SmallVector<Entry, kInlineCapacity> entries_;
+};
+
+}  // namespace WeexCore
+
+#endif  // CORE_COMMON_SMALL_STRING_MAP_H_
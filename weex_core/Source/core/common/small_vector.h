@@ -0,0 +1,175 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef CORE_COMMON_SMALL_VECTOR_H_
+#define CORE_COMMON_SMALL_VECTOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace WeexCore {
+
+// Contiguous array keeping up to N elements inline before moving to a single
+// heap block. Elements are only ever move/copy constructed and destroyed,
+// never assigned, so T may hold reference members. Moving an element to a
+// new slot goes through a static T::Relocate(T *to, T *from) when T has one,
+// and is a move followed by a destroy otherwise.
+template <typename T, size_t N>
+class SmallVector {
+ public:
+  static_assert(N > 0, "SmallVector needs inline room for one element");
+
+  SmallVector() : data_(inline_data()), size_(0), capacity_(N) {}
+
+  SmallVector(const SmallVector &other) : SmallVector() {
+    reserve(other.size_);
+    for (const T &value : other) new (data_ + size_++) T(value);
+  }
+
+  SmallVector(SmallVector &&other) : SmallVector() { Steal(other); }
+
+  SmallVector &operator=(const SmallVector &other) {
+    if (this != &other) {
+      clear();
+      reserve(other.size_);
+      for (const T &value : other) new (data_ + size_++) T(value);
+    }
+    return *this;
+  }
+
+  SmallVector &operator=(SmallVector &&other) {
+    if (this != &other) {
+      clear();
+      Steal(other);
+    }
+    return *this;
+  }
+
+  ~SmallVector() {
+    clear();
+    if (!is_inline()) free(data_);
+  }
+
+  inline T *begin() { return data_; }
+  inline T *end() { return data_ + size_; }
+  inline const T *begin() const { return data_; }
+  inline const T *end() const { return data_ + size_; }
+
+  inline size_t size() const { return size_; }
+  inline bool empty() const { return size_ == 0; }
+  inline size_t capacity() const { return capacity_; }
+  inline bool is_inline() const { return data_ == inline_data(); }
+
+  inline T &operator[](size_t index) { return data_[index]; }
+  inline const T &operator[](size_t index) const { return data_[index]; }
+
+  void reserve(size_t capacity) {
+    if (capacity <= capacity_) return;
+    T *data = static_cast<T *>(malloc(capacity * sizeof(T)));
+    if (data == nullptr) throw std::bad_alloc();
+    for (size_t i = 0; i < size_; ++i) Relocate(data + i, data_ + i, 0);
+    if (!is_inline()) free(data_);
+    data_ = data;
+    capacity_ = static_cast<uint32_t>(capacity);
+  }
+
+  // Inserts before |pos| and returns the new element.
+  template <typename... Args>
+  T *emplace(const T *pos, Args &&... args) {
+    size_t index = pos - data_;
+    // Built before growing, as |args| may refer to elements.
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type slot;
+    T *value = new (&slot) T(std::forward<Args>(args)...);
+    if (size_ == capacity_) {
+      try {
+        reserve(capacity_ + (capacity_ >> 1) + 1);
+      } catch (...) {
+        value->~T();
+        throw;
+      }
+    }
+    for (size_t i = size_; i > index; --i)
+      Relocate(data_ + i, data_ + i - 1, 0);
+    Relocate(data_ + index, value, 0);
+    ++size_;
+    return data_ + index;
+  }
+
+  T *erase(const T *pos) {
+    size_t index = pos - data_;
+    data_[index].~T();
+    for (size_t i = index + 1; i < size_; ++i)
+      Relocate(data_ + i - 1, data_ + i, 0);
+    --size_;
+    return data_ + index;
+  }
+
+  void clear() {
+    for (size_t i = 0; i < size_; ++i) data_[i].~T();
+    size_ = 0;
+  }
+
+ private:
+  inline T *inline_data() { return reinterpret_cast<T *>(&inline_); }
+  inline const T *inline_data() const {
+    return reinterpret_cast<const T *>(&inline_);
+  }
+
+  // The int overload is picked when T::Relocate exists.
+  template <typename U>
+  static auto Relocate(U *to, U *from, int)
+      -> decltype(U::Relocate(to, from)) {
+    U::Relocate(to, from);
+  }
+
+  template <typename U>
+  static void Relocate(U *to, U *from, long) {
+    new (to) U(std::move(*from));
+    from->~U();
+  }
+
+  void Steal(SmallVector &other) {
+    if (other.is_inline()) {
+      for (size_t i = 0; i < other.size_; ++i)
+        Relocate(data_ + i, other.data_ + i, 0);
+      size_ = other.size_;
+      other.size_ = 0;
+    } else {
+      if (!is_inline()) free(data_);
+      data_ = other.data_;
+      size_ = other.size_;
+      capacity_ = other.capacity_;
+      other.data_ = other.inline_data();
+      other.size_ = 0;
+      other.capacity_ = N;
+    }
+  }
+
+  T *data_;
+  uint32_t size_;
+  uint32_t capacity_;
+  typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type inline_;
+};
+
+}  // namespace WeexCore
+
+#endif  // CORE_COMMON_SMALL_VECTOR_H_
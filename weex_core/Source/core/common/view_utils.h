@@ -19,8 +19,11 @@
 #ifndef WEEX_PROJECT_VIEWUTILS_H
 #define WEEX_PROJECT_VIEWUTILS_H
 
+#include <math.h>
 #include <cmath>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <sstream>
 
 #include "core/config/core_environment.h"
@@ -43,6 +46,45 @@ namespace WeexCore {
     return stm.str();
   }
 
+  // Writes |n| right-aligned into the end of |buf| and returns the first char.
+  inline char *FormatInteger(long long n, char *end) {
+    unsigned long long u = n < 0 ? 0ull - static_cast<unsigned long long>(n)
+                                 : static_cast<unsigned long long>(n);
+    char *p = end;
+    do {
+      *--p = static_cast<char>('0' + u % 10);
+      u /= 10;
+    } while (u != 0);
+    if (n < 0) {
+      *--p = '-';
+    }
+    return p;
+  }
+
+  inline std::string to_string(int n) {
+    char buf[24];
+    char *begin = FormatInteger(n, buf + sizeof(buf));
+    return std::string(begin, buf + sizeof(buf) - begin);
+  }
+
+  // Same text as streaming the value into a default std::ostringstream
+  // ("%g", six significant digits). Layout results are rounded to whole
+  // pixels most of the time, so integral values skip printf altogether.
+  inline std::string to_string(double n) {
+    char buf[32];
+    if (n > -1e6 && n < 1e6 && n == static_cast<long long>(n) &&
+        !(n == 0 && std::signbit(n))) {
+      char *begin = FormatInteger(static_cast<long long>(n), buf + sizeof(buf));
+      return std::string(begin, buf + sizeof(buf) - begin);
+    }
+    int len = snprintf(buf, sizeof(buf), "%g", n);
+    return std::string(buf, len > 0 ? len : 0);
+  }
+
+  inline std::string to_string(float n) {
+    return to_string(static_cast<double>(n));
+  }
+
   inline std::string &Trim(std::string &s) {
     if (s.empty()) {
       return s;
@@ -108,35 +150,165 @@ namespace WeexCore {
            src.compare(src.size() - suffix.size(), suffix.size(), suffix) == 0;
   }
 
+  enum CSSLengthType {
+    kCSSLengthInvalid,
+    kCSSLengthNumber,
+    kCSSLengthPx,
+    kCSSLengthWx,
+    kCSSLengthAuto,
+    kCSSLengthNone,
+    kCSSLengthUndefined,
+  };
+
+  struct CSSLength {
+    CSSLengthType type;
+    float value;
+  };
+
+  inline bool IsCSSSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' ||
+           c == '\v';
+  }
+
+  inline bool MatchCSSKeyword(const char *begin, const char *end,
+                              const char *keyword, size_t keyword_len) {
+    return static_cast<size_t>(end - begin) == keyword_len &&
+           memcmp(begin, keyword, keyword_len) == 0;
+  }
+
+  // Parses "[sign]digits[.digits][e[sign]digits]" followed by an optional
+  // "px"/"wx" unit, or one of the keywords auto/none/undefined, in a single
+  // pass without touching the heap. Surrounding whitespace is ignored; any
+  // other trailing character makes the result kCSSLengthInvalid.
+  inline CSSLength ParseCSSLength(const char *src, size_t len) {
+    CSSLength result = {kCSSLengthInvalid, NAN};
+    const char *p = src;
+    const char *end = src + len;
+    while (p < end && IsCSSSpace(*p)) {
+      ++p;
+    }
+    while (end > p && IsCSSSpace(end[-1])) {
+      --end;
+    }
+    if (p == end) {
+      return result;
+    }
+
+    if (MatchCSSKeyword(p, end, AUTO_UNIT, sizeof(AUTO_UNIT) - 1)) {
+      result.type = kCSSLengthAuto;
+      return result;
+    }
+    if (MatchCSSKeyword(p, end, NONE, sizeof(NONE) - 1)) {
+      result.type = kCSSLengthNone;
+      return result;
+    }
+    if (MatchCSSKeyword(p, end, UNDEFINE, sizeof(UNDEFINE) - 1)) {
+      result.type = kCSSLengthUndefined;
+      return result;
+    }
+
+    bool negative = false;
+    if (*p == '-' || *p == '+') {
+      negative = *p == '-';
+      ++p;
+    }
+
+    // Up to 19 significant digits fit the mantissa; further digits only
+    // move the decimal exponent.
+    unsigned long long mantissa = 0;
+    int exponent = 0;
+    int digits = 0;
+    int significant = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p, ++digits) {
+      if (significant < 19) {
+        mantissa = mantissa * 10 + (*p - '0');
+        if (mantissa != 0) {
+          ++significant;
+        }
+      } else {
+        ++exponent;
+      }
+    }
+    if (p < end && *p == '.') {
+      for (++p; p < end && *p >= '0' && *p <= '9'; ++p, ++digits) {
+        if (significant < 19) {
+          mantissa = mantissa * 10 + (*p - '0');
+          if (mantissa != 0) {
+            ++significant;
+          }
+          --exponent;
+        }
+      }
+    }
+    if (digits == 0) {
+      return result;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+      const char *q = p + 1;
+      bool negative_exp = false;
+      if (q < end && (*q == '-' || *q == '+')) {
+        negative_exp = *q == '-';
+        ++q;
+      }
+      if (q < end && *q >= '0' && *q <= '9') {
+        int exp = 0;
+        for (; q < end && *q >= '0' && *q <= '9'; ++q) {
+          if (exp < 10000) {
+            exp = exp * 10 + (*q - '0');
+          }
+        }
+        exponent += negative_exp ? -exp : exp;
+        p = q;
+      }
+    }
+
+    if (p == end) {
+      result.type = kCSSLengthNumber;
+    } else if (end - p == 2 && p[0] == 'p' && p[1] == 'x') {
+      result.type = kCSSLengthPx;
+    } else if (end - p == 2 && p[0] == 'w' && p[1] == 'x') {
+      result.type = kCSSLengthWx;
+    } else {
+      return result;
+    }
+
+    double value = static_cast<double>(mantissa);
+    if (mantissa != 0 && exponent != 0) {
+      value = exponent > 0 ? value * pow(10.0, exponent)
+                           : value / pow(10.0, -exponent);
+    }
+    result.value = static_cast<float>(negative ? -value : value);
+    return result;
+  }
+
+  inline CSSLength ParseCSSLength(const std::string &src) {
+    return ParseCSSLength(src.data(), src.size());
+  }
+
   inline float transferWx(const std::string &stringWithWXPostfix, const float &viewport,
                           const float &device_width) {
-    std::string temp = stringWithWXPostfix;
-    if (endWidth(stringWithWXPostfix, WX)) {
-      temp = stringWithWXPostfix.substr(0, stringWithWXPostfix.size() - strlen(WX));
-    }
-    float f = getFloat(temp.c_str());
-    float density = getFloat(WXCoreEnvironment::getInstance()->GetOption(SCALE).c_str());
+    CSSLength length = ParseCSSLength(stringWithWXPostfix);
+    float f = length.type == kCSSLengthWx || length.type == kCSSLengthNumber
+                  ? length.value : NAN;
+    float density = WXCoreEnvironment::getInstance()->DeviceScale();
     return density * f * viewport / device_width;
   }
 
-  inline static float getFloatByViewport(std::string src, const float &viewport,
+  inline static float getFloatByViewport(const std::string &src, const float &viewport,
           const float &device_width, const bool &round_off_deviation) {
-    float ret = NAN;
-    if (UNDEFINE == src
-        || AUTO_UNIT == src
-        || NONE == src
-        || src.empty()) {
-      return ret;
+    CSSLength length = ParseCSSLength(src);
+    switch (length.type) {
+      case kCSSLengthWx: {
+        float density = WXCoreEnvironment::getInstance()->DeviceScale();
+        return getFloat(density * length.value * viewport / device_width,
+                        viewport, device_width, round_off_deviation);
+      }
+      case kCSSLengthPx:
+      case kCSSLengthNumber:
+        return getFloat(length.value, viewport, device_width, round_off_deviation);
+      default:
+        return NAN;
     }
-    Trim(src);
-    if (endWidth(src, WX)) {
-      ret = getFloat(transferWx(src, viewport, device_width), viewport,  device_width, round_off_deviation);
-    } else if (endWidth(src, PX)) {
-      ret = getFloat(src.substr(0, src.size() - strlen(PX)), viewport, device_width, round_off_deviation);
-    } else {
-      ret = getFloat(src, viewport, device_width, round_off_deviation);
-    }
-    return ret;
   }
 
   inline static float getWebPxByWidth(float pxValue, float customViewport, float deviceWidth) {
@@ -84,7 +84,10 @@ namespace WeexCore {
   }
 
   void WXCoreEnvironment::AddOption(std::string key, std::string value) {
-    mOptions.insert(std::pair<std::string, std::string>(key, value));
+    bool inserted = mOptions.insert(std::pair<std::string, std::string>(key, value)).second;
+    if (inserted && key == SCALE) {
+      mDeviceScale = getFloat(value.c_str());
+    }
     if (key == "switchInteractionLog") {
       mInteractionLogSwitch = "true" == value;
     }
@@ -97,6 +100,9 @@ namespace WeexCore {
       return;
     }else{
       it->second = value;
+      if (key == SCALE) {
+        mDeviceScale = getFloat(value.c_str());
+      }
     }
   }
 
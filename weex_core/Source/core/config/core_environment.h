@@ -28,7 +28,7 @@ namespace WeexCore {
 
   private:
 
-    WXCoreEnvironment() {}
+    WXCoreEnvironment() : mDeviceScale(0) {}
 
     ~WXCoreEnvironment() {}
 
@@ -54,6 +54,10 @@ namespace WeexCore {
 
     std::map<std::string, std::string> mOptions;
 
+    // Numeric value of the "scale" option, kept in sync by AddOption and
+    // PutOption so wx conversion does not look it up per style value.
+    float mDeviceScale;
+
     bool mInteractionLogSwitch;
 
     bool mUseRuntimeApi;
@@ -92,6 +96,10 @@ namespace WeexCore {
 
     const std::string GetOption(const std::string &key);
 
+    inline float DeviceScale() {
+        return mDeviceScale;
+    }
+
     const std::map<std::string, std::string> &options();
 
     bool isUseRunTimeApi();
@@ -22,66 +22,106 @@
 
 #include <string>
 
-namespace WeexCore {
-  constexpr char DIRECTION[] = "direction";
-
-  constexpr char FLEX[] = "flex";
-  constexpr char HORIZONTAL[] = "horizontal";
-  constexpr char ALIGN_ITEMS[] = "alignItems";
-  constexpr char ALIGN_SELF[] = "alignSelf";
-  constexpr char FLEX_DIRECTION[] = "flexDirection";
-  constexpr char JUSTIFY_CONTENT[] = "justifyContent";
-  constexpr char FLEX_WRAP[] = "flexWrap";
-
-  constexpr char MIN_WIDTH[] = "minWidth";
-  constexpr char MIN_HEIGHT[] = "minHeight";
-  constexpr char MAX_WIDTH[] = "maxWidth";
-  constexpr char MAX_HEIGHT[] = "maxHeight";
-
-  constexpr char DEFAULT_HEIGHT[] = "defaultHeight";
-  constexpr char HEIGHT[] = "height";
-
-  constexpr char DEFAULT_WIDTH[] = "defaultWidth";
-  constexpr char WIDTH[] = "width";
-  constexpr char ROUND_OFF_DEVIATION[] = "roundOffDeviation";
-  constexpr char SCROLL_DIRECTION[] = "scrollDirection";
-
-  constexpr char POSITION[] = "position";
+// Names WeexCore reads from styles and attributes, as V(IDENTIFIER, "name").
+// Each becomes a constant below, and SmallStringMap shares all of them.
+#define WEEX_CORE_CONSTANT_NAMES(V)           \
+  V(DIRECTION, "direction")                   \
+  V(FLEX, "flex")                             \
+  V(HORIZONTAL, "horizontal")                 \
+  V(ALIGN_ITEMS, "alignItems")                \
+  V(ALIGN_SELF, "alignSelf")                  \
+  V(FLEX_DIRECTION, "flexDirection")          \
+  V(JUSTIFY_CONTENT, "justifyContent")        \
+  V(FLEX_WRAP, "flexWrap")                    \
+  V(MIN_WIDTH, "minWidth")                    \
+  V(MIN_HEIGHT, "minHeight")                  \
+  V(MAX_WIDTH, "maxWidth")                    \
+  V(MAX_HEIGHT, "maxHeight")                  \
+  V(DEFAULT_HEIGHT, "defaultHeight")          \
+  V(HEIGHT, "height")                         \
+  V(DEFAULT_WIDTH, "defaultWidth")            \
+  V(WIDTH, "width")                           \
+  V(ROUND_OFF_DEVIATION, "roundOffDeviation") \
+  V(SCROLL_DIRECTION, "scrollDirection")      \
+  V(POSITION, "position")                     \
+  V(LEFT, "left")                             \
+  V(TOP, "top")                               \
+  V(RIGHT, "right")                           \
+  V(BOTTOM, "bottom")                         \
+  V(MARGIN, "margin")                         \
+  V(MARGIN_LEFT, "marginLeft")                \
+  V(MARGIN_TOP, "marginTop")                  \
+  V(MARGIN_RIGHT, "marginRight")              \
+  V(MARGIN_BOTTOM, "marginBottom")            \
+  V(BORDER_WIDTH, "borderWidth")              \
+  V(BORDER_TOP_WIDTH, "borderTopWidth")       \
+  V(BORDER_RIGHT_WIDTH, "borderRightWidth")   \
+  V(BORDER_BOTTOM_WIDTH, "borderBottomWidth") \
+  V(BORDER_LEFT_WIDTH, "borderLeftWidth")     \
+  V(PADDING, "padding")                       \
+  V(PADDING_LEFT, "paddingLeft")              \
+  V(PADDING_TOP, "paddingTop")                \
+  V(PADDING_RIGHT, "paddingRight")            \
+  V(PADDING_BOTTOM, "paddingBottom")          \
+  V(FONT_STYLE, "fontStyle")                  \
+  V(FONT_SIZE, "fontSize")                    \
+  V(FONT_WEIGHT, "fontWeight")                \
+  V(FONT_FAMILY, "fontFamily")                \
+  V(LINE_HEIGHT, "lineHeight")                \
+  V(LETTER_SPACING, "letterSpacing")          \
+  V(TEXT_OVERFLOW, "textOverflow")            \
+  V(WHITE_SPACE, "whiteSpace")                \
+  V(LINES, "lines")                           \
+  V(VALUE, "value")                           \
+  V(COLUMN_WIDTH, "columnWidth")              \
+  V(COLUMN_COUNT, "columnCount")              \
+  V(COLUMN_GAP, "columnGap")                  \
+  V(LEFT_GAP, "leftGap")                      \
+  V(RIGHT_GAP, "rightGap")                    \
+  V(SPAN_OFFSETS, "spanOffsets")              \
+  V(LAYOUT_WINDOW, "layoutWindow")            \
+  V(LAYOUT_OVERSCAN, "layoutOverscan")        \
+  V(ESTIMATED_CELL_SIZE, "estimatedCellSize") \
+  V(COLOR, "color")                           \
+  V(BACKGROUND_COLOR, "backgroundColor")      \
+  V(OPACITY, "opacity")                       \
+  V(TRANSFORM, "transform")                   \
+  V(TRANSFORM_ORIGIN, "transformOrigin")      \
+  V(CHECKED, "checked")                       \
+  V(APPEND, "append")
 
-  constexpr char LEFT[] = "left";
-  constexpr char TOP[] = "top";
-  constexpr char RIGHT[] = "right";
-  constexpr char BOTTOM[] = "bottom";
+// Style, attribute and event names WeexCore only hands on to the platform.
+// They get no constant, but are common enough for SmallStringMap to share
+// them too.
+#define WEEX_CORE_PLATFORM_NAMES(V)                                             \
+  /* Styles */                                                                  \
+  V("backgroundImage") V("borderBottomColor") V("borderBottomLeftRadius")       \
+  V("borderBottomRightRadius") V("borderBottomStyle") V("borderColor")          \
+  V("borderLeftColor") V("borderLeftStyle") V("borderRadius")                   \
+  V("borderRightColor") V("borderRightStyle") V("borderStyle")                  \
+  V("borderTopColor") V("borderTopLeftRadius") V("borderTopRightRadius")        \
+  V("borderTopStyle") V("boxShadow") V("overflow") V("placeholderColor")        \
+  V("textAlign") V("textDecoration") V("transition") V("transitionDelay")       \
+  V("transitionDuration") V("transitionProperty")                               \
+  V("transitionTimingFunction") V("visibility") V("zIndex")                     \
+  /* Attributes */                                                              \
+  V("autofocus") V("class") V("disabled") V("href") V("index")                  \
+  V("interval") V("loadmoreoffset") V("maxlength") V("placeholder")             \
+  V("ref") V("resize") V("scrollable") V("show") V("showScrollbar")             \
+  V("src") V("type")                                                            \
+  /* Events */                                                                  \
+  V("appear") V("blur") V("change") V("click") V("disappear") V("focus")        \
+  V("input") V("keyboard") V("load") V("loading") V("loadmore")                 \
+  V("longpress") V("panend") V("panmove") V("panstart") V("pullingdown")        \
+  V("refresh") V("return") V("scroll") V("scrollend") V("scrollstart")          \
+  V("swipe") V("touchcancel") V("touchend") V("touchmove") V("touchstart")      \
+  V("viewappear") V("viewdisappear")
 
-  constexpr char MARGIN[] = "margin";
-  constexpr char MARGIN_LEFT[] = "marginLeft";
-  constexpr char MARGIN_TOP[] = "marginTop";
-  constexpr char MARGIN_RIGHT[] = "marginRight";
-  constexpr char MARGIN_BOTTOM[] = "marginBottom";
-
-  constexpr char BORDER_WIDTH[] = "borderWidth";
-  constexpr char BORDER_TOP_WIDTH[] = "borderTopWidth";
-  constexpr char BORDER_RIGHT_WIDTH[] = "borderRightWidth";
-  constexpr char BORDER_BOTTOM_WIDTH[] = "borderBottomWidth";
-  constexpr char BORDER_LEFT_WIDTH[] = "borderLeftWidth";
-
-  constexpr char PADDING[] = "padding";
-  constexpr char PADDING_LEFT[] = "paddingLeft";
-  constexpr char PADDING_TOP[] = "paddingTop";
-  constexpr char PADDING_RIGHT[] = "paddingRight";
-  constexpr char PADDING_BOTTOM[] = "paddingBottom";
-
-  constexpr char FONT_STYLE[] = "fontStyle";
-  constexpr char COLUMN_WIDTH[] = "columnWidth";
-  constexpr char COLUMN_COUNT[] = "columnCount";
-  constexpr char COLUMN_GAP[] = "columnGap";
-  constexpr char LEFT_GAP[] = "leftGap";
-  constexpr char RIGHT_GAP[] = "rightGap";
-  constexpr char SPAN_OFFSETS[] = "spanOffsets";
-
-  constexpr char COLOR[] = "color";
-  constexpr char BACKGROUND_COLOR[] = "backgroundColor";
-  constexpr char APPEND[] = "append";
+namespace WeexCore {
+#define WEEX_CORE_DEFINE_CONSTANT_NAME(identifier, name) \
+  constexpr char identifier[] = name;
+  WEEX_CORE_CONSTANT_NAMES(WEEX_CORE_DEFINE_CONSTANT_NAME)
+#undef WEEX_CORE_DEFINE_CONSTANT_NAME
 }
 
 #endif //WEEXV8_CONSTANTSNAME_H
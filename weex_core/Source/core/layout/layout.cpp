@@ -20,11 +20,29 @@
 #include <math.h>
 #include "layout.h"
 #include <tuple>
+#include "core/layout/tree_walker.h"
+#include "core/render/page/render_arena.h"
 
 using namespace WeexCore;
 
 namespace WeexCore {
 
+  void *WXCorelayoutResult::operator new(size_t size) {
+    return RenderArena::Allocate(size);
+  }
+
+  void WXCorelayoutResult::operator delete(void *ptr) {
+    RenderArena::Free(ptr);
+  }
+
+  void *WXCoreFlexLine::operator new(size_t size) {
+    return RenderArena::Allocate(size);
+  }
+
+  void WXCoreFlexLine::operator delete(void *ptr) {
+    RenderArena::Free(ptr);
+  }
+
   /**
    * Entry function to calculate layout
    */
@@ -49,19 +67,76 @@ namespace WeexCore {
   }
 
   void WXCoreLayoutNode::initFormatingContext(std::vector<WXCoreLayoutNode *> &BFCs) {
-    NonBFCs.clear();
-    for(auto it = ChildListIterBegin(); it != ChildListIterEnd(); it++) {
-      WXCoreLayoutNode* child = *it;
-      if (child != nullptr) {
-        if (isBFC(child)) {
-          BFCs.push_back(child);
-        } else {
-          NonBFCs.push_back(child);
-          child->initFormatingContext(BFCs);
+    // Main-axis progress through the children of each node on the walk, for
+    // parents that defer the layout of some children.
+    struct ChildScan {
+      bool horizontal;
+      float mainOffset;
+      float measuredMainSize;
+      Index measuredCount;
+    };
+    std::vector<ChildScan> scans;
+    TreeWalker<WXCoreLayoutNode> walker(this, 0, true);
+    while (!walker.Done()) {
+      WXCoreLayoutNode *node = walker.node();
+      if (walker.leaving()) {
+        scans.pop_back();
+        node->reset();
+        walker.Next();
+        continue;
+      }
+
+      WXCoreLayoutNode *parent = walker.parent();
+      if (parent != nullptr) {
+        if (isBFC(node)) {
+          node->mLayoutDeferred = false;
+          BFCs.push_back(node);
+          walker.Next(true);
+          continue;
         }
+        parent->NonBFCs.push_back(node);
+        if (parent->mDefersChildLayout) {
+          ChildScan &scan = scans.back();
+          float mainSize = calcItemSizeAlongAxis(node, scan.horizontal);
+          if (node->mLayoutSizeEstimated) {
+            mainSize = scan.measuredCount > 0 ? scan.measuredMainSize / scan.measuredCount
+                                              : parent->estimatedChildMainSize();
+          } else {
+            scan.measuredMainSize += mainSize;
+            scan.measuredCount++;
+          }
+          bool deferred = parent->isChildLayoutDeferred(node, scan.mainOffset, mainSize);
+          scan.mainOffset += mainSize;
+          if (deferred) {
+            node->deferLayout(mainSize, scan.horizontal);
+            walker.Next(true);
+            continue;
+          }
+        }
+        node->mLayoutDeferred = false;
       }
+
+      node->NonBFCs.clear();
+      scans.push_back({isMainAxisHorizontal(node), 0, 0, 0});
+      walker.Next();
+    }
+  }
+
+  /**
+   * Keep the last known size of a node that is left out of this pass, or give it
+   * an estimated one along the main axis if it has never been measured.
+   */
+  void WXCoreLayoutNode::deferLayout(const float mainSize, const bool horizontal) {
+    float &size = horizontal ? mLayoutResult->mLayoutSize.width
+                             : mLayoutResult->mLayoutSize.height;
+    if (mLayoutSizeEstimated) {
+      float styleSize = horizontal ? mCssStyle->mStyleWidth : mCssStyle->mStyleHeight;
+      size = !isnan(styleSize) ? styleSize
+                               : std::max(0.0f, mainSize - mCssStyle->sumMarginOfDirection(horizontal));
     }
-    reset();
+    mLayoutResult->mLayoutSize.hypotheticalWidth = mLayoutResult->mLayoutSize.width;
+    mLayoutResult->mLayoutSize.hypotheticalHeight = mLayoutResult->mLayoutSize.height;
+    mLayoutDeferred = true;
   }
 
   std::tuple<bool, float, float> WXCoreLayoutNode::calculateBFCDimension(const std::pair<float,float>& renderPageSize) {
@@ -152,6 +227,7 @@ namespace WeexCore {
   }
 
   void WXCoreLayoutNode::measure(const float width, const float height, const bool hypotheticalMeasurment){
+    mLayoutSizeEstimated = false;
     if(hypotheticalMeasurment){
       //Only BFC will enter this case.
       hypotheticalMeasure(width, height);
@@ -175,6 +251,7 @@ namespace WeexCore {
   }
 
   void WXCoreLayoutNode::hypotheticalMeasure(const float width, const float height, const bool stretch){
+    mLayoutSizeEstimated = false;
     if (getChildCount(kNonBFC) > 0) {
       measureInternalNode(width, height, true, true);
     } else {
@@ -326,7 +403,7 @@ namespace WeexCore {
     void WXCoreLayoutNode::measureChild(WXCoreLayoutNode* const child, const float currentMainSize,
                                         const float parentWidth, const float parentHeight,
                                         const bool needMeasure, const bool hypotheticalMeasurment) {
-      if (needMeasure && child->isDirty()) {
+      if (needMeasure && child->isDirty() && !child->mLayoutDeferred) {
         if (hypotheticalMeasurment) {
           float childWidth = child->mCssStyle->mStyleWidth;
           float childHeight = child->mCssStyle->mStyleHeight;
@@ -429,7 +506,7 @@ namespace WeexCore {
           node->mLayoutResult->mLayoutSize.hypotheticalHeight = nodeHeight;
         }
       } else {
-        if (widthRemeasure || heightRemeasure) {
+        if ((widthRemeasure || heightRemeasure) && !node->mLayoutDeferred) {
           node->measure(nodeWidth, nodeHeight, hypotheticalMeasurment);
         }
       }
@@ -563,7 +640,9 @@ namespace WeexCore {
           break;
       }
       setFrame(left, top, right, bottom);
-      onLayout(left, top, right, bottom);
+      if (!mLayoutDeferred) {
+        onLayout(left, top, right, bottom);
+      }
     }
   }
 
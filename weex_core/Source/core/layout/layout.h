@@ -29,6 +29,7 @@
 #include <algorithm>
 #include "style.h"
 #include "flex_enum.h"
+#include "core/common/hash_util.h"
 
 namespace WeexCore {
 
@@ -88,6 +89,10 @@ namespace WeexCore {
         mLayoutPosition.reset();
         mLayoutDirection = kDirectionInherit;
     }
+
+    static void *operator new(size_t size);
+
+    static void operator delete(void *ptr);
   };
 
   typedef WXCoreSize(*WXCoreMeasureFunc)(WXCoreLayoutNode *node, float width,
@@ -133,6 +138,10 @@ namespace WeexCore {
       mTotalFlexibleSize = 0;
       mIndicesAlignSelfStretch.clear();
     }
+
+    static void *operator new(size_t size);
+
+    static void operator delete(void *ptr);
   };
 
   /**
@@ -186,6 +195,8 @@ namespace WeexCore {
       const std::vector<WXCoreLayoutNode *>& get_child_list() const {return mChildList;}
 
       void removeAllChildren() {mChildList.clear();}
+
+      inline Index getFlexLineCount() const {return mFlexLines.size();}
   private:
 
     /**
@@ -223,6 +234,13 @@ namespace WeexCore {
       
     bool mNeedsPlatformDependentLayout = false;
 
+    bool mDefersChildLayout = false;
+
+    bool mLayoutDeferred = false;
+
+    // Until the first measure, the layout size is only a guess.
+    bool mLayoutSizeEstimated = true;
+
     WXCoreMeasureFunc measureFunc = nullptr;
 
     void *context = nullptr;
@@ -290,6 +308,63 @@ namespace WeexCore {
     inline void setNeedsPlatformDependentLayout(bool v) {
       this->mNeedsPlatformDependentLayout = v;
     }
+
+    inline bool getDefersChildLayout() const {
+      return mDefersChildLayout;
+    }
+
+    inline void setDefersChildLayout(bool v) {
+      if (mDefersChildLayout != v) {
+        mDefersChildLayout = v;
+        markDirty();
+      }
+    }
+
+    /**
+     * True if the last pass left this node out (see isChildLayoutDeferred);
+     * its subtree was neither measured nor laid out.
+     */
+    inline bool isLayoutDeferred() const {
+      return mLayoutDeferred;
+    }
+
+    /**
+     * Hash of every style that feeds layout, chained onto |hash|. The style is
+     * plain data (see copyFrom), so it is hashed as bytes.
+     */
+    inline uint64_t hashLayoutStyle(uint64_t hash) const {
+      return HashBytes(mCssStyle, sizeof(WXCoreCSSStyle), hash);
+    }
+
+    /**
+     * The bytes hashLayoutStyle hashes, appended to |out| for callers that
+     * must tell a hash collision from a match.
+     */
+    inline void appendLayoutStyle(std::string &out) const {
+      out.append(reinterpret_cast<const char *>(mCssStyle),
+                 sizeof(WXCoreCSSStyle));
+    }
+
+    /**
+     * hashLayoutStyle for keys kept across processes (see HashBytesStable).
+     */
+    inline uint64_t hashLayoutStyleStable(uint64_t hash) const {
+      return HashBytesStable(mCssStyle, sizeof(WXCoreCSSStyle), hash);
+    }
+
+    inline const WXCorelayoutResult &layoutResult() const {
+      return *mLayoutResult;
+    }
+
+    /**
+     * Takes a result computed earlier for a node with the same layout inputs
+     * instead of laying this node out again.
+     */
+    inline void restoreLayoutResult(const WXCorelayoutResult &result) {
+      *mLayoutResult = result;
+      mHasNewLayout = true;
+      clearDirty();
+    }
       
   private:
 
@@ -663,6 +738,8 @@ namespace WeexCore {
 
     void initFormatingContext(std::vector<WXCoreLayoutNode *> &BFCs);
 
+    void deferLayout(float mainSize, bool horizontal);
+
     std::pair<bool,float> calculateBFCWidth(float, float);
 
     std::pair<bool,float> calculateBFCHeight(float, float);
@@ -677,6 +754,26 @@ namespace WeexCore {
 
     }
 
+    /**
+     * Only asked when setDefersChildLayout(true) was called. A deferred child
+     * keeps its last size, and its subtree is skipped by measure and layout
+     * until a later pass brings it back.
+     * @param mainOffset where the child starts along the main axis
+     * @param mainSize   its last size along the main axis, margins included, or
+     *                   an estimate if it has never been measured
+     */
+    virtual bool isChildLayoutDeferred(WXCoreLayoutNode *child, float mainOffset, float mainSize) {
+      return false;
+    }
+
+    /**
+     * Main size used for a child that was never measured, until a measured
+     * sibling gives a better guess.
+     */
+    virtual float estimatedChildMainSize() const {
+      return 0;
+    }
+
 
   public:
     virtual void onLayout(float left, float top, float right, float bottom, WXCoreLayoutNode* = nullptr, WXCoreFlexLine *const flexLine = nullptr);
@@ -17,9 +17,18 @@
  * under the License.
  */
 #include "style.h"
+#include "core/render/page/render_arena.h"
 
 namespace WeexCore {
 
+  void *WXCoreCSSStyle::operator new(size_t size) {
+    return RenderArena::Allocate(size);
+  }
+
+  void WXCoreCSSStyle::operator delete(void *ptr) {
+    RenderArena::Free(ptr);
+  }
+
   bool WXCoreMargin::setMargin(const WXCoreMarginEdge &edge, float margin) {
     bool dirty = false;
     switch (edge) {
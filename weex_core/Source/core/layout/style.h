@@ -25,6 +25,7 @@
 #include "flex_enum.h"
 #include <math.h>
 #include <cmath>
+#include <cstddef>
 
 namespace WeexCore {
 
@@ -306,6 +307,13 @@ namespace WeexCore {
         return mMargin.getMargin(kMarginTop) + mMargin.getMargin(kMarginBottom);
       }
     }
+
+    /**
+     * Allocated from the arena of the page being built, if any.
+     */
+    static void *operator new(size_t size);
+
+    static void operator delete(void *ptr);
   };
 }
 #endif //WEEXCORE_FLEXLAYOUT_WXCOREFLEXENUMS_H
@@ -0,0 +1,118 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef CORE_LAYOUT_TREE_WALKER_H_
+#define CORE_LAYOUT_TREE_WALKER_H_
+
+#include <vector>
+
+#include "core/layout/layout.h"
+
+namespace WeexCore {
+
+/**
+ * Depth-first walk over the child lists of a layout tree, kept on an explicit
+ * stack so that very deep trees cannot overflow the native stack.
+ *
+ *   for (TreeWalker<RenderObject> walker(root); !walker.Done(); walker.Next()) {
+ *     Visit(walker.node(), walker.index());
+ *   }
+ *
+ * Nodes are visited in pre-order. If |visit_leaving| is set, every node is
+ * visited a second time once its subtree is done, with leaving() true; that
+ * visit may delete the node. Next(true) skips the children of the current
+ * node, and its leaving visit as well. Null children are skipped, but still
+ * count for index().
+ *
+ * The child list of a node is read when the node is reached, so it must not
+ * change until the node is left.
+ */
+template <typename Node>
+class TreeWalker {
+ public:
+  explicit TreeWalker(Node *root, Index root_index = 0,
+                      bool visit_leaving = false)
+      : visit_leaving_(visit_leaving) {
+    if (root != nullptr) {
+      Push(root, root_index);
+    }
+  }
+
+  inline bool Done() const { return stack_.empty(); }
+
+  inline Node *node() const { return stack_.back().node; }
+
+  // Null for the root.
+  inline Node *parent() const {
+    return stack_.size() > 1 ? stack_[stack_.size() - 2].node : nullptr;
+  }
+
+  // Position of node() in its parent's child list, |root_index| for the root.
+  inline Index index() const { return stack_.back().index; }
+
+  inline size_t depth() const { return stack_.size() - 1; }
+
+  inline bool leaving() const { return leaving_; }
+
+  void Next(bool skip_children = false) {
+    if (leaving_ || skip_children) {
+      stack_.pop_back();
+    }
+    leaving_ = false;
+    while (!stack_.empty()) {
+      Frame &top = stack_.back();
+      while (top.next != top.end) {
+        ChildIterator it = top.next++;
+        if (*it != nullptr) {
+          // |top| is not used once the stack may have grown.
+          Push(static_cast<Node *>(*it), it - top.begin);
+          return;
+        }
+      }
+      if (visit_leaving_) {
+        leaving_ = true;
+        return;
+      }
+      stack_.pop_back();
+    }
+  }
+
+ private:
+  typedef std::vector<WXCoreLayoutNode *>::const_iterator ChildIterator;
+
+  struct Frame {
+    Node *node;
+    Index index;
+    ChildIterator begin;
+    ChildIterator next;
+    ChildIterator end;
+  };
+
+  inline void Push(Node *node, Index index) {
+    ChildIterator begin = node->ChildListIterBegin();
+    stack_.push_back({node, index, begin, begin, node->ChildListIterEnd()});
+  }
+
+  std::vector<Frame> stack_;
+  bool visit_leaving_;
+  bool leaving_ = false;
+};
+
+}  // namespace WeexCore
+
+#endif  // CORE_LAYOUT_TREE_WALKER_H_
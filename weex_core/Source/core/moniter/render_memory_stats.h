@@ -0,0 +1,66 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef CORE_MONITER_RENDER_MEMORY_STATS_H_
+#define CORE_MONITER_RENDER_MEMORY_STATS_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace WeexCore {
+
+  // Native memory held by one page. The counters are updated as the render
+  // tree changes, so reading them never walks the tree.
+  class RenderMemoryStats {
+
+  public:
+
+    // Registered render objects, richtext children included.
+    int64_t renderObjects;
+
+    // Render objects laid out by the page's flex layout tree.
+    int64_t layoutNodes;
+
+    // Style values and their containers; vocabulary names are shared.
+    int64_t styleBytes;
+
+    // Attribute values, events and their containers.
+    int64_t attrBytes;
+
+    // Flex lines held by the layout tree, as of the last layout pass.
+    int64_t flexLines;
+
+    // Render actions posted to the platform since the page was created.
+    int64_t postedActions;
+
+    // Chunks reserved by the page's render arena, if it has one.
+    int64_t arenaBytes;
+
+    RenderMemoryStats() : renderObjects(0), layoutNodes(0), styleBytes(0),
+                          attrBytes(0), flexLines(0), postedActions(0),
+                          arenaBytes(0) {}
+
+    // In the order of the fields above.
+    std::vector<int64_t> ToVector() const {
+      return {renderObjects, layoutNodes, styleBytes, attrBytes,
+              flexLines, postedActions, arenaBytes};
+    }
+  };
+}
+
+#endif  // CORE_MONITER_RENDER_MEMORY_STATS_H_
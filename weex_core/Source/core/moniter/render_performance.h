@@ -52,11 +52,17 @@ namespace WeexCore {
 
     int64_t cssLayoutTimeForInteraction;
 
+    // Style and attribute pairs dropped because the node already held them.
+    int64_t suppressedStyleUpdates;
+
+    int64_t suppressedAttrUpdates;
+
     RenderPerformance() : callBridgeTime(0), cssLayoutTime(0), parseJsonTime(0),
                           firstScreenCallBridgeTime(0), firstScreenCssLayoutTime(0),
                           firstScreenParseJsonTime(0), onRenderSuccessCallBridgeTime(0),
                           onRenderSuccessCssLayoutTime(0), onRenderSuccessParseJsonTime(0),
-                          cssLayoutTimeForInteraction(0) {}
+                          cssLayoutTimeForInteraction(0), suppressedStyleUpdates(0),
+                          suppressedAttrUpdates(0) {}
     bool onInteractionTimeUpdate();
 
     void getPerformanceStringData(std::map<std::string,std::string> &map);
@@ -21,6 +21,7 @@
 //
 
 #include <list>
+#include <vector>
 #include "core/render/node/render_object.h"
 #include "core/render/page/render_page.h"
 #include "core/render/node/factory/render_creator.h"
@@ -44,166 +45,165 @@ namespace WeexCore {
 
 
     /**
-     * parser wson to render object
+     * one wson map being parsed into a render object, kept on an explicit stack
+     * so that deeply nested children cannot overflow the native stack
      * */
-    RenderObject *parserWson2RenderObject(wson_parser& parser, RenderObject *parent, int index, const std::string &pageId, bool reserveStyles){
+    struct WsonObjectFrame {
+        RenderObject *parent;
+        int index;
+        RenderObject *render;
+        int size;
+        int key;
+        int state;
+        bool keyOrderRight;
+        bool secondPass;
+        int childSize;
+        int childIndex;
+        std::string ref;
+    };
+
+    static bool beginWsonObject(wson_parser& parser, std::vector<WsonObjectFrame>& stack, RenderObject *parent, int index){
         int objectType = parser.nextType();
         if(!parser.isMap(objectType)){
             parser.skipValue(objectType);
-            return nullptr;
+            return false;
         }
-        /**
-         * because strem key order specified, so will cann't dependecy it's keys order,
-         * if key orders right parse one time, if not first parse ref type create render object
-         * then parse others attrs
-         * */
-        int size = parser.nextMapSize();
-        std::string ref;
-        std::string renderType;
-        RenderObject *render = nullptr;
-        int state = parser.getState();
-        bool keyOrderRight = true;
-        for(int i=0; i < size; i++){
-            std::string objectKey = parser.nextMapKeyUTF8();
-            if(0 == strcmp(objectKey.c_str(), "ref")){
-                ref = parser.nextStringUTF8(parser.nextType());
-                if (render != nullptr) {
-                    // ref may be after type, so need set to render
-                    render->set_ref(ref);
-                }
-            }else if (0 == strcmp(objectKey.c_str(), "type")) {
-                renderType = parser.nextStringUTF8(parser.nextType());
-                render = (RenderObject *) RenderCreator::GetInstance()->CreateRender(renderType, ref);
-                render->set_page_id(pageId);
-                if (parent != nullptr){
-                    parent->AddRenderObject(index, render);
-                }
-            }else if (0 == strcmp(objectKey.c_str(), "attr")){ //attr is map object
-                uint8_t attrType = parser.nextType();
-                if(parser.isMap(attrType) && keys_order_as_expect(render, keyOrderRight)){
-                    int attrMapSize = parser.nextMapSize();
-                    for(int attrIndex=0; attrIndex<attrMapSize; attrIndex++){
-                        std::string attrKeyString = parser.nextMapKeyUTF8();
-                        std::string attrValueString = parser.nextStringUTF8(parser.nextType());
-                        render->AddAttr(attrKeyString, attrValueString);
-                    }
-                }else{
-                    keyOrderRight = keys_order_as_expect(render, keyOrderRight);
-                    parser.skipValue(attrType);
-                }
-            }else if (0 == strcmp(objectKey.c_str(), "style")){ //style is map object
-                uint8_t styleType = parser.nextType();
-                if(parser.isMap(styleType) && keys_order_as_expect(render, keyOrderRight)){
-                    int styleMapSize = parser.nextMapSize();
-                    for(int styleIndex=0; styleIndex<styleMapSize; styleIndex++){
-                        std::string styleKeyString = parser.nextMapKeyUTF8();
-                        std::string styleValueString = parser.nextStringUTF8(parser.nextType());
-                        render->AddStyle(styleKeyString, styleValueString, reserveStyles);
-                    }
-                }else{
-                    keyOrderRight = keys_order_as_expect(render, keyOrderRight);
-                    parser.skipValue(styleType);
-                }
-            }else if (0 == strcmp(objectKey.c_str(), "event")) {//event is array
-                uint8_t  eventType = parser.nextType();
-                if(parser.isArray(eventType) && keys_order_as_expect(render, keyOrderRight)){
-                    int eventSize = parser.nextArraySize();
-                    for(int eventIndex=0; eventIndex < eventSize; eventIndex++){
-                        std::string eventValue = parser.nextStringUTF8(parser.nextType());
-                        if(eventValue.size() > 0){
-                            render->AddEvent(eventValue);
-                        }
-                    }
-                }else{
-                    keyOrderRight = keys_order_as_expect(render, keyOrderRight);
-                    parser.skipValue(eventType);
+        WsonObjectFrame frame;
+        frame.parent = parent;
+        frame.index = index;
+        frame.render = nullptr;
+        frame.size = parser.nextMapSize();
+        frame.key = 0;
+        frame.state = parser.getState();
+        frame.keyOrderRight = true;
+        frame.secondPass = false;
+        frame.childSize = 0;
+        frame.childIndex = 0;
+        stack.push_back(frame);
+        return true;
+    }
+
+    /**
+     * parse the next key of the frame's map, on the second pass only attr, style,
+     * event and children are parsed. children are not parsed here, only counted
+     * */
+    static void parseWsonObjectKey(wson_parser& parser, WsonObjectFrame& frame, const std::string &pageId, bool reserveStyles){
+        std::string objectKey = parser.nextMapKeyUTF8();
+        bool accept = frame.secondPass || keys_order_as_expect(frame.render, frame.keyOrderRight);
+        if(!frame.secondPass && 0 == strcmp(objectKey.c_str(), "ref")){
+            frame.ref = parser.nextStringUTF8(parser.nextType());
+            if (frame.render != nullptr) {
+                // ref may be after type, so need set to render
+                frame.render->set_ref(frame.ref);
+            }
+        }else if (!frame.secondPass && 0 == strcmp(objectKey.c_str(), "type")) {
+            std::string renderType = parser.nextStringUTF8(parser.nextType());
+            frame.render = (RenderObject *) RenderCreator::GetInstance()->CreateRender(renderType, frame.ref);
+            frame.render->set_page_id(pageId);
+            if (frame.parent != nullptr){
+                frame.parent->AddRenderObject(frame.index, frame.render);
+            }
+        }else if (0 == strcmp(objectKey.c_str(), "attr")){ //attr is map object
+            uint8_t attrType = parser.nextType();
+            if(parser.isMap(attrType) && accept){
+                int attrMapSize = parser.nextMapSize();
+                for(int attrIndex=0; attrIndex<attrMapSize; attrIndex++){
+                    std::string attrKeyString = parser.nextMapKeyUTF8();
+                    std::string attrValueString = parser.nextStringUTF8(parser.nextType());
+                    frame.render->AddAttr(attrKeyString, attrValueString);
                 }
-            }else if (0 == strcmp(objectKey.c_str(), "children")) {
-                uint8_t  childType = parser.nextType();
-                if(parser.isArray(childType) && keys_order_as_expect(render, keyOrderRight)){
-                    int childSize = parser.nextArraySize();
-                    for(int childIndex=0; childIndex < childSize; childIndex++){
-                        parserWson2RenderObject(parser, render, childIndex, pageId, reserveStyles);
-                    }
-                }else{
-                    keyOrderRight = keys_order_as_expect(render, keyOrderRight);
-                    parser.skipValue(childType);
+            }else{
+                frame.keyOrderRight = keys_order_as_expect(frame.render, frame.keyOrderRight);
+                parser.skipValue(attrType);
+            }
+        }else if (0 == strcmp(objectKey.c_str(), "style")){ //style is map object
+            uint8_t styleType = parser.nextType();
+            if(parser.isMap(styleType) && accept){
+                int styleMapSize = parser.nextMapSize();
+                for(int styleIndex=0; styleIndex<styleMapSize; styleIndex++){
+                    std::string styleKeyString = parser.nextMapKeyUTF8();
+                    std::string styleValueString = parser.nextStringUTF8(parser.nextType());
+                    frame.render->AddStyle(styleKeyString, styleValueString, reserveStyles);
                 }
             }else{
-                parser.skipValue(parser.nextType());
+                frame.keyOrderRight = keys_order_as_expect(frame.render, frame.keyOrderRight);
+                parser.skipValue(styleType);
             }
-        }
-
-        /**
-         * if key order not right, parse attr&style  events children again
-         * */
-        if(!keyOrderRight && render != nullptr){
-            parser.restoreToState(state);
-            for(int i=0; i < size; i++){
-                std::string objectKey = parser.nextMapKeyUTF8();
-                if (0 == strcmp(objectKey.c_str(), "attr")){ //attr is map object
-                    uint8_t attrType = parser.nextType();
-                    if(parser.isMap(attrType)){
-                        int attrMapSize = parser.nextMapSize();
-                        for(int attrIndex=0; attrIndex<attrMapSize; attrIndex++){
-                            std::string attrKeyString = parser.nextMapKeyUTF8();
-                            std::string attrValueString = parser.nextStringUTF8(parser.nextType());
-                            render->AddAttr(attrKeyString, attrValueString);
-                        }
-                    }else{
-                        parser.skipValue(attrType);
-                    }
-                }else if (0 == strcmp(objectKey.c_str(), "style")){ //style is map object
-                    uint8_t styleType = parser.nextType();
-                    if(parser.isMap(styleType)){
-                        int styleMapSize = parser.nextMapSize();
-                        for(int styleIndex=0; styleIndex<styleMapSize; styleIndex++){
-                            std::string styleKeyString = parser.nextMapKeyUTF8();
-                            std::string styleValueString = parser.nextStringUTF8(parser.nextType());
-                            render->AddStyle(styleKeyString, styleValueString, reserveStyles);
-                        }
-                    }else{
-                        parser.skipValue(styleType);
-                    }
-                }else if (0 == strcmp(objectKey.c_str(), "event")) {//event is array
-                    uint8_t  eventType = parser.nextType();
-                    if(parser.isArray(eventType)){
-                        int eventSize = parser.nextArraySize();
-                        for(int eventIndex=0; eventIndex < eventSize; eventIndex++){
-                            std::string eventValue = parser.nextStringUTF8(parser.nextType());
-                            if(eventValue.size() > 0){
-                                render->AddEvent(eventValue);
-                            }
-                        }
-                    }else{;
-                        parser.skipValue(eventType);
+        }else if (0 == strcmp(objectKey.c_str(), "event")) {//event is array
+            uint8_t  eventType = parser.nextType();
+            if(parser.isArray(eventType) && accept){
+                int eventSize = parser.nextArraySize();
+                for(int eventIndex=0; eventIndex < eventSize; eventIndex++){
+                    std::string eventValue = parser.nextStringUTF8(parser.nextType());
+                    if(eventValue.size() > 0){
+                        frame.render->AddEvent(eventValue);
                     }
-                }else if (0 == strcmp(objectKey.c_str(), "children")) {
-                    uint8_t  childType = parser.nextType();
-                    if(parser.isArray(childType)){
-                        int childSize = parser.nextArraySize();
-                        for(int childIndex=0; childIndex < childSize; childIndex++){
-                            parserWson2RenderObject(parser, render, childIndex, pageId, reserveStyles);
-                        }
-                    }else{
-                        parser.skipValue(childType);
-                    }
-                }else{
-                    parser.skipValue(parser.nextType());
                 }
+            }else{
+                frame.keyOrderRight = keys_order_as_expect(frame.render, frame.keyOrderRight);
+                parser.skipValue(eventType);
             }
+        }else if (0 == strcmp(objectKey.c_str(), "children")) {
+            uint8_t  childType = parser.nextType();
+            if(parser.isArray(childType) && accept){
+                frame.childSize = parser.nextArraySize();
+                frame.childIndex = 0;
+            }else{
+                frame.keyOrderRight = keys_order_as_expect(frame.render, frame.keyOrderRight);
+                parser.skipValue(childType);
+            }
+        }else{
+            parser.skipValue(parser.nextType());
         }
+    }
 
+    /**
+     * parser wson to render object
+     * */
+    RenderObject *parserWson2RenderObject(wson_parser& parser, RenderObject *parent, int index, const std::string &pageId, bool reserveStyles){
+        std::vector<WsonObjectFrame> stack;
+        if(!beginWsonObject(parser, stack, parent, index)){
+            return nullptr;
+        }
+        RenderObject *result = nullptr;
+        while (!stack.empty()) {
+            WsonObjectFrame &frame = stack.back();
+            if (frame.childIndex < frame.childSize) {
+                int childIndex = frame.childIndex++;
+                // may reallocate the stack, frame is not used after this
+                beginWsonObject(parser, stack, frame.render, childIndex);
+                continue;
+            }
+            if (frame.key < frame.size) {
+                frame.key++;
+                parseWsonObjectKey(parser, frame, pageId, reserveStyles);
+                continue;
+            }
+            /**
+             * because strem key order specified, so will cann't dependecy it's keys order,
+             * if key orders right parse one time, if not first parse ref type create render object
+             * then parse attr&style  events children again
+             * */
+            if (!frame.keyOrderRight && !frame.secondPass && frame.render != nullptr) {
+                parser.restoreToState(frame.state);
+                frame.secondPass = true;
+                frame.key = 0;
+                continue;
+            }
 
-        if (render != nullptr) {
-            render->ApplyDefaultStyle(reserveStyles);
-            render->ApplyDefaultAttr();
+            RenderObject *render = frame.render;
+            if (render != nullptr) {
+                render->ApplyDefaultStyle(reserveStyles);
+                render->ApplyDefaultAttr();
+            }
+            stack.pop_back();
+            if (stack.empty()) {
+                result = render;
+            }
         }
-        return render;
+        return result;
     }
 
-
-
     RenderObject *parserWson2RenderObjectNew(wson_parser& parser, RenderObject *parent, int index, const std::string &pageId,bool reserveStyles){
         int objectType = parser.nextType();
         if(!parser.isMap(objectType)){
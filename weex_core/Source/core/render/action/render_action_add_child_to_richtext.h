@@ -19,10 +19,9 @@
 #ifndef CORE_RENDER_ACTION_RENDER_ACTION_ADD_CHILD_TO_RICHTEXT_H_
 #define CORE_RENDER_ACTION_RENDER_ACTION_ADD_CHILD_TO_RICHTEXT_H_
 
-#include <map>
-#include <set>
 #include <string>
 
+#include "core/common/small_string_map.h"
 #include "core/layout/style.h"
 #include "core/render/action/render_action_interface.h"
 
@@ -40,8 +39,8 @@ class RenderActionAddChildToRichtext : public RenderAction {
   void ExecuteAction();
 
  public:
-  std::map<std::string, std::string> *styles_;
-  std::map<std::string, std::string> *attributes_;
+  SmallStringMap *styles_;
+  SmallStringMap *attributes_;
   std::string page_id_;
   std::string parent_ref_;
   std::string node_type_;
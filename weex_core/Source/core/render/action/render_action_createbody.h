@@ -19,10 +19,9 @@
 #ifndef CORE_RENDER_ACTION_RENDER_ACTION_CREATEBODY_H_
 #define CORE_RENDER_ACTION_RENDER_ACTION_CREATEBODY_H_
 
-#include <map>
-#include <set>
 #include <string>
 
+#include "core/common/small_string_map.h"
 #include "core/layout/style.h"
 #include "core/render/action/render_action_interface.h"
 
@@ -38,9 +37,9 @@ class RenderActionCreateBody : public RenderAction {
   void ExecuteAction();
 
  public:
-  std::map<std::string, std::string> *styles_;
-  std::map<std::string, std::string> *attributes_;
-  std::set<std::string> *events_;
+  SmallStringMap *styles_;
+  SmallStringMap *attributes_;
+  SmallStringSet *events_;
   WXCoreMargin margins_;
   WXCorePadding paddings_;
   WXCoreBorderWidth borders_;
@@ -29,6 +29,8 @@
 #include "core/layout/measure_func_adapter.h"
 #include "core/parser/dom_wson.h"
 #include "core/render/node/render_object.h"
+#include "core/render/page/layout_cache.h"
+#include "core/render/page/render_arena.h"
 #include "core/render/page/render_page.h"
 #include "core/render/page/render_page_custom.h"
 #include "core/render/target/render_target.h"
@@ -39,6 +41,13 @@ namespace WeexCore {
 
 RenderManager *RenderManager::g_pInstance = nullptr;
 
+RenderManager::~RenderManager() {
+  if (this->layout_cache_ != nullptr) {
+    delete this->layout_cache_;
+    this->layout_cache_ = nullptr;
+  }
+}
+
 
 
 bool RenderManager::CreatePage(const std::string& page_id, const char *data) {
@@ -84,7 +93,11 @@ bool RenderManager::CreatePage(const std::string& page_id, const char *data) {
       initDeviceConfig(page, page_id);
 
       int64_t start_time = getCurrentTime();
-      RenderObject *root = Wson2RenderObject(data, page_id, page->reserve_css_styles());
+      RenderObject *root;
+      {
+        RenderArena::Scope arena_scope(page->arena());
+        root = Wson2RenderObject(data, page_id, page->reserve_css_styles());
+      }
       page->ParseJsonTime(getCurrentTime() - start_time);
 
       return page->CreateRootRender(root);
@@ -121,7 +134,11 @@ bool RenderManager::CreatePage(const std::string& page_id, std::function<RenderO
   initDeviceConfig(page, page_id);
   
   int64_t start_time = getCurrentTime();
-  RenderObject *root = constructRoot(page);
+  RenderObject *root;
+  {
+    RenderArena::Scope arena_scope(page->arena());
+    root = constructRoot(page);
+  }
   page->ParseJsonTime(getCurrentTime() - start_time);
   
   return page->CreateRootRender(root);
@@ -198,7 +215,11 @@ bool RenderManager::AddRenderObject(const std::string &page_id,
   int64_t start_time = getCurrentTime();
 
   if (page->is_platform_page()) {
-      RenderObject *child = Wson2RenderObject(data, page_id, static_cast<RenderPage*>(page)->reserve_css_styles());
+      RenderObject *child;
+      {
+        RenderArena::Scope arena_scope(static_cast<RenderPage*>(page)->arena());
+        child = Wson2RenderObject(data, page_id, static_cast<RenderPage*>(page)->reserve_css_styles());
+      }
       static_cast<RenderPage*>(page)->ParseJsonTime(getCurrentTime() - start_time);
 
       if (child == nullptr) return false;
@@ -257,7 +278,11 @@ bool RenderManager::AddRenderObject(const std::string &page_id,
          pageId.c_str(), parentRef.c_str(), index, parser.toStringUTF8().c_str());
 #endif
     
-    RenderObject *root = constructRoot(static_cast<RenderPage*>(page));
+    RenderObject *root;
+    {
+        RenderArena::Scope arena_scope(static_cast<RenderPage*>(page)->arena());
+        root = constructRoot(static_cast<RenderPage*>(page));
+    }
     if (root == nullptr) return false;
     
     static_cast<RenderPage*>(page)->set_is_dirty(true);
@@ -605,6 +630,18 @@ std::map<std::string, std::string> RenderManager::removePageArguments(const std:
     return result;
 }
 
+LayoutCache *RenderManager::layout_cache() {
+  if (!this->layout_cache_checked_) {
+    this->layout_cache_checked_ = true;
+    std::string directory =
+        WXCoreEnvironment::getInstance()->GetOption("layoutCacheDir");
+    if (!directory.empty()) {
+      this->layout_cache_ = new LayoutCache(directory);
+    }
+  }
+  return this->layout_cache_;
+}
+
 void RenderManager::Batch(const std::string &page_id) {
   RenderPageBase *page = this->GetPage(page_id);
   if (page == nullptr) return;
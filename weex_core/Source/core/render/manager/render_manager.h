@@ -28,6 +28,7 @@
 
 namespace WeexCore {
 
+class LayoutCache;
 class RenderPageBase;
 class RenderPageCustom;
 class RenderPage;
@@ -37,7 +38,7 @@ class RenderManager {
  private:
   RenderManager() : pages_() {}
 
-  ~RenderManager() {}
+  ~RenderManager();
 
   // just to release singleton object
   class Garbo {
@@ -139,6 +140,10 @@ class RenderManager {
   std::string getPageArgument(const std::string& pageId, const std::string& key);
   std::map<std::string, std::string> removePageArguments(const std::string& pageId); // remove and return the page arguments
 
+  // First-screen layout cache shared by all pages, nullptr unless the
+  // "layoutCacheDir" option is set.
+  LayoutCache *layout_cache();
+
   static RenderManager *GetInstance() {
     if (NULL == g_pInstance) {
       g_pInstance = new RenderManager();
@@ -154,6 +159,8 @@ class RenderManager {
   std::map<std::string, RenderPageBase *> pages_;
   std::mutex page_args_mutex_;
   std::map<std::string, std::map<std::string, std::string>> page_args_;
+  LayoutCache *layout_cache_ = nullptr;
+  bool layout_cache_checked_ = false;
 };
 }  // namespace WeexCore
 
@@ -0,0 +1,77 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef CORE_RENDER_NODE_DEFAULT_STYLE_TABLE_H_
+#define CORE_RENDER_NODE_DEFAULT_STYLE_TABLE_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace WeexCore {
+
+// Immutable list of default styles or attributes for a component type.
+// Tables are built once per distinct set of defaults and shared by every
+// render object that asks for them, instead of each node allocating and
+// filling a map of its own.
+class DefaultStyleTable {
+ public:
+  typedef std::vector<std::pair<std::string, std::string>> Entries;
+
+  explicit DefaultStyleTable(Entries entries) : entries_(std::move(entries)) {}
+
+  inline const Entries &entries() const { return entries_; }
+
+ private:
+  const Entries entries_;
+};
+
+typedef std::shared_ptr<const DefaultStyleTable> DefaultStyleTableRef;
+
+inline DefaultStyleTableRef MakeDefaultStyleTable(
+    DefaultStyleTable::Entries entries) {
+  return std::make_shared<const DefaultStyleTable>(std::move(entries));
+}
+
+// Remembers the last table built for a component type together with the
+// inputs it was built from. A table is rebuilt only when those inputs
+// change; objects still holding the previous one keep it alive.
+template <typename Key>
+class DefaultStyleTableCache {
+ public:
+  template <typename Builder>
+  DefaultStyleTableRef Get(const Key &key, Builder build) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (table_ == nullptr || !(key_ == key)) {
+      key_ = key;
+      table_ = MakeDefaultStyleTable(build());
+    }
+    return table_;
+  }
+
+ private:
+  std::mutex mutex_;
+  Key key_;
+  DefaultStyleTableRef table_;
+};
+
+}  // namespace WeexCore
+
+#endif  // CORE_RENDER_NODE_DEFAULT_STYLE_TABLE_H_
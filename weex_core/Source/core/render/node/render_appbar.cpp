@@ -25,7 +25,10 @@
 
 namespace WeexCore {
 
-std::map<std::string, std::string> *RenderAppBar::GetDefaultStyle() {
+DefaultStyleTableRef RenderAppBar::GetDefaultStyle() {
+  // Keyed by the color and background color to apply, empty when skipped.
+  static DefaultStyleTableCache<std::pair<std::string, std::string>> cache;
+
   this->default_nav_width_ = getFloat(
       WXCoreEnvironment::getInstance()->GetOption("defaultNavWidth").c_str());
 
@@ -39,23 +42,24 @@ std::map<std::string, std::string> *RenderAppBar::GetDefaultStyle() {
   std::string appbar_background_color =
       WXCoreEnvironment::getInstance()->GetOption("appbar_background_color");
 
-  std::map<std::string, std::string> *style =
-      new std::map<std::string, std::string>();
+  if (StyleExist(COLOR)) appbar_color.clear();
+  if (StyleExist(BACKGROUND_COLOR)) appbar_background_color.clear();
+
+  return cache.Get(
+      std::make_pair(appbar_color, appbar_background_color), [&]() {
+        DefaultStyleTable::Entries style;
 #if OS_IOS
-  style->insert(std::pair<std::string, std::string>(PADDING_LEFT, "44"));
-  style->insert(std::pair<std::string, std::string>(PADDING_RIGHT, "44"));
+        style.emplace_back(PADDING_LEFT, "44");
+        style.emplace_back(PADDING_RIGHT, "44");
 #else
-  style->insert(std::pair<std::string, std::string>(PADDING_LEFT, "0"));
-  style->insert(std::pair<std::string, std::string>(PADDING_RIGHT, "0"));
+        style.emplace_back(PADDING_LEFT, "0");
+        style.emplace_back(PADDING_RIGHT, "0");
 #endif
-
-  if (!appbar_color.empty() && appbar_color != "" && !StyleExist(COLOR))
-    style->insert(std::pair<std::string, std::string>(COLOR, appbar_color));
-  if (!appbar_background_color.empty() && appbar_background_color != "" &&
-      !StyleExist(BACKGROUND_COLOR))
-    style->insert(std::pair<std::string, std::string>(BACKGROUND_COLOR,
-                                                      appbar_background_color));
-  return style;
+        if (!appbar_color.empty()) style.emplace_back(COLOR, appbar_color);
+        if (!appbar_background_color.empty())
+          style.emplace_back(BACKGROUND_COLOR, appbar_background_color);
+        return style;
+      });
 }
 
 bool RenderAppBar::StyleExist(const std::string &key) {
@@ -88,4 +92,23 @@ StyleType RenderAppBar::ApplyStyle(const std::string &key,
     return RenderObject::ApplyStyle(key, value, updating);
   }
 }
+
+bool RenderAppBar::IsStyleUnchanged(const std::string &key,
+                                    const std::string &value) {
+  float padding;
+  if (key == PADDING) {
+    if (!ParseStyleFloat(value, 0, &padding)) return true;
+    return getPaddingLeft() == padding + this->default_nav_width_ &&
+           getPaddingRight() == padding + this->default_overflow_width_ &&
+           getPaddingTop() == padding && getPaddingBottom() == padding;
+  } else if (key == PADDING_LEFT) {
+    if (!ParseStyleFloat(value, 0, &padding)) return true;
+    return getPaddingLeft() == padding + this->default_nav_width_;
+  } else if (key == PADDING_RIGHT) {
+    if (!ParseStyleFloat(value, 0, &padding)) return true;
+    return getPaddingRight() == padding + this->default_overflow_width_;
+  } else {
+    return RenderObject::IsStyleUnchanged(key, value);
+  }
+}
 }  // namespace WeexCore
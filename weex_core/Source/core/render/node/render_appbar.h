@@ -27,7 +27,7 @@
 namespace WeexCore {
 class RenderAppBar : public RenderObject {
  private:
-  std::map<std::string, std::string> *GetDefaultStyle();
+  DefaultStyleTableRef GetDefaultStyle() override;
 
   bool StyleExist(const std::string &key);
 
@@ -35,6 +35,9 @@ class RenderAppBar : public RenderObject {
   StyleType ApplyStyle(const std::string &key, const std::string &value,
                        const bool updating);
 
+  bool IsStyleUnchanged(const std::string &key,
+                        const std::string &value) override;
+
  private:
   float default_nav_width_;
   float default_overflow_width_;
@@ -21,8 +21,11 @@
 #include <cmath>
 #include <utility>
 
+#include "core/common/hash_util.h"
 #include "core/common/view_utils.h"
+#include "core/config/core_environment.h"
 #include "core/css/constants_name.h"
+#include "core/layout/tree_walker.h"
 #include "core/render/manager/render_manager.h"
 #include "core/render/node/factory/render_type.h"
 #include "core/render/node/render_list.h"
@@ -32,6 +35,9 @@
 
 namespace WeexCore {
 
+// Distinct layouts kept per list before the cache starts over.
+static const size_t kCellLayoutCacheCapacity = 128;
+
 RenderList::~RenderList() {
   if (this->cell_slots_copys_.size() > 0) {
     for (auto it = this->cell_slots_copys_.begin();
@@ -63,9 +69,9 @@ void RenderList::AddCellSlotCopyTrack(RenderObject *cell_slot) {
   this->cell_slots_copys_.push_back(cell_slot);
 }
 
-std::map<std::string, std::string> *RenderList::GetDefaultStyle() {
-  std::map<std::string, std::string> *style =
-      new std::map<std::string, std::string>();
+DefaultStyleTableRef RenderList::GetDefaultStyle() {
+  static const DefaultStyleTableRef kFlexStyle =
+      MakeDefaultStyleTable({{FLEX, "1"}});
 
   bool is_vertical = true;
   RenderObject *parent = static_cast<RenderObject *>(getParent());
@@ -82,13 +88,13 @@ std::map<std::string, std::string> *RenderList::GetDefaultStyle() {
 
   if (prop == HEIGHT && isnan(getStyleHeight()) && !this->is_set_flex_) {
     this->is_set_flex_ = true;
-    style->insert(std::pair<std::string, std::string>(FLEX, "1"));
+    return kFlexStyle;
   } else if (prop == WIDTH && isnan(TakeStyleWidth()) && !this->is_set_flex_) {
     this->is_set_flex_ = true;
-    style->insert(std::pair<std::string, std::string>(FLEX, "1"));
+    return kFlexStyle;
   }
 
-  return style;
+  return nullptr;
 }
 
 void RenderList::set_flex(const float flex) {
@@ -96,7 +102,7 @@ void RenderList::set_flex(const float flex) {
   WXCoreLayoutNode::set_flex(flex);
 }
 
-std::map<std::string, std::string> *RenderList::GetDefaultAttr() {
+DefaultStyleTableRef RenderList::GetDefaultAttr() {
   if (!this->is_pre_calculate_cell_width_) {
     PreCalculateCellWidth();
   }
@@ -280,12 +286,14 @@ void RenderList::AddRenderObjectWidth(RenderObject *child,
 void RenderList::AddAttr(std::string key, std::string value) {
   MapInsertOrAssign(&mOriginalAttrs, key, value);
   RenderObject::AddAttr(key, value);
+  UpdateLayoutWindow(key);
 }
 
 
 void RenderList::UpdateAttr(std::string key, std::string value) {
   MapInsertOrAssign(&mOriginalAttrs, key, value);
   RenderObject::UpdateAttr(key, value);
+  UpdateLayoutWindow(key);
 
   if (!GetAttr(COLUMN_COUNT).empty() || !GetAttr(COLUMN_GAP).empty() ||
       !GetAttr(COLUMN_WIDTH).empty()) {
@@ -303,9 +311,17 @@ void RenderList::UpdateAttr(std::string key, std::string value) {
   }
 }
 
-static const std::string GetMapAttr(std::map<std::string,std::string>* attrs,  const std::string &key) {
+bool RenderList::IsAttrUnchanged(const std::string &key,
+                                 const std::string &value) {
+  // Column attributes hold computed values, so compare what was set too.
+  SmallStringMap::iterator iter = mOriginalAttrs.find(key);
+  return iter != mOriginalAttrs.end() && iter->second == value &&
+         RenderObject::IsAttrUnchanged(key, value);
+}
+
+static const std::string GetMapAttr(SmallStringMap* attrs,  const std::string &key) {
   if (attrs == nullptr) return "";
-  std::map<std::string, std::string>::iterator iter = attrs->find(key);
+  SmallStringMap::iterator iter = attrs->find(key);
   if (iter != attrs->end()) {
     return iter->second;
   } else {
@@ -371,6 +387,151 @@ float RenderList::TakeRightGap() {
   return (right_gap_value > 0 && !isnan(right_gap_value)) ? right_gap_value : 0;
 }
 
+bool RenderList::SetScrollOffset(float offset) {
+  this->scroll_offset_ = offset;
+  if (!getDefersChildLayout() ||
+      fabs(offset - this->layout_window_offset_) <= Overscan() / 2) {
+    return false;
+  }
+  this->layout_window_offset_ = offset;
+  markDirty();
+  return true;
+}
+
+bool RenderList::isChildLayoutDeferred(WXCoreLayoutNode *child,
+                                       float mainOffset, float mainSize) {
+  RenderObject *cell = static_cast<RenderObject *>(child);
+  if (cell->type() == kRenderHeader || cell->type() == kRenderFooter ||
+      cell->is_sticky()) {
+    return false;
+  }
+  if (this->column_count_ > 1) {
+    // Waterfall cells share the main axis between columns.
+    mainOffset /= this->column_count_;
+  }
+  float overscan = Overscan();
+  return mainOffset + mainSize < this->layout_window_offset_ - overscan ||
+         mainOffset > this->layout_window_offset_ + ViewportLength() + overscan;
+}
+
+float RenderList::estimatedChildMainSize() const {
+  return isnan(this->estimated_cell_size_) ? ViewportLength() / 4
+                                           : this->estimated_cell_size_;
+}
+
+void RenderList::UpdateLayoutWindow(const std::string &key) {
+  if (key != LAYOUT_WINDOW && key != LAYOUT_OVERSCAN &&
+      key != ESTIMATED_CELL_SIZE) {
+    return;
+  }
+  this->layout_overscan_ = TakeLayoutLength(LAYOUT_OVERSCAN);
+  this->estimated_cell_size_ = TakeLayoutLength(ESTIMATED_CELL_SIZE);
+  this->layout_window_offset_ = this->scroll_offset_;
+  setDefersChildLayout(GetMapAttr(&mOriginalAttrs, LAYOUT_WINDOW) == "true");
+  markDirty();
+}
+
+float RenderList::TakeLayoutLength(const std::string &key) {
+  std::string length = GetMapAttr(&mOriginalAttrs, key);
+  if (length.empty()) {
+    return NAN;
+  }
+  float value = getFloatByViewport(
+      length, RenderManager::GetInstance()->viewport_width(page_id()),
+      RenderManager::GetInstance()->DeviceWidth(page_id()),
+      RenderManager::GetInstance()->round_off_deviation(page_id()));
+  return value >= 0 ? value : NAN;
+}
+
+float RenderList::ViewportLength() const {
+  bool horizontal = getFlexDirection() == kFlexDirectionRow ||
+                    getFlexDirection() == kFlexDirectionRowReverse;
+  float length = horizontal ? getLayoutWidth() : getLayoutHeight();
+  if (isnan(length) || length <= 0) {
+    length = horizontal ? WXCoreEnvironment::getInstance()->DeviceWidth()
+                        : WXCoreEnvironment::getInstance()->DeviceHeight();
+  }
+  return length;
+}
+
+float RenderList::Overscan() const {
+  return isnan(this->layout_overscan_) ? ViewportLength()
+                                       : this->layout_overscan_;
+}
+
+static void AppendBytes(const void *data, size_t length, std::string &out) {
+  out.append(static_cast<const char *>(data), length);
+}
+
+static void AppendString(const std::string &value, std::string &out) {
+  size_t length = value.length();
+  AppendBytes(&length, sizeof(length), out);
+  out.append(value);
+}
+
+static void AppendStringMap(const SmallStringMap &map, std::string &out) {
+  size_t count = map.size();
+  AppendBytes(&count, sizeof(count), out);
+  for (const auto &entry : map) {
+    AppendString(entry.first, out);
+    AppendString(entry.second, out);
+  }
+}
+
+// Everything that can change the layout of a cell subtree: the template
+// values it was copied from, its layout styles, the styles and attributes
+// bound on it and its shape. Template values never change once copied and
+// their serial is never reused, so a changed template gets new keys.
+static void AppendCellLayoutInputs(RenderObject *cell, std::string &out) {
+  for (TreeWalker<RenderObject> walker(cell); !walker.Done(); walker.Next()) {
+    RenderObject *render = walker.node();
+    uint64_t prototype =
+        render->prototype() != nullptr ? render->prototype()->serial : 0;
+    Index child_count = render->getChildCount();
+    AppendBytes(&prototype, sizeof(prototype), out);
+    render->appendLayoutStyle(out);
+    AppendStringMap(*render->styles(), out);
+    AppendStringMap(*render->attributes(), out);
+    AppendBytes(&child_count, sizeof(child_count), out);
+  }
+}
+
+void RenderList::LayoutCell(RenderObject *cell,
+                            const std::pair<float, float> &size) {
+  // Cached layouts are keyed by a hash of their inputs and keep the inputs
+  // themselves, so a hash collision is caught instead of applying the
+  // frames of another cell.
+  std::string &inputs = this->cell_layout_inputs_;
+  inputs.clear();
+  AppendBytes(&size.first, sizeof(size.first), inputs);
+  AppendBytes(&size.second, sizeof(size.second), inputs);
+  AppendCellLayoutInputs(cell, inputs);
+  uint64_t key = HashBytes(inputs.data(), inputs.size());
+
+  auto cached = this->cell_layout_cache_.find(key);
+  if (cached != this->cell_layout_cache_.end() &&
+      cached->second.inputs == inputs) {
+    const std::vector<WXCorelayoutResult> &results = cached->second.results;
+    size_t index = 0;
+    for (TreeWalker<RenderObject> walker(cell); !walker.Done(); walker.Next()) {
+      walker.node()->restoreLayoutResult(results[index++]);
+    }
+  } else {
+    cell->LayoutBeforeImpl();
+    cell->calculateLayout(size);
+    if (this->cell_layout_cache_.size() >= kCellLayoutCacheCapacity) {
+      this->cell_layout_cache_.clear();
+    }
+    CellLayout &layout = this->cell_layout_cache_[key];
+    layout.inputs = inputs;
+    layout.results.clear();
+    for (TreeWalker<RenderObject> walker(cell); !walker.Done(); walker.Next()) {
+      layout.results.push_back(walker.node()->layoutResult());
+    }
+  }
+  cell->LayoutAfterImpl();
+}
+
 int RenderList::TakeOrientation() {
   std::string direction = GetAttr(SCROLL_DIRECTION);
   if (HORIZONTAL == direction) {
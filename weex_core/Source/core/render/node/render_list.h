@@ -21,6 +21,8 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "core/css/constants_value.h"
@@ -36,9 +38,9 @@ class RenderList : public RenderObject {
 
   void AddCellSlotCopyTrack(RenderObject *cell_slot);
 
-  std::map<std::string, std::string> *GetDefaultStyle() override;
+  DefaultStyleTableRef GetDefaultStyle() override;
 
-  std::map<std::string, std::string> *GetDefaultAttr() override;
+  DefaultStyleTableRef GetDefaultAttr() override;
 
   void PreCalculateCellWidth();
 
@@ -54,6 +56,9 @@ class RenderList : public RenderObject {
 
   void UpdateAttr(std::string key, std::string value) override;
 
+  bool IsAttrUnchanged(const std::string &key,
+                       const std::string &value) override;
+
   float TakeColumnCount();
 
   float TakeColumnGap();
@@ -74,7 +79,41 @@ class RenderList : public RenderObject {
 
   inline std::vector<RenderObject *> &CellSlots() { return cell_slots_; }
 
+  /**
+   * Scroll offset reported by the platform, in layout pixels. With the
+   * layoutWindow attribute set, only cells near this offset are laid out;
+   * returns true if the window moved and the list needs a new layout pass.
+   */
+  bool SetScrollOffset(float offset);
+
+  /**
+   * Lays out a recycle-list cell, or a copy of one, for the platform. Cells
+   * built from the same template with the same bound data and width reuse the
+   * result of the first one.
+   */
+  void LayoutCell(RenderObject *cell, const std::pair<float, float> &size);
+
+ protected:
+  bool isChildLayoutDeferred(WXCoreLayoutNode *child, float mainOffset,
+                             float mainSize) override;
+
+  float estimatedChildMainSize() const override;
+
  private:
+  // A cell layout and the inputs it was computed from.
+  struct CellLayout {
+    std::string inputs;
+    std::vector<WXCorelayoutResult> results;
+  };
+
+  void UpdateLayoutWindow(const std::string &key);
+
+  float TakeLayoutLength(const std::string &key);
+
+  float ViewportLength() const;
+
+  float Overscan() const;
+
   bool is_pre_calculate_cell_width_ = false;
   int column_count_ = COLUMN_COUNT_NORMAL;
   float column_width_ = AUTO_VALUE;
@@ -85,7 +124,14 @@ class RenderList : public RenderObject {
   std::vector<RenderObject *> cell_slots_copys_;
   float left_gap_ = 0;
   float right_gap_ = 0;
-  std::map<std::string,std::string> mOriginalAttrs;
+  SmallStringMap mOriginalAttrs;
+  float scroll_offset_ = 0;
+  float layout_window_offset_ = 0;
+  float layout_overscan_ = NAN;
+  float estimated_cell_size_ = NAN;
+  std::unordered_map<uint64_t, CellLayout> cell_layout_cache_;
+  // Reused to gather the inputs of each cell laid out.
+  std::string cell_layout_inputs_;
 
 };
 }  // namespace WeexCore
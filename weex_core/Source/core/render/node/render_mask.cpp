@@ -27,9 +27,9 @@
 
 namespace WeexCore {
 
-std::map<std::string, std::string> *RenderMask::GetDefaultStyle() {
-  std::map<std::string, std::string> *style =
-      new std::map<std::string, std::string>();
+DefaultStyleTableRef RenderMask::GetDefaultStyle() {
+  // Keyed by the mask size in web pixels.
+  static DefaultStyleTableCache<std::pair<float, float>> cache;
 
   int width = WXCoreEnvironment::getInstance()->DeviceWidth();
   int height = WXCoreEnvironment::getInstance()->DeviceHeight();
@@ -57,12 +57,16 @@ std::map<std::string, std::string> *RenderMask::GetDefaultStyle() {
   }
 #endif
 
-  style->insert(std::pair<std::string, std::string>(POSITION, "absolute"));
-  style->insert(std::pair<std::string, std::string>(
-      WIDTH, to_string(getWebPxByWidth(width, RenderManager::GetInstance()->viewport_width(page_id()), RenderManager::GetInstance()->DeviceWidth(page_id())))));
-  style->insert(std::pair<std::string, std::string>(
-      HEIGHT, to_string(getWebPxByWidth(height, RenderManager::GetInstance()->viewport_width(page_id()), RenderManager::GetInstance()->DeviceWidth(page_id())))));
-  style->insert(std::pair<std::string, std::string>(TOP, "0"));
-  return style;
+  float viewport_width = RenderManager::GetInstance()->viewport_width(page_id());
+  float device_width = RenderManager::GetInstance()->DeviceWidth(page_id());
+  float web_width = getWebPxByWidth(width, viewport_width, device_width);
+  float web_height = getWebPxByWidth(height, viewport_width, device_width);
+
+  return cache.Get(std::make_pair(web_width, web_height), [=]() {
+    return DefaultStyleTable::Entries{{POSITION, "absolute"},
+                                      {WIDTH, to_string(web_width)},
+                                      {HEIGHT, to_string(web_height)},
+                                      {TOP, "0"}};
+  });
 }
 }  // namespace WeexCore
@@ -28,7 +28,7 @@ namespace WeexCore {
 
 class RenderMask : public RenderObject {
  public:
-  std::map<std::string, std::string> *GetDefaultStyle();
+  DefaultStyleTableRef GetDefaultStyle() override;
 };
 }  // namespace WeexCore
 #endif  // CORE_RENDER_NODE_RENDER_MASK_H_
@@ -19,22 +19,25 @@
 
 #include "core/render/node/render_object.h"
 #include <math.h>
+#include <atomic>
 
 #include "core/common/view_utils.h"
 #include "core/css/constants_name.h"
 #include "core/css/constants_value.h"
 #include "core/css/css_value_getter.h"
 #include "core/layout/layout.h"
+#include "core/layout/tree_walker.h"
 #include "core/manager/weex_core_manager.h"
 #include "core/render/manager/render_manager.h"
+#include "core/render/page/render_arena.h"
 #include "core/render/page/render_page.h"
 
 namespace WeexCore {
 
 RenderObject::RenderObject() : parent_render_(nullptr) {
-  this->styles_ = new std::map<std::string, std::string>();
-  this->attributes_ = new std::map<std::string, std::string>();
-  this->events_ = new std::set<std::string>();
+  this->styles_ = RenderArena::New<SmallStringMap>();
+  this->attributes_ = RenderArena::New<SmallStringMap>();
+  this->events_ = RenderArena::New<SmallStringSet>();
   this->is_root_render_ = false;
 }
 
@@ -42,25 +45,32 @@ RenderObject::~RenderObject() {
   this->parent_render_ = nullptr;
 
   if (this->styles_ != nullptr) {
-    delete this->styles_;
+    RenderArena::Delete(this->styles_);
     this->styles_ = nullptr;
   }
 
   if (this->attributes_ != nullptr) {
-    delete this->attributes_;
+    RenderArena::Delete(this->attributes_);
     this->attributes_ = nullptr;
   }
 
   if (this->events_ != nullptr) {
-    delete this->events_;
+    RenderArena::Delete(this->events_);
     this->events_ = nullptr;
   }
 
-  for (auto it = ChildListIterBegin(); it != ChildListIterEnd(); it++) {
-    RenderObject *child = static_cast<RenderObject *>(*it);
-    if (child != nullptr) {
-      delete child;
+  // Free the subtree bottom-up without recursing, so that destroying a very
+  // deep tree cannot overflow the stack.
+  if (getChildCount() > 0) {
+    for (TreeWalker<RenderObject> walker(this, 0, true); !walker.Done();
+         walker.Next()) {
+      RenderObject *node = walker.node();
+      if (walker.leaving() && node != this) {
+        node->removeAllChildren();
+        delete node;
+      }
     }
+    removeAllChildren();
   }
 
   for (auto it : shadow_objects_) {
@@ -68,39 +78,37 @@ RenderObject::~RenderObject() {
   }
 }
 
+void *RenderObject::operator new(size_t size) {
+  return RenderArena::Allocate(size);
+}
+
+void RenderObject::operator delete(void *ptr) { RenderArena::Free(ptr); }
+
 void RenderObject::ApplyDefaultStyle(bool reserve) {
-  std::map<std::string, std::string> *style = GetDefaultStyle();
+  DefaultStyleTableRef style = GetDefaultStyle();
 
   if (style == nullptr) return;
 
-  for (auto iter = style->cbegin(); iter != style->cend(); iter++)
-    AddStyle(iter->first, iter->second, reserve);
-
-  if (style != nullptr) {
-    delete style;
-  }
+  for (const auto &entry : style->entries())
+    AddStyle(entry.first, entry.second, reserve);
 }
 
 RenderObject* RenderObject::RichtextParent() {
-    if (parent_render_ && parent_render_->type() == "richtext") {
-        return parent_render_;
-    } else if (parent_render_) {
-        return parent_render_->RichtextParent();
+    for (RenderObject *p = parent_render_; p; p = p->parent_render_) {
+        if (p->type() == "richtext") {
+            return p;
+        }
     }
     return nullptr;
 }
 
 void RenderObject::ApplyDefaultAttr() {
-  std::map<std::string, std::string> *attrs = GetDefaultAttr();
+  DefaultStyleTableRef attrs = GetDefaultAttr();
 
   if (attrs == nullptr) return;
 
-  for (auto iter = attrs->cbegin(); iter != attrs->cend(); iter++) {
-    UpdateAttr(iter->first, iter->second);
-  }
-
-  if (attrs != nullptr) {
-    delete attrs;
+  for (const auto &entry : attrs->entries()) {
+    UpdateAttr(entry.first, entry.second);
   }
 }
 
@@ -317,26 +325,15 @@ StyleType RenderObject::ApplyStyle(const std::string &key,
 }
 
 const std::string RenderObject::GetStyle(const std::string &key) {
-  if (this->styles_ == nullptr) return "";
-
-  std::map<std::string, std::string>::iterator iter = this->styles_->find(key);
-  if (iter != this->styles_->end()) {
-    return iter->second;
-  } else {
-    return "";
-  }
+  const SmallStringMap::value_type *entry =
+      FindValue(&RenderObject::styles_, &PrototypeValues::styles, key);
+  return entry != nullptr ? entry->second : "";
 }
 
 const std::string RenderObject::GetAttr(const std::string &key) {
-  if (this->attributes_ == nullptr) return "";
-
-  std::map<std::string, std::string>::iterator iter =
-      this->attributes_->find(key);
-  if (iter != this->attributes_->end()) {
-    return iter->second;
-  } else {
-    return "";
-  }
+  const SmallStringMap::value_type *entry =
+      FindValue(&RenderObject::attributes_, &PrototypeValues::attributes, key);
+  return entry != nullptr ? entry->second : "";
 }
 
 bool RenderObject::hasShadow(const RenderObject* shadow) const {
@@ -392,27 +389,29 @@ Index RenderObject::IndexOf(const RenderObject *render) {
 bool RenderObject::UpdateStyleInternal(const std::string key,
                                        const std::string value, float fallback,
                                        std::function<void(float)> functor) {
-  bool ret = false;
+  float fvalue;
+  if (!ParseStyleFloat(value, fallback, &fvalue)) return false;
+  functor(fvalue);
+  return true;
+}
+
+bool RenderObject::ParseStyleFloat(const std::string &value, float fallback,
+                                   float *result) {
   if (value.empty()) {
-    functor(fallback);
-    ret = true;
-  } else {
-    float fvalue = getFloatByViewport(value,
-                                      RenderManager::GetInstance()->viewport_width(page_id()),
-                                      RenderManager::GetInstance()->DeviceWidth(page_id()),
+    *result = fallback;
+    return true;
+  }
+  *result = getFloatByViewport(value,
+                               RenderManager::GetInstance()->viewport_width(page_id()),
+                               RenderManager::GetInstance()->DeviceWidth(page_id()),
 #if OS_IOS
-                                      // reduce a map search on iOS
-                                      false
+                               // reduce a map search on iOS
+                               false
 #else
-                                      RenderManager::GetInstance()->round_off_deviation(page_id())
+                               RenderManager::GetInstance()->round_off_deviation(page_id())
 #endif
-                                      );
-    if (!isnan(fvalue)) {
-      functor(fvalue);
-      ret = true;
-    }
-  }
-  return ret;
+                               );
+  return !isnan(*result);
 }
 
 void RenderObject::LayoutBeforeImpl() {
@@ -433,6 +432,8 @@ void RenderObject::LayoutPlatformImpl() {
     OnLayoutPlatform();
   }
 
+  if (isLayoutDeferred()) return;
+
   for (auto it = ChildListIterBegin(); it != ChildListIterEnd(); it++) {
     RenderObject *child = static_cast<RenderObject *>(*it);
     if (child != nullptr) {
@@ -446,6 +447,8 @@ void RenderObject::LayoutAfterImpl() {
     OnLayoutAfter(getLayoutWidth(), getLayoutHeight());
   }
 
+  if (isLayoutDeferred()) return;
+
   for (auto it = ChildListIterBegin(); it != ChildListIterEnd(); it++) {
     RenderObject *child = static_cast<RenderObject *>(*it);
     if (child != nullptr) {
@@ -456,20 +459,34 @@ void RenderObject::LayoutAfterImpl() {
 
 void RenderObject::CopyFrom(RenderObject *src) {
   IRenderObject::CopyFrom(src);
-  this->styles_->insert(src->styles_->begin(), src->styles_->end());
-  this->attributes_->insert(src->attributes_->begin(), src->attributes_->end());
   this->events_->insert(src->events_->begin(), src->events_->end());
+  if (src->prototype_ != nullptr) {
+    // A copy of a copy shares the same prototype and starts from its
+    // overrides.
+    this->prototype_ = src->prototype_;
+    this->styles_->insert(src->styles_->begin(), src->styles_->end());
+    this->attributes_->insert(src->attributes_->begin(),
+                              src->attributes_->end());
+    return;
+  }
+  if (src->values_for_copies_ == nullptr) {
+    static std::atomic<uint64_t> serial(0);
+    PrototypeValues *values = new PrototypeValues();
+    values->styles.insert(src->styles_->begin(), src->styles_->end());
+    values->attributes.insert(src->attributes_->begin(),
+                              src->attributes_->end());
+    values->serial = ++serial;
+    src->values_for_copies_.reset(values);
+  }
+  this->prototype_ = src->values_for_copies_;
 }
 
-void RenderObject::MapInsertOrAssign(
-    std::map<std::string, std::string> *targetMap, const std::string &key,
-    const std::string &value) {
-  std::map<std::string, std::string>::iterator it = targetMap->find(key);
-  if (it != targetMap->end()) {
-    it->second = value;
-  } else {
-    targetMap->insert({key, value});
-  }
+void RenderObject::MapInsertOrAssign(SmallStringMap *targetMap,
+                                     const std::string &key,
+                                     const std::string &value) {
+  targetMap->InsertOrAssign(key, value);
+  // Copies made from here on take the new value, earlier ones keep theirs.
+  this->values_for_copies_.reset();
 }
 
 bool RenderObject::ViewInit() {
@@ -497,6 +514,163 @@ void RenderObject::UpdateAttr(std::string key, std::string value) {
 StyleType RenderObject::UpdateStyle(std::string key, std::string value) {
   return ApplyStyle(key, value, true);
 }
+
+static inline bool IsSameFloat(float a, float b) {
+  return a == b || (isnan(a) && isnan(b));
+}
+
+// Mirrors ApplyStyle: a value it would ignore counts as unchanged.
+bool RenderObject::IsStyleUnchanged(const std::string &key,
+                                    const std::string &value) {
+  if (value.length() > 0 && (value.at(0) == JSON_OBJECT_MARK_CHAR ||
+                             value.at(0) == JSON_ARRAY_MARK_CHAR)) {
+    return HoldsValue(&RenderObject::styles_, &PrototypeValues::styles, key,
+                      value);
+  }
+
+  float fvalue;
+  if (key == ALIGN_ITEMS) {
+    return getAlignItems() == GetWXCoreAlignItem(value);
+  } else if (key == ALIGN_SELF) {
+    return getAlignSelf() == GetWXCoreAlignSelf(value);
+  } else if (key == FLEX) {
+    fvalue = value.empty() ? 0 : getFloat(value.c_str());
+    return isnan(fvalue) || fvalue == getFlex();
+  } else if (key == DIRECTION) {
+    WXCoreDirection direction = GetWXCoreDirection(value);
+    if (direction == kDirectionInherit && this->is_root_render_) {
+      direction = kDirectionLTR;
+    }
+    return getDirection() == direction;
+  } else if (key == FLEX_DIRECTION) {
+    return getFlexDirection() == GetWXCoreFlexDirection(value);
+  } else if (key == JUSTIFY_CONTENT) {
+    return getJustifyContent() == GetWXCoreJustifyContent(value);
+  } else if (key == FLEX_WRAP) {
+    return getFlexWrap() == GetWXCoreFlexWrap(value);
+  }
+
+  float current;
+  float fallback = NAN;
+  if (key == MIN_WIDTH) {
+    current = getMinWidth();
+  } else if (key == MIN_HEIGHT) {
+    current = getMinHeight();
+  } else if (key == MAX_WIDTH) {
+    current = getMaxWidth();
+  } else if (key == MAX_HEIGHT) {
+    current = getMaxHeight();
+  } else if (key == HEIGHT) {
+    if (!ParseStyleFloat(value, NAN, &fvalue)) return true;
+    return IsSameFloat(fvalue, getStyleHeight()) &&
+           getStyleHeightLevel() == CSS_STYLE;
+  } else if (key == WIDTH) {
+    if (!ParseStyleFloat(value, NAN, &fvalue)) return true;
+    return IsSameFloat(fvalue, getStyleWidth()) &&
+           getStyleWidthLevel() == CSS_STYLE;
+  } else if (key == LEFT) {
+    current = getStylePositionLeft();
+  } else if (key == TOP) {
+    current = getStylePositionTop();
+  } else if (key == RIGHT) {
+    current = getStylePositionRight();
+  } else if (key == BOTTOM) {
+    current = getStylePositionBottom();
+  } else if (key == MARGIN || key == PADDING || key == BORDER_WIDTH) {
+    if (!ParseStyleFloat(value, 0, &fvalue)) return true;
+    if (key == MARGIN) {
+      return IsSameFloat(fvalue, getMarginLeft()) &&
+             IsSameFloat(fvalue, getMarginTop()) &&
+             IsSameFloat(fvalue, getMarginRight()) &&
+             IsSameFloat(fvalue, getMarginBottom());
+    } else if (key == PADDING) {
+      return IsSameFloat(fvalue, getPaddingLeft()) &&
+             IsSameFloat(fvalue, getPaddingTop()) &&
+             IsSameFloat(fvalue, getPaddingRight()) &&
+             IsSameFloat(fvalue, getPaddingBottom());
+    }
+    return IsSameFloat(fvalue, getBorderWidthLeft()) &&
+           IsSameFloat(fvalue, getBorderWidthTop()) &&
+           IsSameFloat(fvalue, getBorderWidthRight()) &&
+           IsSameFloat(fvalue, getBorderWidthBottom());
+  } else if (key == MARGIN_LEFT) {
+    current = getMarginLeft();
+    fallback = 0;
+  } else if (key == MARGIN_TOP) {
+    current = getMarginTop();
+    fallback = 0;
+  } else if (key == MARGIN_RIGHT) {
+    current = getMarginRight();
+    fallback = 0;
+  } else if (key == MARGIN_BOTTOM) {
+    current = getMarginBottom();
+    fallback = 0;
+  } else if (key == BORDER_TOP_WIDTH) {
+    current = getBorderWidthTop();
+    fallback = 0;
+  } else if (key == BORDER_RIGHT_WIDTH) {
+    current = getBorderWidthRight();
+    fallback = 0;
+  } else if (key == BORDER_BOTTOM_WIDTH) {
+    current = getBorderWidthBottom();
+    fallback = 0;
+  } else if (key == BORDER_LEFT_WIDTH) {
+    current = getBorderWidthLeft();
+    fallback = 0;
+  } else if (key == PADDING_LEFT) {
+    current = getPaddingLeft();
+    fallback = 0;
+  } else if (key == PADDING_TOP) {
+    current = getPaddingTop();
+    fallback = 0;
+  } else if (key == PADDING_RIGHT) {
+    current = getPaddingRight();
+    fallback = 0;
+  } else if (key == PADDING_BOTTOM) {
+    current = getPaddingBottom();
+    fallback = 0;
+  } else {
+    // Position and all non-layout styles are kept as strings.
+    return HoldsValue(&RenderObject::styles_, &PrototypeValues::styles, key,
+                      value);
+  }
+  if (!ParseStyleFloat(value, fallback, &fvalue)) return true;
+  return IsSameFloat(fvalue, current);
+}
+
+bool RenderObject::IsAttrUnchanged(const std::string &key,
+                                   const std::string &value) {
+  return HoldsValue(&RenderObject::attributes_, &PrototypeValues::attributes,
+                    key, value);
+}
+
+bool RenderObject::HoldsStyle(const std::string &key,
+                              const std::string &value) const {
+  return HoldsValue(&RenderObject::styles_, &PrototypeValues::styles, key,
+                    value);
+}
+
+bool RenderObject::HoldsValue(SmallStringMap *RenderObject::*map,
+                              SmallStringMap PrototypeValues::*prototype_map,
+                              const std::string &key,
+                              const std::string &value) const {
+  const SmallStringMap::value_type *entry = FindValue(map, prototype_map, key);
+  return entry != nullptr && entry->second == value;
+}
+
+const SmallStringMap::value_type *RenderObject::FindValue(
+    SmallStringMap *RenderObject::*map,
+    SmallStringMap PrototypeValues::*prototype_map,
+    const std::string &key) const {
+  const SmallStringMap *values = this->*map;
+  if (values == nullptr) return nullptr;
+  SmallStringMap::const_iterator iter = values->find(key);
+  if (iter != values->end()) return iter;
+  if (this->prototype_ == nullptr) return nullptr;
+  values = &(this->prototype_.get()->*prototype_map);
+  iter = values->find(key);
+  return iter != values->end() ? iter : nullptr;
+}
   
 void RenderObject::MergeStyles(std::vector<std::pair<std::string, std::string>> *src) {
   if (src) {
@@ -529,7 +703,8 @@ void RenderObject::AddAttr(std::string key, std::string value) {
   MapInsertOrAssign(this->attributes_, key, value);
 }
 
-StyleType RenderObject::AddStyle(std::string key, std::string value, bool reserve) {
+StyleType RenderObject::AddStyle(const std::string &key,
+                                 const std::string &value, bool reserve) {
   if (reserve) {
     MapInsertOrAssign(styles_, key, value);
   }
@@ -538,7 +713,7 @@ StyleType RenderObject::AddStyle(std::string key, std::string value, bool reserv
 
 void RenderObject::AddEvent(std::string event) {
   if (this->events_ == nullptr) {
-    this->events_ = new std::set<std::string>();
+    this->events_ = RenderArena::New<SmallStringSet>();
   }
   this->events_->insert(event);
 }
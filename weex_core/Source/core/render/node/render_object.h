@@ -19,11 +19,15 @@
 #ifndef CORE_RENDER_NODE_RENDER_OBJECT_H_
 #define CORE_RENDER_NODE_RENDER_OBJECT_H_
 
+#include <stdint.h>
 #include <functional>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 
+#include "core/common/small_string_map.h"
+#include "core/render/node/default_style_table.h"
 #include "core/render/node/factory/render_object_interface.h"
 
 #define JSON_OBJECT_MARK_CHAR '{'
@@ -52,40 +56,59 @@ class RenderObject : public IRenderObject {
   friend class RenderPage;
 
  public:
+  // Styles and attributes of a template as they were when it was copied,
+  // shared by its copies. A template that changes afterwards starts a new
+  // one, so copies keep what they were copied from and never depend on the
+  // template staying alive.
+  struct PrototypeValues {
+    SmallStringMap styles;
+    SmallStringMap attributes;
+    // Distinct for every PrototypeValues made by the process.
+    uint64_t serial;
+  };
+
   void LayoutBeforeImpl();
 
   void LayoutPlatformImpl();
     
   void LayoutAfterImpl();
 
+  // The copy shares |src|'s current styles and attributes through a
+  // PrototypeValues: its own maps only hold what is set on it afterwards.
   void CopyFrom(RenderObject *src);
 
   RenderObject* RichtextParent();
 
   bool hasShadow(const RenderObject* shadow) const;
 
-  void MapInsertOrAssign(std::map<std::string, std::string> *targetMap,
-                         const std::string &key, const std::string &value);
+  void MapInsertOrAssign(SmallStringMap *targetMap, const std::string &key,
+                         const std::string &value);
 
   bool ViewInit();
 
-  virtual std::map<std::string, std::string> *GetDefaultStyle() {
-    return nullptr;
-  }
+  virtual DefaultStyleTableRef GetDefaultStyle() { return nullptr; }
 
-  virtual std::map<std::string, std::string> *GetDefaultAttr() {
-    return nullptr;
-  }
+  virtual DefaultStyleTableRef GetDefaultAttr() { return nullptr; }
 
  protected:
   bool UpdateStyleInternal(const std::string key, const std::string value,
                            float fallback, std::function<void(float)> functor);
 
+  // The number UpdateStyleInternal would apply for |value|, false if it
+  // would leave the style alone.
+  bool ParseStyleFloat(const std::string &value, float fallback,
+                       float *result);
+
  public:
   RenderObject();
 
   virtual ~RenderObject();
 
+  // Render objects live in the arena of the page being built, if any.
+  static void *operator new(size_t size);
+
+  static void operator delete(void *ptr);
+
   void BindMeasureFunc();
 
   void OnLayoutBefore();
@@ -116,6 +139,17 @@ class RenderObject : public IRenderObject {
   virtual void UpdateAttr(std::string key, std::string value);
 
   virtual StyleType UpdateStyle(std::string key, std::string value);
+
+  // True if UpdateStyle/UpdateAttr with this pair would leave the node as it
+  // is. Layout styles are compared by their parsed values.
+  virtual bool IsStyleUnchanged(const std::string &key,
+                                const std::string &value);
+
+  virtual bool IsAttrUnchanged(const std::string &key,
+                               const std::string &value);
+
+  // True if |value| is the raw string stored for |key|.
+  bool HoldsStyle(const std::string &key, const std::string &value) const;
   
   void MergeStyles(std::vector<std::pair<std::string, std::string>> *src);
 
@@ -127,7 +161,8 @@ class RenderObject : public IRenderObject {
 
   virtual void AddAttr(std::string key, std::string value);
 
-  StyleType AddStyle(std::string key, std::string value, bool reserve);
+  StyleType AddStyle(const std::string &key, const std::string &value,
+                     bool reserve);
 
   void AddEvent(std::string event);
 
@@ -142,15 +177,18 @@ class RenderObject : public IRenderObject {
 
   const std::vector<RenderObject*>& get_shadow_objects() const {return shadow_objects_;}
 
-  inline std::map<std::string, std::string> *styles() const {
-    return this->styles_;
-  }
+  // For a copy these hold only its overrides; GetStyle/GetAttr also look at
+  // the prototype.
+  inline SmallStringMap *styles() const { return this->styles_; }
 
-  inline std::map<std::string, std::string> *attributes() const {
-    return this->attributes_;
-  }
+  inline SmallStringMap *attributes() const { return this->attributes_; }
 
-  inline std::set<std::string> *events() const { return this->events_; }
+  inline SmallStringSet *events() const { return this->events_; }
+
+  // Null unless this is a copy.
+  inline const PrototypeValues *prototype() const {
+    return this->prototype_.get();
+  }
 
   inline void set_is_root_render() { this->is_root_render_ = true; }
 
@@ -162,15 +200,39 @@ class RenderObject : public IRenderObject {
 
   void set_is_richtext_child(const bool is_richtext_child) {is_richtext_child_ = is_richtext_child;}
 
+  // Set once styles went to the platform as a transition without being
+  // applied here, after which the stored styles may be stale.
+  inline bool has_transition_update() const { return has_transition_update_; }
+
+  inline void set_has_transition_update() { has_transition_update_ = true; }
+
+ private:
+  bool HoldsValue(SmallStringMap *RenderObject::*map,
+                  SmallStringMap PrototypeValues::*prototype_map,
+                  const std::string &key, const std::string &value) const;
+
+  const SmallStringMap::value_type *FindValue(
+      SmallStringMap *RenderObject::*map,
+      SmallStringMap PrototypeValues::*prototype_map,
+      const std::string &key) const;
+
  private:
   RenderObject *parent_render_;
   std::vector<RenderObject*> shadow_objects_;
-  std::map<std::string, std::string> *styles_;
-  std::map<std::string, std::string> *attributes_;
-  std::set<std::string> *events_;
+  SmallStringMap *styles_;
+  SmallStringMap *attributes_;
+  SmallStringSet *events_;
+  std::shared_ptr<const PrototypeValues> prototype_;
+  // Handed to copies of this node until its styles or attributes change.
+  std::shared_ptr<const PrototypeValues> values_for_copies_;
   bool is_root_render_;
   bool is_sticky_ = false;
   bool is_richtext_child_ = false;
+  bool has_transition_update_ = false;
+  // Bytes RenderPage counted for this node's styles and attributes, taken
+  // out again exactly when the node leaves the page.
+  uint32_t accounted_style_bytes_ = 0;
+  uint32_t accounted_attr_bytes_ = 0;
 };
 }  // namespace WeexCore
 #endif  // CORE_RENDER_NODE_RENDER_OBJECT_H_
@@ -24,9 +24,9 @@
 
 namespace WeexCore {
 
-std::map<std::string, std::string> *RenderScroller::GetDefaultStyle() {
-  std::map<std::string, std::string> *style =
-      new std::map<std::string, std::string>();
+DefaultStyleTableRef RenderScroller::GetDefaultStyle() {
+  static const DefaultStyleTableRef kFlexStyle =
+      MakeDefaultStyleTable({{FLEX, "1"}});
 
   bool is_vertical = true;
   RenderObject *parent = static_cast<RenderObject *>(getParent());
@@ -40,12 +40,12 @@ std::map<std::string, std::string> *RenderScroller::GetDefaultStyle() {
   std::string prop = is_vertical ? HEIGHT : WIDTH;
 
   if (prop == HEIGHT && isnan(getStyleHeight()) && !this->is_set_flex_) {
-    style->insert(std::pair<std::string, std::string>(FLEX, "1"));
+    return kFlexStyle;
   } else if (prop == WIDTH && isnan(getStyleWidth()) && !this->is_set_flex_) {
-    style->insert(std::pair<std::string, std::string>(FLEX, "1"));
+    return kFlexStyle;
   }
 
-  return style;
+  return nullptr;
 }
 
 void RenderScroller::set_flex(const float flex) {
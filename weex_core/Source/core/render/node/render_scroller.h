@@ -28,7 +28,7 @@ namespace WeexCore {
 class RenderScroller : public RenderObject {
   bool is_set_flex_ = false;
 
-  std::map<std::string, std::string> *GetDefaultStyle() override;
+  DefaultStyleTableRef GetDefaultStyle() override;
 
   void set_flex(const float flex) override;
 
@@ -0,0 +1,360 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "core/render/page/layout_cache.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <vector>
+
+#include "base/log_defines.h"
+#include "core/common/hash_util.h"
+#include "core/common/small_string_map.h"
+#include "core/css/constants_name.h"
+#include "core/layout/layout.h"
+#include "core/layout/tree_walker.h"
+#include "core/render/node/render_object.h"
+
+namespace WeexCore {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x434c5857;  // "WXLC"
+constexpr uint32_t kVersion = 2;
+constexpr char kSuffix[] = ".layout";
+constexpr char kTempSuffix[] = ".tmp";
+
+struct FileHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t record_size;
+  uint32_t node_count;
+  uint64_t key;
+};
+
+// Styles and attributes a platform measures text with. They do not live in
+// the layout style, so they are hashed on their own.
+const char *const kMeasuredKeys[] = {
+    FONT_SIZE,   FONT_STYLE,    FONT_WEIGHT,    FONT_FAMILY, LINE_HEIGHT,
+    TEXT_OVERFLOW, LETTER_SPACING, WHITE_SPACE, VALUE,       LINES};
+
+// Keys outlive the process, so everything goes through HashBytesStable, and
+// counts are hashed at a fixed width to match between 32- and 64-bit builds.
+uint64_t HashCount(size_t count, uint64_t hash) {
+  uint32_t fixed = static_cast<uint32_t>(count);
+  return HashBytesStable(&fixed, sizeof(fixed), hash);
+}
+
+uint64_t HashFloat(float value, uint64_t hash) {
+  return HashBytesStable(&value, sizeof(value), hash);
+}
+
+uint64_t HashString(const std::string &value, uint64_t hash) {
+  hash = HashCount(value.length(), hash);
+  return HashBytesStable(value.data(), value.length(), hash);
+}
+
+// The measured keys are all in the shared name vocabulary, so measured
+// entries are picked out by key address without a lookup per key.
+uint64_t HashMeasuredEntries(const SmallStringMap *map, uint64_t hash) {
+  static const std::vector<const std::string *> *keys = [] {
+    auto *keys = new std::vector<const std::string *>();
+    for (const char *key : kMeasuredKeys) {
+      keys->push_back(FindKnownName(key));
+    }
+    return keys;
+  }();
+  if (map == nullptr) return hash;
+  for (const auto &entry : *map) {
+    if (std::find(keys->begin(), keys->end(), &entry.first) != keys->end()) {
+      hash = HashString(entry.first, hash);
+      hash = HashString(entry.second, hash);
+    }
+  }
+  return hash;
+}
+
+size_t CountNodes(RenderObject *root) {
+  size_t count = 0;
+  for (TreeWalker<RenderObject> walker(root); !walker.Done(); walker.Next()) {
+    count++;
+  }
+  return count;
+}
+
+// A read-only mapping of one cache entry, empty unless the file holds a
+// complete entry for |key| with records laid out like this build's.
+class MappedEntry {
+ public:
+  MappedEntry(const std::string &path, uint64_t key) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat st;
+    if (fstat(fd, &st) == 0 &&
+        static_cast<size_t>(st.st_size) >= sizeof(FileHeader)) {
+      void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED) {
+        data_ = data;
+        size_ = st.st_size;
+      }
+    }
+    close(fd);
+    if (data_ == nullptr) return;
+
+    FileHeader header;
+    memcpy(&header, data_, sizeof(header));
+    if (header.magic != kMagic || header.version != kVersion ||
+        header.record_size != sizeof(WXCorelayoutResult) || header.key != key ||
+        size_ != sizeof(FileHeader) +
+                     header.node_count * sizeof(WXCorelayoutResult)) {
+      return;
+    }
+    node_count_ = header.node_count;
+  }
+
+  ~MappedEntry() {
+    if (data_ != nullptr) munmap(data_, size_);
+  }
+
+  inline size_t size() const { return size_; }
+
+  inline bool Fits(size_t node_count) const {
+    return node_count_ != 0 && node_count_ == node_count;
+  }
+
+  inline void Read(size_t index, WXCorelayoutResult *result) const {
+    memcpy(result,
+           static_cast<const char *>(data_) + sizeof(FileHeader) +
+               index * sizeof(WXCorelayoutResult),
+           sizeof(WXCorelayoutResult));
+  }
+
+ private:
+  MappedEntry(const MappedEntry &) = delete;
+  MappedEntry &operator=(const MappedEntry &) = delete;
+
+  void *data_ = nullptr;
+  size_t size_ = 0;
+  size_t node_count_ = 0;
+};
+
+}  // namespace
+
+LayoutCache::LayoutCache(const std::string &directory,
+                         size_t max_entry_count, size_t max_total_bytes)
+    : directory_(directory),
+      max_entry_count_(max_entry_count),
+      max_total_bytes_(max_total_bytes) {
+  if (mkdir(directory_.c_str(), 0700) != 0 && errno != EEXIST) {
+    LOGE("[LayoutCache] cannot create %s: %s", directory_.c_str(),
+         strerror(errno));
+    return;
+  }
+  DIR *dir = opendir(directory_.c_str());
+  if (dir == nullptr) return;
+
+  // Picks up the entries of earlier launches, ordered by when they were
+  // last used, and deletes temporary files a crash left behind.
+  std::vector<std::pair<time_t, Entry>> found;
+  while (struct dirent *item = readdir(dir)) {
+    std::string path = directory_ + "/" + item->d_name;
+    uint64_t key;
+    if (sscanf(item->d_name, "%16" SCNx64, &key) != 1) continue;
+    struct stat st;
+    if (path == PathFor(key) && stat(path.c_str(), &st) == 0) {
+      found.push_back(std::make_pair(
+          st.st_mtime, Entry{key, static_cast<size_t>(st.st_size)}));
+    } else if (path == PathFor(key) + kTempSuffix) {
+      unlink(path.c_str());
+    }
+  }
+  closedir(dir);
+
+  std::stable_sort(found.begin(), found.end(),
+                   [](const std::pair<time_t, Entry> &a,
+                      const std::pair<time_t, Entry> &b) {
+                     return a.first < b.first;
+                   });
+  for (const auto &item : found) {
+    Touch(item.second.key, item.second.bytes);
+  }
+  Evict();
+}
+
+uint64_t LayoutCache::HashTree(RenderObject *root,
+                               const std::pair<float, float> &page_size,
+                               float viewport_width, float device_width) {
+  if (root == nullptr) return 0;
+  // Layout styles are hashed as bytes, so a build whose styles or results
+  // differ in shape gets keys of its own.
+  uint64_t hash = HashCount(kVersion, kHashSeed);
+  hash = HashCount(sizeof(WXCoreCSSStyle), hash);
+  hash = HashCount(sizeof(WXCorelayoutResult), hash);
+  hash = HashFloat(page_size.first, hash);
+  hash = HashFloat(page_size.second, hash);
+  hash = HashFloat(viewport_width, hash);
+  hash = HashFloat(device_width, hash);
+
+  for (TreeWalker<RenderObject> walker(root); !walker.Done(); walker.Next()) {
+    RenderObject *node = walker.node();
+    // Windowed lists lay out part of their cells on each pass, and richtext
+    // measures content that is not part of the tree.
+    if (node->getDefersChildLayout() || !node->get_shadow_objects().empty() ||
+        node->type() == "richtext") {
+      return 0;
+    }
+    hash = HashString(node->type(), hash);
+    hash = HashCount(node->getChildCount(), hash);
+    hash = node->hashLayoutStyleStable(hash);
+    hash = HashMeasuredEntries(node->styles(), hash);
+    hash = HashMeasuredEntries(node->attributes(), hash);
+    // Copies of a list cell fall back to their prototype's values.
+    if (node->prototype() != nullptr) {
+      hash = HashMeasuredEntries(&node->prototype()->styles, hash);
+      hash = HashMeasuredEntries(&node->prototype()->attributes, hash);
+    }
+  }
+  // 0 means uncacheable.
+  return hash != 0 ? hash : 1;
+}
+
+bool LayoutCache::Restore(uint64_t key, RenderObject *root) {
+  std::string path = PathFor(key);
+  MappedEntry entry(path, key);
+  if (!entry.Fits(CountNodes(root))) return false;
+
+  WXCorelayoutResult result;
+  size_t index = 0;
+  for (TreeWalker<RenderObject> walker(root); !walker.Done(); walker.Next()) {
+    entry.Read(index++, &result);
+    walker.node()->restoreLayoutResult(result);
+  }
+  // The modification time orders entries by use on the next launch.
+  utimes(path.c_str(), nullptr);
+  Touch(key, entry.size());
+  return true;
+}
+
+size_t LayoutCache::Validate(uint64_t key, RenderObject *root) const {
+  size_t node_count = CountNodes(root);
+  MappedEntry entry(PathFor(key), key);
+  if (!entry.Fits(node_count)) return node_count;
+
+  WXCorelayoutResult stored;
+  size_t index = 0;
+  size_t changed = 0;
+  for (TreeWalker<RenderObject> walker(root); !walker.Done(); walker.Next()) {
+    RenderObject *node = walker.node();
+    entry.Read(index++, &stored);
+    if (stored.mLayoutDirection == node->layoutResult().mLayoutDirection &&
+        stored.mLayoutSize.width == node->getLayoutWidth() &&
+        stored.mLayoutSize.height == node->getLayoutHeight() &&
+        stored.mLayoutPosition.getPosition(kPositionEdgeLeft) ==
+            node->getLayoutPositionLeft() &&
+        stored.mLayoutPosition.getPosition(kPositionEdgeTop) ==
+            node->getLayoutPositionTop() &&
+        stored.mLayoutPosition.getPosition(kPositionEdgeRight) ==
+            node->getLayoutPositionRight() &&
+        stored.mLayoutPosition.getPosition(kPositionEdgeBottom) ==
+            node->getLayoutPositionBottom()) {
+      node->setHasNewLayout(false);
+    } else {
+      changed++;
+    }
+  }
+  return changed;
+}
+
+bool LayoutCache::Store(uint64_t key, RenderObject *root) {
+  size_t node_count = CountNodes(root);
+  if (node_count == 0 || node_count > kMaxNodeCount) return false;
+
+  FileHeader header = {kMagic, kVersion, sizeof(WXCorelayoutResult),
+                       static_cast<uint32_t>(node_count), key};
+  std::vector<char> buffer(sizeof(FileHeader) +
+                           node_count * sizeof(WXCorelayoutResult));
+  memcpy(buffer.data(), &header, sizeof(header));
+  char *record = buffer.data() + sizeof(FileHeader);
+  for (TreeWalker<RenderObject> walker(root); !walker.Done(); walker.Next()) {
+    memcpy(record, &walker.node()->layoutResult(), sizeof(WXCorelayoutResult));
+    record += sizeof(WXCorelayoutResult);
+  }
+
+  std::string path = PathFor(key);
+  std::string temp_path = path + kTempSuffix;
+  FILE *file = fopen(temp_path.c_str(), "wb");
+  if (file == nullptr) return false;
+  bool written =
+      fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+  written = fclose(file) == 0 && written;
+  if (!written || rename(temp_path.c_str(), path.c_str()) != 0) {
+    unlink(temp_path.c_str());
+    return false;
+  }
+  Touch(key, buffer.size());
+  Evict();
+  return true;
+}
+
+bool LayoutCache::Remove(uint64_t key) {
+  Forget(key);
+  return unlink(PathFor(key).c_str()) == 0;
+}
+
+std::string LayoutCache::PathFor(uint64_t key) const {
+  char name[32];
+  snprintf(name, sizeof(name), "/%016" PRIx64 "%s", key, kSuffix);
+  return directory_ + name;
+}
+
+void LayoutCache::Touch(uint64_t key, size_t bytes) {
+  Forget(key);
+  entries_.push_back(Entry{key, bytes});
+  total_bytes_ += bytes;
+}
+
+void LayoutCache::Forget(uint64_t key) {
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->key == key) {
+      total_bytes_ -= it->bytes;
+      entries_.erase(it);
+      return;
+    }
+  }
+}
+
+void LayoutCache::Evict() {
+  while (!entries_.empty() && (entries_.size() > max_entry_count_ ||
+                               total_bytes_ > max_total_bytes_)) {
+    Entry oldest = entries_.front();
+    entries_.erase(entries_.begin());
+    total_bytes_ -= oldest.bytes;
+    unlink(PathFor(oldest.key).c_str());
+  }
+}
+
+}  // namespace WeexCore
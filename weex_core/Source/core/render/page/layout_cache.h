@@ -0,0 +1,114 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef CORE_RENDER_PAGE_LAYOUT_CACHE_H_
+#define CORE_RENDER_PAGE_LAYOUT_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace WeexCore {
+
+class RenderObject;
+
+// On-disk cache of first-screen layouts. A page's first layout pass looks up
+// the results computed for the same tree on an earlier visit, keyed by a hash
+// of everything the layout depends on: the tree shape, each node's type and
+// layout styles, the styles and text that feed text measurement, and the
+// page and viewport sizes. On a hit the page sends its layout actions right
+// away and computes the real layout on the next pass to validate them.
+//
+// Each key is one file in the cache directory: a small header followed by the
+// layout results of the tree in pre-order. Files are mapped read-only to be
+// restored, and written through a temporary file renamed into place, so a
+// crash never leaves a torn entry behind. Once the directory holds more
+// entries or bytes than the cache was given, the least recently restored or
+// stored entries are deleted.
+//
+// The cache is on when the "layoutCacheDir" environment option names a
+// writable directory. Like the render tree, it is used from the thread that
+// runs the pages.
+class LayoutCache {
+ public:
+  LayoutCache(const std::string &directory,
+              size_t max_entry_count = kMaxEntryCount,
+              size_t max_total_bytes = kMaxTotalBytes);
+
+  // 0 when the tree under |root| cannot be cached, e.g. because it holds
+  // richtext, whose content is not part of the tree. The key only changes
+  // with the tree and the build's layout structures, so entries stay valid
+  // across launches.
+  static uint64_t HashTree(RenderObject *root,
+                           const std::pair<float, float> &page_size,
+                           float viewport_width, float device_width);
+
+  // Gives every node of the tree the layout result stored for |key|. False,
+  // leaving the tree untouched, if there is no entry that fits the tree.
+  bool Restore(uint64_t key, RenderObject *root);
+
+  // Clears the new layout flag of every node whose freshly computed result
+  // matches the one stored for |key|, so that only the differences are sent
+  // again. Returns how many nodes differ, or the node count of the tree if
+  // there is no entry that fits it.
+  size_t Validate(uint64_t key, RenderObject *root) const;
+
+  bool Store(uint64_t key, RenderObject *root);
+
+  bool Remove(uint64_t key);
+
+  inline size_t entry_count() const { return entries_.size(); }
+
+  // Trees larger than this are not written, to bound the size of an entry.
+  static constexpr size_t kMaxNodeCount = 16384;
+  static constexpr size_t kMaxEntryCount = 64;
+  static constexpr size_t kMaxTotalBytes = 4 * 1024 * 1024;
+
+ private:
+  LayoutCache(const LayoutCache &) = delete;
+  LayoutCache &operator=(const LayoutCache &) = delete;
+
+  struct Entry {
+    uint64_t key;
+    size_t bytes;
+  };
+
+  std::string PathFor(uint64_t key) const;
+
+  // Moves the entry for |key| to the most recently used end, adding it if it
+  // is new.
+  void Touch(uint64_t key, size_t bytes);
+
+  void Forget(uint64_t key);
+
+  // Deletes the least recently used entries until the cache fits its bounds.
+  void Evict();
+
+  std::string directory_;
+  size_t max_entry_count_;
+  size_t max_total_bytes_;
+  // Least recently used first.
+  std::vector<Entry> entries_;
+  size_t total_bytes_ = 0;
+};
+
+}  // namespace WeexCore
+
+#endif  // CORE_RENDER_PAGE_LAYOUT_CACHE_H_
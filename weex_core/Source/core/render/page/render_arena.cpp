@@ -0,0 +1,140 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "core/render/page/render_arena.h"
+
+#include <cstdint>
+#include <cstdlib>
+
+namespace WeexCore {
+
+namespace {
+
+thread_local RenderArena *g_current_arena = nullptr;
+
+}  // namespace
+
+struct RenderArena::BlockHeader {
+  RenderArena *arena;
+  size_t size_class;
+};
+
+static_assert(sizeof(void *) * 2 <= 16,
+              "block header must fit in one alignment unit");
+
+RenderArena::Scope::Scope(RenderArena *arena) : previous_(g_current_arena) {
+  g_current_arena = arena;
+}
+
+RenderArena::Scope::~Scope() { g_current_arena = previous_; }
+
+RenderArena::RenderArena()
+    : cursor_(nullptr),
+      remaining_(0),
+      free_lists_(),
+      live_blocks_(0),
+      reserved_bytes_(0),
+      released_(false) {}
+
+RenderArena::~RenderArena() {
+  for (char *chunk : chunks_) {
+    free(chunk);
+  }
+}
+
+void RenderArena::Release() {
+  released_ = true;
+  if (g_current_arena == this) {
+    g_current_arena = nullptr;
+  }
+  if (live_blocks_ == 0) {
+    delete this;
+  }
+}
+
+RenderArena *RenderArena::Current() { return g_current_arena; }
+
+void *RenderArena::Allocate(size_t size) {
+  size_t size_class = (size + kAlignment - 1) / kAlignment;
+  RenderArena *arena = g_current_arena;
+  if (arena != nullptr && size_class > 0 && size_class <= kSizeClassCount) {
+    return arena->AllocateBlock(size_class);
+  }
+  void *memory = malloc(kAlignment + size);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  BlockHeader *header = static_cast<BlockHeader *>(memory);
+  header->arena = nullptr;
+  header->size_class = 0;
+  return static_cast<char *>(memory) + kAlignment;
+}
+
+void RenderArena::Free(void *ptr) {
+  if (ptr == nullptr) return;
+  BlockHeader *header =
+      reinterpret_cast<BlockHeader *>(static_cast<char *>(ptr) - kAlignment);
+  if (header->arena == nullptr) {
+    free(header);
+  } else {
+    header->arena->FreeBlock(header);
+  }
+}
+
+void *RenderArena::AllocateBlock(size_t size_class) {
+  char *block;
+  FreeNode *&free_list = free_lists_[size_class - 1];
+  if (free_list != nullptr) {
+    block = reinterpret_cast<char *>(free_list);
+    free_list = free_list->next;
+  } else {
+    size_t block_size = kAlignment + size_class * kAlignment;
+    if (remaining_ < block_size) {
+      // The tail of the previous chunk is dropped; it is smaller than the
+      // biggest size class and only lives as long as the page.
+      cursor_ = static_cast<char *>(malloc(kChunkSize));
+      if (cursor_ == nullptr) {
+        remaining_ = 0;
+        throw std::bad_alloc();
+      }
+      chunks_.push_back(cursor_);
+      remaining_ = kChunkSize;
+      reserved_bytes_ += kChunkSize;
+    }
+    block = cursor_;
+    cursor_ += block_size;
+    remaining_ -= block_size;
+  }
+  BlockHeader *header = reinterpret_cast<BlockHeader *>(block);
+  header->arena = this;
+  header->size_class = size_class;
+  ++live_blocks_;
+  return block + kAlignment;
+}
+
+void RenderArena::FreeBlock(BlockHeader *header) {
+  FreeNode *block = reinterpret_cast<FreeNode *>(header);
+  size_t size_class = header->size_class;
+  block->next = free_lists_[size_class - 1];
+  free_lists_[size_class - 1] = block;
+  if (--live_blocks_ == 0 && released_) {
+    delete this;
+  }
+}
+
+}  // namespace WeexCore
@@ -0,0 +1,114 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef CORE_RENDER_PAGE_RENDER_ARENA_H_
+#define CORE_RENDER_PAGE_RENDER_ARENA_H_
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace WeexCore {
+
+// Page scoped memory for render objects, their layout records and their
+// style/attr/event containers. Memory is carved out of large chunks and
+// recycled through per size class free lists while the page is alive, and
+// the chunks go back to the system in one go when the page is closed, so
+// opening and closing pages no longer fragments the native heap.
+//
+// Every block starts with a small header naming the arena it came from
+// (nullptr for the plain heap), so objects allocated with or without an
+// arena can be freed through the same path. Allocation picks the arena
+// installed by the innermost RenderArena::Scope on the calling thread.
+//
+// Like the render tree itself, an arena must only be touched from the
+// thread that owns its page.
+class RenderArena {
+ public:
+  class Scope {
+   public:
+    explicit Scope(RenderArena *arena);
+    ~Scope();
+
+   private:
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    RenderArena *previous_;
+  };
+
+  RenderArena();
+
+  // Called by the owner once it no longer allocates from the arena. The
+  // chunks are freed now, or when the last block still alive is freed.
+  void Release();
+
+  static RenderArena *Current();
+
+  static void *Allocate(size_t size);
+
+  static void Free(void *ptr);
+
+  template <typename T, typename... Args>
+  static T *New(Args &&... args) {
+    return new (Allocate(sizeof(T))) T(std::forward<Args>(args)...);
+  }
+
+  template <typename T>
+  static void Delete(T *ptr) {
+    if (ptr == nullptr) return;
+    ptr->~T();
+    Free(ptr);
+  }
+
+  inline size_t live_blocks() const { return live_blocks_; }
+
+  inline size_t reserved_bytes() const { return reserved_bytes_; }
+
+ private:
+  struct BlockHeader;
+  struct FreeNode {
+    FreeNode *next;
+  };
+
+  static constexpr size_t kAlignment = 16;
+  static constexpr size_t kSizeClassCount = 64;  // 16 .. 1024 bytes
+  static constexpr size_t kChunkSize = 32 * 1024;
+
+  ~RenderArena();
+
+  RenderArena(const RenderArena &) = delete;
+  RenderArena &operator=(const RenderArena &) = delete;
+
+  void *AllocateBlock(size_t size_class);
+
+  void FreeBlock(BlockHeader *header);
+
+  std::vector<char *> chunks_;
+  char *cursor_;
+  size_t remaining_;
+  FreeNode *free_lists_[kSizeClassCount];
+  size_t live_blocks_;
+  size_t reserved_bytes_;
+  bool released_;
+};
+
+}  // namespace WeexCore
+
+#endif  // CORE_RENDER_PAGE_RENDER_ARENA_H_
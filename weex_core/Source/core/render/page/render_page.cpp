@@ -18,12 +18,16 @@
  */
 
 #include <math.h>
+#include <cstring>
 #include "base/log_defines.h"
 #include "base/time_utils.h"
+#include "base/trace/trace_event.h"
 #include "core/common/view_utils.h"
 #include "core/config/core_environment.h"
+#include "core/css/constants_name.h"
 #include "core/css/constants_value.h"
 #include "core/layout/layout.h"
+#include "core/layout/tree_walker.h"
 #include "core/manager/weex_core_manager.h"
 #include "core/moniter/render_performance.h"
 #include "core/render/page/render_page.h"
@@ -48,9 +52,74 @@
 #include "core/render/node/factory/render_type.h"
 #include "core/render/node/render_list.h"
 #include "core/render/node/render_object.h"
+#include "core/render/page/layout_cache.h"
+#include "core/render/page/render_arena.h"
 
 namespace WeexCore {
 
+namespace {
+
+int64_t StyleBytes(const RenderObject *render) {
+  return render->styles() == nullptr ? 0 : render->styles()->ByteSize();
+}
+
+int64_t AttrBytes(const RenderObject *render) {
+  int64_t bytes = 0;
+  if (render->attributes() != nullptr) bytes += render->attributes()->ByteSize();
+  if (render->events() != nullptr) bytes += render->events()->ByteSize();
+  return bytes;
+}
+
+// Longhands are grouped with their shorthand and border styles with each
+// other, since either may override the other within one update.
+const char *StyleFamily(const std::string &key) {
+  static const char kBorder[] = "border";
+  if (key.compare(0, sizeof(MARGIN) - 1, MARGIN) == 0) return MARGIN;
+  if (key.compare(0, sizeof(PADDING) - 1, PADDING) == 0) return PADDING;
+  if (key.compare(0, sizeof(kBorder) - 1, kBorder) == 0) return kBorder;
+  return key.c_str();
+}
+
+// Styles and attributes the platform changes on its own, through animations
+// or user input, without core seeing the new value. An update setting one of
+// them back must reach the platform even if core already holds that value.
+bool IsPlatformMutableStyle(const std::string &key) {
+  return key == TRANSFORM || key == TRANSFORM_ORIGIN || key == OPACITY ||
+         key == BACKGROUND_COLOR || key == WIDTH || key == HEIGHT;
+}
+
+bool IsPlatformMutableAttr(const std::string &key) {
+  return key == VALUE || key == CHECKED;
+}
+
+// Drops the pairs |unchanged| accepts, keeping the order of the rest. A pair
+// stays anyway if a pair kept before it sets the same property, since it
+// then restores the current value. The buffer is released once every pair
+// is dropped, as the caller then returns before its own cleanup.
+template <typename Unchanged>
+size_t DropUnchanged(std::vector<std::pair<std::string, std::string>> *pairs,
+                     bool by_family, Unchanged unchanged) {
+  auto kept = pairs->begin();
+  for (auto it = pairs->begin(); it != pairs->end(); ++it) {
+    bool overridden = false;
+    for (auto k = pairs->begin(); k != kept && !overridden; ++k) {
+      overridden = by_family ? strcmp(StyleFamily(k->first),
+                                      StyleFamily(it->first)) == 0
+                             : k->first == it->first;
+    }
+    if (overridden || !unchanged(*it)) {
+      if (kept != it) *kept = std::move(*it);
+      ++kept;
+    }
+  }
+  size_t dropped = pairs->end() - kept;
+  pairs->erase(kept, pairs->end());
+  if (pairs->empty()) pairs->shrink_to_fit();
+  return dropped;
+}
+
+}  // namespace
+
 RenderPage::RenderPage(const std::string &page_id)
     : RenderPageBase(page_id, "platform"),
     viewport_width_(0),
@@ -66,6 +135,11 @@ RenderPage::RenderPage(const std::string &page_id)
   this->render_page_size_.second = NAN;
   this->viewport_width_ = kDefaultViewPortWidth;
   this->device_width_ = WXCoreEnvironment::getInstance()->DeviceWidth();
+  if (WXCoreEnvironment::getInstance()->GetOption("enableRenderArena") == "true") {
+    this->arena_ = new RenderArena();
+  }
+  this->update_diff_enabled_ =
+      WXCoreEnvironment::getInstance()->GetOption("enableUpdateDiff") == "true";
 }
 
 RenderPage::~RenderPage() {
@@ -79,20 +153,38 @@ RenderPage::~RenderPage() {
     delete this->render_root_;
     this->render_root_ = nullptr;
   }
+
+  if (this->arena_ != nullptr) {
+    this->arena_->Release();
+    this->arena_ = nullptr;
+  }
 }
 
 void RenderPage::CalculateLayout() {
   if (this->render_root_ == nullptr || !this->render_root_->ViewInit()) return;
+  TRACE_EVENT_WITH_ARG("weex.core", "RenderPage::CalculateLayout", page_id_.c_str());
 
 #if RENDER_LOG
   LOGD("[RenderPage] CalculateLayout >>>> pageId: %s", mPageId.c_str());
 #endif
 
+  RenderArena::Scope arena_scope(this->arena_);
   int64_t start_time = getCurrentTime();
+  if (this->layout_cache_state_ == kLayoutCacheValidate) {
+    // Lay the whole tree out again to check the layout taken from the cache.
+    for (TreeWalker<RenderObject> walker(this->render_root_); !walker.Done();
+         walker.Next()) {
+      walker.node()->markDirty(false);
+    }
+  }
   if (is_before_layout_needed_.load()) {
     this->render_root_->LayoutBeforeImpl();
   }
-  this->render_root_->calculateLayout(this->render_page_size_);
+  bool store_layout = false;
+  if (!ApplyCachedLayout()) {
+    this->render_root_->calculateLayout(this->render_page_size_);
+    store_layout = CheckCachedLayout();
+  }
   if (is_platform_layout_needed_.load()) {
     this->render_root_->LayoutPlatformImpl();
   }
@@ -101,27 +193,71 @@ void RenderPage::CalculateLayout() {
   }
   CssLayoutTime(getCurrentTime() - start_time);
   TraverseTree(this->render_root_, 0);
+  // The layout actions are out, so the file write no longer holds back the
+  // first frame.
+  if (store_layout) {
+    RenderManager::GetInstance()->layout_cache()->Store(
+        this->layout_cache_key_, this->render_root_);
+  }
 }
 
-void RenderPage::TraverseTree(RenderObject *render, long index) {
-  if (render == nullptr) return;
+bool RenderPage::ApplyCachedLayout() {
+  if (this->layout_cache_state_ != kLayoutCacheLookup) return false;
+
+  this->layout_cache_state_ = kLayoutCacheDone;
+  LayoutCache *cache = RenderManager::GetInstance()->layout_cache();
+  if (cache == nullptr) return false;
+  this->layout_cache_key_ =
+      LayoutCache::HashTree(this->render_root_, this->render_page_size_,
+                            this->viewport_width_, this->device_width_);
+  if (this->layout_cache_key_ == 0) return false;
 
-  if (render->hasNewLayout()) {
-    SendLayoutAction(render, (int)index);
-    render->setHasNewLayout(false);
+  if (!cache->Restore(this->layout_cache_key_, this->render_root_)) {
+    this->layout_cache_state_ = kLayoutCacheStore;
+    return false;
   }
+  this->layout_cache_state_ = kLayoutCacheValidate;
+  return true;
+}
 
-  for (auto it = render->ChildListIterBegin(); it != render->ChildListIterEnd();
-       it++) {
-    RenderObject *child = static_cast<RenderObject *>(*it);
-    if (child != nullptr) {
-      TraverseTree(child, it - render->ChildListIterBegin());
+bool RenderPage::CheckCachedLayout() {
+  LayoutCacheState state = this->layout_cache_state_;
+  if (state != kLayoutCacheStore && state != kLayoutCacheValidate) return false;
+
+  this->layout_cache_state_ = kLayoutCacheDone;
+  if (state == kLayoutCacheStore) return true;
+
+  LayoutCache *cache = RenderManager::GetInstance()->layout_cache();
+  uint64_t key =
+      LayoutCache::HashTree(this->render_root_, this->render_page_size_,
+                            this->viewport_width_, this->device_width_);
+  if (key != this->layout_cache_key_) {
+    // The tree changed since it was restored, so the entry can no longer be
+    // checked. Drop it rather than risk restoring a wrong layout again.
+    cache->Remove(this->layout_cache_key_);
+    return false;
+  }
+  return cache->Validate(key, this->render_root_) > 0;
+}
+
+void RenderPage::TraverseTree(RenderObject *render, long index) {
+  int64_t flex_lines = 0;
+  for (TreeWalker<RenderObject> walker(render, index); !walker.Done();) {
+    RenderObject *node = walker.node();
+    flex_lines += node->getFlexLineCount();
+    if (node->hasNewLayout()) {
+      SendLayoutAction(node, (int)walker.index());
+      node->setHasNewLayout(false);
     }
+    // The subtree of a deferred list cell still holds its last sent layout.
+    walker.Next(node->isLayoutDeferred());
   }
+  this->memory_stats_.flexLines = flex_lines;
 }
 
 bool RenderPage::CreateRootRender(RenderObject *root) {
   if (root == nullptr) return false;
+  TRACE_EVENT_WITH_ARG("weex.core", "RenderPage::CreateRootRender", page_id_.c_str());
 
   set_is_dirty(true);
   SetRootRenderObject(root);
@@ -151,6 +287,7 @@ void RenderPage::SetRootRenderObject(RenderObject *root) {
 
 bool RenderPage::AddRenderObject(const std::string &parent_ref,
                                  int insert_posiotn, RenderObject *child) {
+  TRACE_EVENT_WITH_ARG("weex.core", "RenderPage::AddRenderObject", page_id_.c_str());
   RenderObject *parent = GetRenderObject(parent_ref);
   if (parent == nullptr || child == nullptr) {
     return false;
@@ -181,6 +318,7 @@ bool RenderPage::AddRenderObject(const std::string &parent_ref,
 }
 
 bool RenderPage::RemoveRenderObject(const std::string &ref) {
+  TRACE_EVENT_WITH_ARG("weex.core", "RenderPage::RemoveRenderObject", page_id_.c_str());
   RenderObject *child = GetRenderObject(ref);
   if (child == nullptr) return false;
 
@@ -206,6 +344,7 @@ bool RenderPage::RemoveRenderObject(const std::string &ref) {
 
 bool RenderPage::MoveRenderObject(const std::string &ref,
                                   const std::string &parent_ref, int index) {
+  TRACE_EVENT_WITH_ARG("weex.core", "RenderPage::MoveRenderObject", page_id_.c_str());
   RenderObject *child = GetRenderObject(ref);
   if (child == nullptr) return false;
 
@@ -242,8 +381,13 @@ bool RenderPage::MoveRenderObject(const std::string &ref,
 bool RenderPage::UpdateStyle(
     const std::string &ref,
     std::vector<std::pair<std::string, std::string>> *src) {
+  TRACE_EVENT_WITH_ARG("weex.core", "RenderPage::UpdateStyle", page_id_.c_str());
   RenderObject *render = GetRenderObject(ref);
   if (render == nullptr || src == nullptr || src->empty()) return false;
+
+  // Styles of richtext children are only kept by the platform.
+  RenderObject* richtext = render->RichtextParent();
+  if (richtext == nullptr && !DropUnchangedStyles(render, src)) return false;
     
   set_is_dirty(true);
 
@@ -254,7 +398,6 @@ bool RenderPage::UpdateStyle(
   bool inheriableLayout = false;
     
   bool flag = false;
-  RenderObject* richtext = render->RichtextParent();
 
   if (richtext) {
       richtext->markDirty();
@@ -272,6 +415,7 @@ bool RenderPage::UpdateStyle(
         ->HasTransitionPros(this->page_id_.c_str(), ref.c_str(), src);
 
       if (result == 1) {
+        render->set_has_transition_update();
         SendUpdateStyleAction(render, src, margin, padding, border);
       } else {
         for (auto iter = src->begin(); iter != src->end(); iter++) {
@@ -334,6 +478,7 @@ bool RenderPage::UpdateStyle(
      }
   }
   Batch();
+  AccountBytes(render);
 
   if (src != nullptr) {
     src->clear();
@@ -374,10 +519,13 @@ bool RenderPage::UpdateStyle(
 bool RenderPage::UpdateAttr(
     const std::string &ref,
     std::vector<std::pair<std::string, std::string>> *attrs) {
+  TRACE_EVENT_WITH_ARG("weex.core", "RenderPage::UpdateAttr", page_id_.c_str());
   RenderObject *render = GetRenderObject(ref);
   if (render == nullptr || attrs == nullptr || attrs->empty()) return false;
 
   RenderObject* richtext = render->RichtextParent();
+  if (richtext == nullptr && !DropUnchangedAttrs(render, attrs)) return false;
+
   if (richtext) {
       RenderObject* parent = render->parent_render();
       SendUpdateRichtextChildAttrAction(render, attrs, parent->type() == "richtext" ? nullptr : parent, richtext);
@@ -390,6 +538,7 @@ bool RenderPage::UpdateAttr(
       }
   }
   Batch();
+  AccountBytes(render);
   if (attrs != nullptr) {
     attrs->clear();
     attrs->shrink_to_fit();
@@ -398,6 +547,44 @@ bool RenderPage::UpdateAttr(
   return true;
 }
 
+bool RenderPage::DropUnchangedStyles(
+    RenderObject *render,
+    std::vector<std::pair<std::string, std::string>> *styles) {
+  // A transition leaves the stored styles behind the platform's.
+  if (!this->update_diff_enabled_ || render->has_transition_update()) {
+    return true;
+  }
+  // Raw styles kept for a relayout must take the new string even when it
+  // parses to the same value.
+  bool keeps_raw = this->reserve_css_styles_ || render == this->render_root_;
+  size_t dropped = DropUnchanged(
+      styles, true,
+      [render, keeps_raw](const std::pair<std::string, std::string> &style) {
+        return !IsPlatformMutableStyle(style.first) &&
+               render->IsStyleUnchanged(style.first, style.second) &&
+               (!keeps_raw || render->HoldsStyle(style.first, style.second));
+      });
+  if (this->render_performance_ != nullptr) {
+    this->render_performance_->suppressedStyleUpdates += dropped;
+  }
+  return !styles->empty();
+}
+
+bool RenderPage::DropUnchangedAttrs(
+    RenderObject *render,
+    std::vector<std::pair<std::string, std::string>> *attrs) {
+  if (!this->update_diff_enabled_) return true;
+  size_t dropped = DropUnchanged(
+      attrs, false, [render](const std::pair<std::string, std::string> &attr) {
+        return !IsPlatformMutableAttr(attr.first) &&
+               render->IsAttrUnchanged(attr.first, attr.second);
+      });
+  if (this->render_performance_ != nullptr) {
+    this->render_performance_->suppressedAttrUpdates += dropped;
+  }
+  return !attrs->empty();
+}
+
 void RenderPage::SetDefaultHeightAndWidthIntoRootRender(
     const float default_width, const float default_height,
     const bool is_width_wrap_content, const bool is_height_wrap_content) {
@@ -432,6 +619,7 @@ bool RenderPage::AddEvent(const std::string &ref, const std::string &event) {
 
   set_is_dirty(true);
   render->AddEvent(event);
+  AccountBytes(render);
 
   RenderAction *action = new RenderActionAddEvent(this->page_id_, ref, event);
   PostRenderAction(action);
@@ -444,6 +632,7 @@ bool RenderPage::RemoveEvent(const std::string &ref, const std::string &event) {
 
   set_is_dirty(true);
   render->RemoveEvent(event);
+  AccountBytes(render);
 
   RenderAction *action =
       new RenderActionRemoveEvent(this->page_id_, ref, event);
@@ -452,6 +641,7 @@ bool RenderPage::RemoveEvent(const std::string &ref, const std::string &event) {
 }
 
 bool RenderPage::CreateFinish() {
+  TRACE_EVENT_WITH_ARG("weex.core", "RenderPage::CreateFinish", page_id_.c_str());
   if (this->render_root_ == nullptr) {
     return false;
   }
@@ -469,7 +659,8 @@ bool RenderPage::CreateFinish() {
 void RenderPage::LayoutInner() {
   CalculateLayout();
   this->need_layout_.store(false);
-  set_is_dirty(false);
+  // A layout taken from the cache is checked on the next pass.
+  set_is_dirty(this->layout_cache_state_ == kLayoutCacheValidate);
 }
 
 void RenderPage::LayoutImmediately() {
@@ -479,39 +670,63 @@ void RenderPage::LayoutImmediately() {
 }
 
 void RenderPage::PushRenderToRegisterMap(RenderObject *render) {
-  if (render == nullptr) return;
-
-  std::string ref = render->ref();
-  this->render_object_registers_.insert(
-      std::pair<std::string, RenderObject *>(ref, render));
-
-  for (auto it = render->ChildListIterBegin(); it != render->ChildListIterEnd();
-       it++) {
-    RenderObject *child = static_cast<RenderObject *>(*it);
-    if (child != nullptr) {
-      PushRenderToRegisterMap(child);
+  // Richtext children are kept as shadow objects, out of the layout tree.
+  bool in_layout = render->RichtextParent() == nullptr;
+  for (TreeWalker<RenderObject> walker(render); !walker.Done(); walker.Next()) {
+    RenderObject *node = walker.node();
+    if (this->render_object_registers_.insert(
+            std::pair<std::string, RenderObject *>(node->ref(), node)).second) {
+      AccountRender(node, in_layout, 1);
     }
-  }
 
-  for (auto it : render->shadow_objects_) {
+    for (auto it : node->shadow_objects_) {
       PushRenderToRegisterMap(it);
+    }
   }
 }
 
 void RenderPage::RemoveRenderFromRegisterMap(RenderObject *render) {
-  if (render == nullptr) return;
-
-  this->render_object_registers_.erase(render->ref());
+  bool in_layout = render->RichtextParent() == nullptr;
+  for (TreeWalker<RenderObject> walker(render); !walker.Done(); walker.Next()) {
+    RenderObject *node = walker.node();
+    auto iter = this->render_object_registers_.find(node->ref());
+    if (iter != this->render_object_registers_.end() && iter->second == node) {
+      this->render_object_registers_.erase(iter);
+      AccountRender(node, in_layout, -1);
+    }
 
-  for (auto it = render->ChildListIterBegin(); it != render->ChildListIterEnd();
-       it++) {
-    RenderObject *child = static_cast<RenderObject *>(*it);
-    if (child != nullptr) {
-      RemoveRenderFromRegisterMap(child);
+    // Shadow objects are deleted along with their richtext.
+    for (auto it : node->shadow_objects_) {
+      RemoveRenderFromRegisterMap(it);
     }
   }
 }
 
+void RenderPage::AccountRender(RenderObject *render, bool in_layout,
+                               int64_t sign) {
+  this->memory_stats_.renderObjects += sign;
+  if (in_layout) this->memory_stats_.layoutNodes += sign;
+  if (sign > 0) {
+    AccountBytes(render);
+  } else {
+    this->memory_stats_.styleBytes -= render->accounted_style_bytes_;
+    this->memory_stats_.attrBytes -= render->accounted_attr_bytes_;
+    render->accounted_style_bytes_ = 0;
+    render->accounted_attr_bytes_ = 0;
+  }
+}
+
+void RenderPage::AccountBytes(RenderObject *render) {
+  uint32_t style_bytes = static_cast<uint32_t>(StyleBytes(render));
+  uint32_t attr_bytes = static_cast<uint32_t>(AttrBytes(render));
+  this->memory_stats_.styleBytes +=
+      static_cast<int64_t>(style_bytes) - render->accounted_style_bytes_;
+  this->memory_stats_.attrBytes +=
+      static_cast<int64_t>(attr_bytes) - render->accounted_attr_bytes_;
+  render->accounted_style_bytes_ = style_bytes;
+  render->accounted_attr_bytes_ = attr_bytes;
+}
+
 void RenderPage::SendCreateBodyAction(RenderObject *render) {
   if (render == nullptr) return;
 
@@ -541,47 +756,62 @@ void RenderPage::SendAddElementAction(RenderObject *child, RenderObject *parent,
     will_layout = false;
   }
     RenderObject* richtext = child->RichtextParent();
-    if (!richtext) {
-        RenderAction *action =
-        new RenderActionAddElement(page_id(), child, parent, index, will_layout);
-        PostRenderAction(action);
-    } else {
+    if (richtext) {
         SendAddChildToRichtextAction(child, parent->type() == "richtext" ? nullptr : parent, richtext);
         richtext->markDirty();
         return;
     }
-    if (child->type() == "richtext") {
-        for (auto it : child->get_shadow_objects()) {
+
+  // The walk stops at richtext nodes, so no other node below |child| can have a
+  // richtext parent. Nodes below a recycle-list are never laid out here.
+  int recycle_lists = 0;
+  TreeWalker<RenderObject> walker(child, 0, true);
+  while (!walker.Done()) {
+    RenderObject *node = walker.node();
+    if (walker.leaving()) {
+      if (node->type() == WeexCore::kRenderRecycleList) {
+        recycle_lists--;
+        std::vector<RenderObject *> &cell_slots =
+            static_cast<RenderList *>(node)->CellSlots();
+        for (auto it = cell_slots.begin(); it != cell_slots.end(); it++) {
+          if (*it != nullptr) {
+            SendAddElementAction(*it, node, -1, true, false);
+          }
+        }
+      }
+      walker.Next();
+      continue;
+    }
+
+    bool is_child = node == child;
+    RenderAction *action = new RenderActionAddElement(
+        page_id(), node, is_child ? parent : walker.parent(),
+        is_child ? index : (int)walker.index(),
+        will_layout && recycle_lists == 0);
+    PostRenderAction(action);
+
+    if (node->type() == "richtext") {
+        for (auto it : node->get_shadow_objects()) {
             if (it) {
-                SendAddChildToRichtextAction(it, nullptr, child);
+                SendAddChildToRichtextAction(it, nullptr, node);
             }
         }
-        child->markDirty();
-        return;
-  }
-
-  int i = 0;
-  for (auto it = child->ChildListIterBegin(); it != child->ChildListIterEnd();
-       it++) {
-    RenderObject *grandson = static_cast<RenderObject *>(*it);
-    if (grandson != nullptr) {
-      SendAddElementAction(grandson, child, i, true, will_layout);
+        node->markDirty();
+        walker.Next(true);
+        continue;
     }
-    ++i;
+    if (node->type() == WeexCore::kRenderRecycleList) {
+      recycle_lists++;
+    }
+    walker.Next();
   }
 
+  if (is_recursion || child->type() == "richtext") return;
+  size_t count = child->getChildCount();
   if (child->type() == WeexCore::kRenderRecycleList) {
-    RenderList *render_list = static_cast<RenderList *>(child);
-    std::vector<RenderObject *> &cell_slots = render_list->CellSlots();
-    for (auto it = cell_slots.begin(); it != cell_slots.end(); it++) {
-      RenderObject *grandson = static_cast<RenderObject *>(*it);
-      if (grandson != nullptr) {
-        SendAddElementAction(grandson, child, -1, true, will_layout);
-      }
-      ++i;
-    }
+    count += static_cast<RenderList *>(child)->CellSlots().size();
   }
-  if (!is_recursion && i > 0 && child->IsAppendTree()) {
+  if (count > 0 && child->IsAppendTree()) {
     SendAppendTreeCreateFinish(child->ref());
   }
 }
@@ -711,7 +941,35 @@ void RenderPage::OnRenderProcessExited() {}
 
 void RenderPage::OnRenderProcessGone() {}
 
-void RenderPage::OnRenderPageClose() {}
+void RenderPage::OnRenderPageClose() {
+  GetMemoryStats();
+  const RenderMemoryStats &stats = this->memory_stats_;
+  LOGI("[RenderPage] OnRenderPageClose >>>> pageId: %s, renderObjects: %lld, "
+       "layoutNodes: %lld, styleBytes: %lld, attrBytes: %lld, flexLines: %lld, "
+       "postedActions: %lld, arenaBytes: %lld",
+       page_id().c_str(), static_cast<long long>(stats.renderObjects),
+       static_cast<long long>(stats.layoutNodes),
+       static_cast<long long>(stats.styleBytes),
+       static_cast<long long>(stats.attrBytes),
+       static_cast<long long>(stats.flexLines),
+       static_cast<long long>(stats.postedActions),
+       static_cast<long long>(stats.arenaBytes));
+  if (this->render_performance_ != nullptr) {
+    LOGI("[RenderPage] OnRenderPageClose >>>> pageId: %s, "
+         "suppressedStyleUpdates: %lld, suppressedAttrUpdates: %lld",
+         page_id().c_str(),
+         static_cast<long long>(
+             this->render_performance_->suppressedStyleUpdates),
+         static_cast<long long>(
+             this->render_performance_->suppressedAttrUpdates));
+  }
+}
+
+std::vector<int64_t> RenderPage::GetMemoryStats() {
+  this->memory_stats_.arenaBytes =
+      this->arena_ != nullptr ? this->arena_->reserved_bytes() : 0;
+  return RenderPageBase::GetMemoryStats();
+}
 
 bool RenderPage::ReapplyStyles() {
   if (!reserve_css_styles_) {
@@ -794,6 +1052,7 @@ bool RenderPage::ReapplyStyles() {
       if (border != nullptr) {
         delete border;
       }
+      AccountBytes(it->second);
     }
   }
   
@@ -21,6 +21,7 @@
 
 #include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <utility>
@@ -32,6 +33,7 @@
 namespace WeexCore {
 
 class RenderAction;
+class RenderArena;
 class RenderObject;
 
 class RenderPage: public RenderPageBase {
@@ -71,9 +73,28 @@ class RenderPage: public RenderPageBase {
                               RenderObject *render,
                               std::vector<std::pair<std::string, std::string>> *attrs, RenderObject *parent, RenderObject *richtext);
   void SendAppendTreeCreateFinish(const std::string &ref);
+
+  // Drop the pairs |render| already holds, before anything is allocated or
+  // sent to the platform. False if none is left, the vector's buffer is
+  // then released as well.
+  bool DropUnchangedStyles(
+      RenderObject *render,
+      std::vector<std::pair<std::string, std::string>> *styles);
+
+  bool DropUnchangedAttrs(
+      RenderObject *render,
+      std::vector<std::pair<std::string, std::string>> *attrs);
   
   void LayoutInner();
 
+  // Takes the first layout from the layout cache. False if the layout has
+  // to be computed, in which case CheckCachedLayout runs right after.
+  bool ApplyCachedLayout();
+
+  // Checks the computed layout against the cache. True if it is to be
+  // written to the cache, which is left until the layout has been sent.
+  bool CheckCachedLayout();
+
 public:
   explicit RenderPage(const std::string& page_id);
 
@@ -123,6 +144,15 @@ public:
     
   void RemoveRenderFromRegisterMap(RenderObject *render);
 
+  // Adds one registered render object to the memory stats, or takes it out
+  // for sign -1.
+  void AccountRender(RenderObject *render, bool in_layout, int64_t sign);
+
+  // Brings the style and attribute totals in line with what |render| holds
+  // now. Nodes changed past the page, by the platform or a list, are
+  // caught up when next updated here and leave the totals exactly.
+  void AccountBytes(RenderObject *render);
+
   // ****** Life Cycle ****** //
 
   void OnRenderPageInit();
@@ -134,6 +164,8 @@ public:
   void OnRenderProcessGone();
 
   virtual void OnRenderPageClose() override;
+
+  virtual std::vector<int64_t> GetMemoryStats() override;
   
   // Re-apply raw css styles to page and trigger layout
   virtual bool ReapplyStyles() override;
@@ -188,6 +220,9 @@ public:
 
   inline void set_after_layout_needed(bool v) { is_after_layout_needed_.store(v); }
 
+  // nullptr unless the "enableRenderArena" option is on.
+  inline RenderArena *arena() const { return arena_; }
+
  public:
   static constexpr bool kUseVSync = true;
   std::atomic_bool need_layout_{false};
@@ -207,6 +242,17 @@ public:
   float device_width_ = -1;
   bool round_off_deviation_ = kDefaultRoundOffDeviation;
   bool reserve_css_styles_ = false;
+  bool update_diff_enabled_ = false;
+  RenderArena *arena_ = nullptr;
+
+  enum LayoutCacheState {
+    kLayoutCacheLookup,    // the first layout is still to come
+    kLayoutCacheStore,     // the first layout missed, store it once computed
+    kLayoutCacheValidate,  // the first layout was restored, check it next
+    kLayoutCacheDone
+  };
+  LayoutCacheState layout_cache_state_ = kLayoutCacheLookup;
+  uint64_t layout_cache_key_ = 0;
 };
 }  // namespace WeexCore
 
@@ -65,6 +65,10 @@ namespace WeexCore {
             ret = this->render_performance_->PrintPerformanceLog(onRenderSuccess);
         return ret;
     }
+
+    std::vector<int64_t> RenderPageBase::GetMemoryStats() {
+        return this->memory_stats_.ToVector();
+    }
     
     std::unique_ptr<ValueWithType>
     RenderPageBase::CallNativeModule(const char *module, const char *method,
@@ -97,6 +101,7 @@ namespace WeexCore {
 
     void RenderPageBase::PostRenderAction(RenderAction *action) {
         if (action != nullptr) {
+            this->memory_stats_.postedActions++;
             action->ExecuteAction();
             delete action;
             action = nullptr;
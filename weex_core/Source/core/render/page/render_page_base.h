@@ -21,9 +21,11 @@
 
 #include <string>
 #include <map>
+#include <memory>
 #include <set>
 #include <vector>
 
+#include "core/moniter/render_memory_stats.h"
 #include "include/WeexApiValue.h"
 
 namespace WeexCore {
@@ -79,6 +81,8 @@ public:
     void CallBridgeTime(const int64_t &time);
     std::vector<int64_t> PrintFirstScreenLog();
     std::vector<int64_t> PrintRenderSuccessLog();
+    // RenderMemoryStats::ToVector of the page.
+    virtual std::vector<int64_t> GetMemoryStats();
     
     // Life cycle
     virtual RenderObject *GetRenderObject(const std::string &ref) { return nullptr; };
@@ -109,6 +113,7 @@ protected:
     std::string page_type_;
     
     RenderPerformance *render_performance_;
+    RenderMemoryStats memory_stats_;
 };
     
 }  // namespace WeexCore
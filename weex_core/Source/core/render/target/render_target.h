@@ -25,6 +25,7 @@
 #else
 #include "../../../include/WeexApiValue.h"
 #endif
+#include <memory>
 #include <string>
 #include <vector>
 #include <map>
@@ -38,6 +38,8 @@ namespace WeexCore {
     class WXCorePadding;
     class WXCoreBorderWidth;
     class WXCoreSize;
+    class SmallStringMap;
+    class SmallStringSet;
 }  // namespace WeexCore
 using namespace WeexCore;
 
@@ -159,18 +161,18 @@ typedef struct FunctionsExposedByCore {
 typedef void (*FuncCallSetJSVersion)(const char* version);
 typedef int (*CallNative)(const char *pageId, const char *task, const char *callback);
 typedef int (*FuncCreateBody)(const char* page_id, const char *component_type, const char* ref,
-                              std::map<std::string, std::string> *styles,
-                              std::map<std::string, std::string> *attributes,
-                              std::set<std::string> *events,
+                              SmallStringMap *styles,
+                              SmallStringMap *attributes,
+                              SmallStringSet *events,
                               const WXCoreMargin &margins,
                               const WXCorePadding &paddings,
                               const WXCoreBorderWidth &borders);
 typedef int (*FuncCreateFinish)(const char *pageId);
 typedef int (*FuncAddElement)(const char* page_id, const char *component_type, const char* ref,
                               int &index, const char* parentRef,
-                              std::map<std::string, std::string> *styles,
-                              std::map<std::string, std::string> *attributes,
-                              std::set<std::string> *events,
+                              SmallStringMap *styles,
+                              SmallStringMap *attributes,
+                              SmallStringSet *events,
                               const WXCoreMargin &margins,
                               const WXCorePadding &paddings,
                               const WXCoreBorderWidth &borders,
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <stdint.h>
 #include "stdlib.h"
 
 struct WeexString {
@@ -43,18 +43,41 @@
 namespace weex {
 namespace bridge {
 namespace js {
+
+// Number of JS runtimes asked for by the "jsRuntimeCount" framework param.
+static int jsRuntimeCount(std::vector<INIT_FRAMEWORK_PARAMS *> &params) {
+  for (auto param : params) {
+    std::string type = param->type->content;
+    if (type == "jsRuntimeCount") {
+      return atoi(param->value->content);
+    }
+  }
+  return 1;
+}
+
+static void waitForJSCInit() {
+  WeexEnv::getEnv()->locker()->lock();
+  while (!WeexEnv::getEnv()->is_jsc_init_finished()) {
+    WeexEnv::getEnv()->locker()->wait();
+  }
+  WeexEnv::getEnv()->locker()->unlock();
+}
+
 int ScriptSideInQueue::InitFramework(
     const char *script, std::vector<INIT_FRAMEWORK_PARAMS *> &params) {
   LOGD("ScriptSideInQueue::InitFramework");
   weexTaskQueue_->addTask(new InitFrameworkTask(char2String(script), params));
   weexTaskQueue_->init();
+  queuePool_.setPrimary(weexTaskQueue_);
+
+  int runtimeCount = jsRuntimeCount(params);
+  if (runtimeCount > 1) {
+    waitForJSCInit();
+    queuePool_.grow(runtimeCount, char2String(script), params);
+  }
 
   if (WeexEnv::getEnv()->enableBackupThread()) {
-    WeexEnv::getEnv()->locker()->lock();
-    while (!WeexEnv::getEnv()->is_jsc_init_finished()) {
-      WeexEnv::getEnv()->locker()->wait();
-    }
-    WeexEnv::getEnv()->locker()->unlock();
+    waitForJSCInit();
 
     if(WeexEnv::getEnv()->can_m_cache_task_()) {
       WeexEnv::getEnv()->m_task_cache_.push_back(new InitFrameworkTask(char2String(script), params));
@@ -127,6 +150,9 @@ int ScriptSideInQueue::ExecJsService(const char *source) {
   LOGD("ScriptSideInQueue::ExecJsService");
 
   weexTaskQueue_->addTask(new ExeJsServicesTask((source)));
+  for (size_t i = 1; i < queuePool_.size(); ++i) {
+    queuePool_.at(i)->addTask(new ExeJsServicesTask((source)));
+  }
   if (WeexEnv::getEnv()->enableBackupThread()) {
     ExeJsServicesTask *task = new ExeJsServicesTask((source));
     if(WeexEnv::getEnv()->can_m_cache_task_() && weexTaskQueue_bk_ == nullptr){
@@ -145,6 +171,9 @@ int ScriptSideInQueue::ExecTimeCallback(const char *source) {
   LOGD("ScriptSideInQueue::ExecTimeCallback");
 
   weexTaskQueue_->addTask(new CTimeCallBackTask(char2String(source)));
+  for (size_t i = 1; i < queuePool_.size(); ++i) {
+    queuePool_.at(i)->addTask(new CTimeCallBackTask(char2String(source)));
+  }
   if (WeexEnv::getEnv()->enableBackupThread() && weexTaskQueue_bk_ != nullptr) {
     weexTaskQueue_bk_->addTask(new CTimeCallBackTask(char2String(source)));
   }
@@ -162,6 +191,9 @@ int ScriptSideInQueue::ExecJS(const char *instanceId, const char *nameSpace,
   task->addExtraArg(char2String(func));
 
   if (instanceId == nullptr || strlen(instanceId) == 0) {
+    for (size_t i = 1; i < queuePool_.size(); ++i) {
+      queuePool_.at(i)->addTask(task->clone());
+    }
     if (WeexEnv::getEnv()->enableBackupThread()) {
       if(WeexEnv::getEnv()->can_m_cache_task_() && weexTaskQueue_bk_ == nullptr){
         WeexEnv::getEnv()->m_task_cache_.push_back(task->clone());
@@ -236,8 +268,10 @@ int ScriptSideInQueue::CreateInstance(const char *instanceId,
     }
   }
 
-  if(backUpThread) {
-    useBackUpWeexRuntime(instanceId);
+  if (backUpThread) {
+    queuePool_.bind(instanceId, backUpTaskQueue());
+  } else {
+    queuePool_.place(instanceId);
   }
 
   CreateInstanceTask *task = new CreateInstanceTask(char2String(instanceId),
@@ -275,15 +309,20 @@ std::unique_ptr<WeexJSResult> ScriptSideInQueue::ExecJSOnInstance(const char *in
 
 int ScriptSideInQueue::DestroyInstance(const char *instanceId) {
   LOGD("ScriptSideInQueue::DestroyInstance instanceId: %s \n", instanceId);
-  taskQueue(instanceId,
-            false)->addTask(new DestoryInstanceTask(instanceId));
-  deleteBackUpRuntimeInstance(instanceId);
+  auto pQueue = taskQueue(instanceId, false);
+  // Nothing queued for a page that is going away is worth running.
+  pQueue->removeAllTask(instanceId);
+  pQueue->addTask(new DestoryInstanceTask(instanceId));
+  queuePool_.release(instanceId);
   return 1;
 }
 
 int ScriptSideInQueue::UpdateGlobalConfig(const char *config) {
   LOGD("ScriptSideInQueue::UpdateGlobalConfig");
   weexTaskQueue_->addTask(new UpdateGlobalConfigTask(config));
+  for (size_t i = 1; i < queuePool_.size(); ++i) {
+    queuePool_.at(i)->addTask(new UpdateGlobalConfigTask(config));
+  }
   if (WeexEnv::getEnv()->enableBackupThread() && weexTaskQueue_bk_ != nullptr) {
     weexTaskQueue_bk_->addTask(new UpdateGlobalConfigTask(config));
   }
@@ -294,6 +333,9 @@ int ScriptSideInQueue::UpdateGlobalConfig(const char *config) {
 int ScriptSideInQueue::UpdateInitFrameworkParams(const std::string& key, const std::string& value, const std::string& desc){
   LOGD("ScriptSideInQueue::UpdateInitFrameworkParams");
   weexTaskQueue_->addTask(new UpdateInitFrameworkParamsTask(key, value, desc));
+  for (size_t i = 1; i < queuePool_.size(); ++i) {
+    queuePool_.at(i)->addTask(new UpdateInitFrameworkParamsTask(key, value, desc));
+  }
   if (WeexEnv::getEnv()->enableBackupThread()) {
     UpdateInitFrameworkParamsTask* task = new UpdateInitFrameworkParamsTask(key, value, desc);
     if(WeexEnv::getEnv()->can_m_cache_task_() && weexTaskQueue_bk_ == nullptr){
@@ -311,52 +353,32 @@ void ScriptSideInQueue::SetLogType(const int logLevel, const bool isPerf) {
 };
 
 
-void ScriptSideInQueue::useBackUpWeexRuntime(std::string id) {
-  usingBackThreadId.push_back(id);
-}
-
-bool ScriptSideInQueue::shouldUseBackUpWeexRuntime(std::string id) {
-  if (id.empty() || !WeexEnv::getEnv()->enableBackupThread())
-    return false;
-  auto iter = std::find(usingBackThreadId.begin(), usingBackThreadId.end(), id);
-  return iter != usingBackThreadId.end();
-}
-
-void ScriptSideInQueue::deleteBackUpRuntimeInstance(std::string id) {
-  if (!WeexEnv::getEnv()->enableBackupThread()) {
-    return;
-  }
-
-  auto iter = std::find(usingBackThreadId.begin(), usingBackThreadId.end(), id);
-  if (iter != usingBackThreadId.end()) {
-    usingBackThreadId.erase(iter);
+WeexTaskQueue *ScriptSideInQueue::backUpTaskQueue() {
+  if (weexTaskQueue_bk_ == nullptr) {
+    weexTaskQueue_bk_ = new WeexTaskQueue(weexTaskQueue_->isMultiProgress);
+    WeexEnv::getEnv()->set_m_cache_task_(false);
+    for (std::deque<WeexTask *>::iterator it = WeexEnv::getEnv()->m_task_cache_.begin(); it < WeexEnv::getEnv()->m_task_cache_.end(); ++it) {
+      auto reference = *it;
+      weexTaskQueue_bk_->addTask(std::move(reference));
+    }
+    WeexEnv::getEnv()->m_task_cache_.clear();
   }
+  return weexTaskQueue_bk_;
 }
 
 WeexTaskQueue *ScriptSideInQueue::taskQueue(const char *id, bool log) {
-  if (!WeexEnv::getEnv()->enableBackupThread()) {
-    return weexTaskQueue_;
+  WeexTaskQueue *queue = nullptr;
+  if (id != nullptr) {
+    queue = queuePool_.find(id);
   }
-
-  if (id != nullptr && shouldUseBackUpWeexRuntime(id)) {
-    if (weexTaskQueue_bk_ == nullptr) {
-      weexTaskQueue_bk_ = new WeexTaskQueue(weexTaskQueue_->isMultiProgress);
-      WeexEnv::getEnv()->set_m_cache_task_(false);
-      for (std::deque<WeexTask *>::iterator it = WeexEnv::getEnv()->m_task_cache_.begin(); it < WeexEnv::getEnv()->m_task_cache_.end(); ++it) {
-        auto reference = *it;
-        weexTaskQueue_bk_->addTask(std::move(reference));
-      }
-      WeexEnv::getEnv()->m_task_cache_.clear();
-    }
-    if (log) {
-      LOGE("dyyLog instance %s use back up thread time is %lld", id, microTime());
-    }
-    return weexTaskQueue_bk_;
+  if (queue == nullptr) {
+    queue = weexTaskQueue_;
   }
   if (log && id != nullptr) {
-    LOGE("dyyLog instance %s use main thread time is %lld", id, microTime());
+    LOGE("dyyLog instance %s use %s thread time is %lld", id,
+         queue == weexTaskQueue_bk_ ? "back up" : "main", microTime());
   }
-  return weexTaskQueue_;
+  return queue;
 }
 
 int64_t ScriptSideInQueue::JsAction(long ctxContainer, int32_t jsActionType, const char *arg) {
@@ -20,6 +20,8 @@
 // Created by chenpeihan on 2019/2/22.
 //
 
+#include <stdlib.h>
+
 #include "js_runtime/runtime/js_runtime_conversion.h"
 #include "js_runtime/weex/utils/weex_conversion_utils.h"
 #include "android/jsengine/object/weex_env.h"
@@ -27,6 +29,7 @@
 #include "js_runtime/weex/object/weex_runtime_v2.h"
 #include "js_runtime/runtime/runtime_vm.h"
 #include "core/bridge/script_bridge.h"
+#include "core/config/core_environment.h"
 #include "js_runtime/runtime/engine_context.h"
 #include "js_runtime/utils/log_utils.h"
 
@@ -54,6 +57,13 @@ bool WeexRuntimeV2::hasInstanceId(std::string &id) {
 int WeexRuntimeV2::initFramework(const std::string &script,
                                  std::vector<INIT_FRAMEWORK_PARAMS *> &params) {
   weex_object_holder_v2_->initFromParams(params, false);
+  // Core environment options are registered before the framework starts.
+  std::string coalesce_ms =
+      WeexCore::WXCoreEnvironment::getInstance()->GetOption("jsTimerCoalesceMs");
+  if (!coalesce_ms.empty() && weex_object_holder_v2_->timeQueue != nullptr) {
+    weex_object_holder_v2_->timeQueue->setCoalescing(
+        strtoull(coalesce_ms.c_str(), nullptr, 10));
+  }
   return this->_initFrameworkWithScript(script);
 }
 
@@ -20,9 +20,12 @@
 // Created by Darin on 2019/1/8.
 //
 
+#include <sched.h>
+
 #include "base/android/log_utils.h"
 #include "android/jsengine/object/weex_env.h"
 #include "back_to_weex_core_queue.h"
+#include "base/trace/trace_event.h"
 #include "third_party/IPC/Buffering/IPCBuffer.h"
 
 
@@ -35,11 +38,9 @@ static void *startThread(void *td) {
 }
 
 int BackToWeexCoreQueue::addTask(BackToWeexCoreQueue::IPCTask *task) {
-    threadLocker.lock();
-    taskQueue_.push_back(task);
-    int size = taskQueue_.size();
-    threadLocker.unlock();
-    threadLocker.signal();
+    int size = pending_.fetch_add(1) + 1;
+    taskQueue_.Push(task);
+    event_.Notify();
     return size;
 }
 
@@ -62,25 +63,24 @@ void BackToWeexCoreQueue::start() {
 }
 
 BackToWeexCoreQueue::IPCTask *BackToWeexCoreQueue::getTask() {
-    BackToWeexCoreQueue::IPCTask *task = nullptr;
-    while (task == nullptr) {
-        threadLocker.lock();
-        while (taskQueue_.empty() || !isInitOk) {
-            threadLocker.wait();
+    while (true) {
+        if (isInitOk) {
+            BackToWeexCoreQueue::IPCTask *task = taskQueue_.Pop();
+            if (task != nullptr) {
+                pending_.fetch_sub(1);
+                return task;
+            }
         }
 
-        if (taskQueue_.empty()) {
-            threadLocker.unlock();
+        auto key = event_.PrepareWait();
+        if (isInitOk && pending_.load() != 0) {
+            // a producer is still linking its task in.
+            event_.CancelWait();
+            sched_yield();
             continue;
         }
-
-        assert(!taskQueue_.empty());
-        task = taskQueue_.front();
-        taskQueue_.pop_front();
-        threadLocker.unlock();
+        event_.Wait(key);
     }
-
-    return task;
 }
 
 void BackToWeexCoreQueue::stop() {
@@ -91,6 +91,8 @@ void BackToWeexCoreQueue::IPCTask::run() {
     if (params.empty())
         return;
 
+    weex::base::ScopedTraceFlow traceFlow(m_traceFlowId);
+    TRACE_EVENT("weex.ipc", "BackToWeexCoreQueue::send");
     std::unique_ptr<IPCSerializer> serializer(createIPCSerializer());;
     serializer->setMsg(static_cast<uint32_t>(this->m_type));
     std::vector<BackToWeexCoreQueue::IPCArgs *>::iterator it;
@@ -24,13 +24,17 @@
 #define WEEX_PROJECT_BACK_TO_WEEX_CORE_QUEUE_H
 
 
-#include <deque>
+#include <atomic>
 #include <map>
 #include <third_party/IPC/IPCResult.h>
 #include <third_party/IPC/IPCMessageJS.h>
 #include <vector>
 #include "base/android/ThreadLocker.h"
 #include "base/closure.h"
+#include "base/thread/event_count.h"
+#include "base/thread/mpsc_queue.h"
+#include "base/trace/trace_log.h"
+#include "js_runtime/weex/task/weex_task_pool.h"
 
 class BackToWeexCoreQueue {
 
@@ -70,12 +74,16 @@ public:
         size_t m_length;
     };
 
-    class IPCTask {
+    class IPCTask : public weex::base::MpscNode {
     public:
+        WEEX_TASK_POOLED(IPCTask)
+
         std::vector<BackToWeexCoreQueue::IPCArgs *> params;
 
         explicit IPCTask(IPCProxyMsg type) : m_type(type),
-                                             m_future(nullptr) {}
+                                             m_future(nullptr),
+                                             m_traceFlowId(weex::base::TraceLog::IsEnabled()
+                                                           ? weex::base::TraceLog::CurrentFlowId() : 0) {}
 
         ~IPCTask();
 
@@ -88,6 +96,8 @@ public:
     private:
         IPCProxyMsg m_type;
         Future *m_future;
+        // Flow of the JS task that produced the message, sent along with it.
+        uint64_t m_traceFlowId;
 
     };
 
@@ -106,8 +116,11 @@ public:
 
 
 private:
-    std::deque<BackToWeexCoreQueue::IPCTask *> taskQueue_;
-    ThreadLocker threadLocker;
+    // Producers never block, the sending thread parks on event_ when idle.
+    weex::base::MpscQueue<BackToWeexCoreQueue::IPCTask> taskQueue_;
+    // Tasks added but not taken yet, raised before the push.
+    std::atomic<int> pending_{0};
+    weex::base::EventCount event_;
     bool m_stop;
 
 public:
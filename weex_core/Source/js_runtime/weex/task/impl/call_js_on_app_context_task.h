@@ -25,11 +25,14 @@
 
 
 #include "js_runtime/weex/task/weex_task.h"
+#include "js_runtime/weex/task/weex_task_pool.h"
 #include "android/jsengine/object/args/exe_js_args.h"
 
 class CallJsOnAppContextTask : public WeexTask {
 
 public:
+    WEEX_TASK_POOLED(CallJsOnAppContextTask)
+
     CallJsOnAppContextTask(const std::string &instanceId, const std::string &func, std::vector<VALUE_WITH_TYPE *> &params);
 
     CallJsOnAppContextTask(const std::string &instanceId, const std::string &func, IPCArguments *arguments, size_t startCount);
@@ -34,6 +34,7 @@ public:
 
     void run(WeexRuntime *runtime) override ;
     std::string taskName() override { return "CreateInstanceTask"; }
+    Priority priority() override { return kPriorityCreateInstance; }
 
 private:
     std::vector<std::string> extraArgs;
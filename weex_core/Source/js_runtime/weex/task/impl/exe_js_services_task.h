@@ -32,6 +32,7 @@ public:
 
      void run(WeexRuntime *runtime) override ;
      std::string taskName() override { return " ExeJsServicesTask"; }
+     Priority priority() override { return kPriorityService; }
 
 private:
     std::string script;
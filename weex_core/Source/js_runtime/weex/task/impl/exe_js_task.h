@@ -24,10 +24,13 @@
 #define WEEXV8_EXEJSTASK_H
 
 #include "js_runtime/weex/task/weex_task.h"
+#include "js_runtime/weex/task/weex_task_pool.h"
 #include "android/jsengine/object/args/exe_js_args.h"
 
 class ExeJsTask : public WeexTask {
 public:
+    WEEX_TASK_POOLED(ExeJsTask)
+
     ExeJsTask(const std::string  &instanceId, std::vector<VALUE_WITH_TYPE *> &params, bool withResult = false);
     ExeJsTask(const std::string &instanceId, std::vector<VALUE_WITH_TYPE *> &params, long callback_id);
     void addExtraArg(std::string arg);
@@ -35,6 +38,7 @@ public:
 
     void run(WeexRuntime *runtime) override;
     std::string taskName() override { return "ExeJsTask"; }
+    Priority priority() override { return kPriorityInput; }
 
   ExeJsTask * clone();
 
@@ -29,13 +29,23 @@ NativeTimerTask::NativeTimerTask(const std::string &instanceId,
                                  int taskId,
                                  bool one_shot)
     : WeexTask(instanceId, taskId) {
-  this->timerFunction = function;
-  repeatTimer = !one_shot;
+  addTimer(function, taskId, one_shot);
 }
 
-void NativeTimerTask::run(WeexRuntime *runtime) {
-  runtime->exeTimerFunctionForRunTimeApi(instanceId, timerFunction, is_from_instance);
-  if (!repeatTimer)
-    runtime->removeTimerFunctionForRunTimeApi(instanceId, timerFunction, is_from_instance);
+void NativeTimerTask::addTimer(uint32_t function, int taskId, bool one_shot) {
+  timers_.add(function, taskId, one_shot);
+}
 
+bool NativeTimerTask::cancelTimer(int timerId) {
+  return timers_.cancel(timerId);
+}
+
+void NativeTimerTask::run(WeexRuntime *runtime) {
+  timers_.run(
+      [&](uint32_t function) {
+        runtime->exeTimerFunctionForRunTimeApi(instanceId, function, is_from_instance);
+      },
+      [&](uint32_t function) {
+        runtime->removeTimerFunctionForRunTimeApi(instanceId, function, is_from_instance);
+      });
 }
@@ -23,20 +23,29 @@
 #ifndef WEEXV8_NATIVE_TIMERTASK_H
 #define WEEXV8_NATIVE_TIMERTASK_H
 
+#include "js_runtime/weex/task/timer_batch.h"
 #include "js_runtime/weex/task/weex_task.h"
+#include "js_runtime/weex/task/weex_task_pool.h"
 
+// Runs one or more timer callbacks of the same instance in a single task, so
+// timers that expire together cost one trip through WeexTaskQueue and one
+// dom action flush.
 class NativeTimerTask : public WeexTask {
 public:
+    WEEX_TASK_POOLED(NativeTimerTask)
+
     explicit NativeTimerTask(const std::string &instanceId, uint32_t function, int taskId, bool one_shot);
     ~NativeTimerTask() override {}
 
+    void addTimer(uint32_t function, int taskId, bool one_shot);
+    bool cancelTimer(int timerId) override;
+
     void run(WeexRuntime *runtime) override;
     std::string taskName() override { return "NativeTimerTask"; }
-    uint32_t timerFunctionID() const { return timerFunction; }
+    Priority priority() override { return kPriorityTimer; }
 
 private:
-    uint32_t timerFunction;
-    bool repeatTimer;
+    TimerBatch timers_;
 };
 
 
@@ -0,0 +1,80 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+//
+// Timers of one instance that expired together, run by NativeTimerTask.
+//
+
+#ifndef WEEXV8_TIMERBATCH_H
+#define WEEXV8_TIMERBATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// TimerQueue forgets a one-shot timer as soon as it fires, so once a timer is
+// in a batch only the batch can still cancel it. Cancelling only marks the
+// entry: a callback of the batch may clear a later timer of the same batch
+// while run() walks it. A cancelled entry is skipped, and the JS function of
+// a one-shot entry is released whether it ran or not.
+class TimerBatch {
+
+public:
+    void add(uint32_t function, int taskId, bool one_shot) {
+        timers_.push_back({function, taskId, !one_shot, false});
+    }
+
+    // Returns false if the batch has no live timer with this id.
+    bool cancel(int taskId) {
+        for (Timer &timer : timers_) {
+            if (timer.taskId == taskId && !timer.cancelled) {
+                timer.cancelled = true;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Calls exec(function) for every live timer in order, and
+    // release(function) after each one-shot timer. exec may cancel timers of
+    // this batch.
+    template <typename Exec, typename Release>
+    void run(Exec exec, Release release) {
+        for (size_t i = 0; i < timers_.size(); ++i) {
+            if (!timers_[i].cancelled) {
+                exec(timers_[i].function);
+            }
+            if (!timers_[i].repeat) {
+                release(timers_[i].function);
+            }
+        }
+    }
+
+private:
+    struct Timer {
+        uint32_t function;
+        int taskId;
+        bool repeat;
+        bool cancelled;
+    };
+
+    std::vector<Timer> timers_;
+};
+
+
+#endif //WEEXV8_TIMERBATCH_H
@@ -23,6 +23,7 @@
 #include "timer_queue.h"
 //#include "android/jsengine/task/weex_task_queue.h"
 #include "weex_task_queue.h"
+#include "js_runtime/weex/task/impl/native_timer_task.h"
 #include "android/jsengine/object/weex_env.h"
 //#include "android/jsengine/weex_runtime.h"
 #include "js_runtime/weex/object/weex_runtime.h"
@@ -46,160 +47,154 @@ void TimerQueue::init() {
 }
 
 void TimerQueue::start() {
+  std::vector<TimerTask *> expired;
+  std::vector<NativeTimerTask *> batches;
+  threadLocker.lock();
   while (true) {
-    auto pTask = getTask();
-    LOGE("getTask return task");
-    bool ptaskHasGlobalObject;
-    ptaskHasGlobalObject = weexTaskQueue->weexRuntime->hasInstanceId(pTask->instanceID);
-    //LOGE("[weex-task]getTask return task,ptaskHasGlobalObject :%d ",ptaskHasGlobalObject);
-
-    if (ptaskHasGlobalObject && weexTaskQueue->weexRuntime->hasInstanceId(pTask->instanceID)) {
-      //  LOGE("[weex-task]before add  to weexTaskQueue");
-      weexTaskQueue->addTimerTask(pTask->instanceID,
-                                  pTask->m_function,
-                                  pTask->taskId,
-                                  !pTask->repeat,
-                                  pTask->from_instance_);
-      //LOGE("[weex-task]end add  to weexTaskQueue");
-      if (pTask->repeat && ptaskHasGlobalObject
-          && weexTaskQueue->weexRuntime->hasInstanceId(pTask->instanceID)) {
-        LOGE("repreat");
-        addTimerTask(new TimerTask(pTask));
+    wheel_.advance(microTime() / TIMESPCE, expired);
+    for (auto task : expired) {
+      fire(task, batches);
+    }
+    expired.clear();
+    for (auto batch : batches) {
+      weexTaskQueue->addTask(batch);
+    }
+    batches.clear();
+
+    uint64_t wakeMs = wheel_.nextWakeMs();
+    if (wakeMs == UINT64_MAX) {
+      threadLocker.wait();
+    } else {
+      if (coalesce_window_ms_ > 1) {
+        wakeMs = (wakeMs + coalesce_window_ms_ - 1) / coalesce_window_ms_ * coalesce_window_ms_;
       }
+      threadLocker.waitTimeout(wakeMs * TIMESPCE);
     }
-    delete (pTask);
-    pTask = nullptr;
   }
 }
 
-TimerQueue::TimerQueue(WeexTaskQueue *taskQueue) {
-  nextTaskWhen = 0;
-  this->weexTaskQueue = taskQueue;
-  init();
+void TimerQueue::setCoalescing(uint64_t windowMs) {
+  threadLocker.lock();
+  coalesce_window_ms_ = windowMs;
+  threadLocker.unlock();
+  threadLocker.signal();
 }
 
-int TimerQueue::addTimerTask(TimerTask *timerTask) {
-  threadLocker.lock();
-  auto size = timerQueue_.size();
-  if (timerQueue_.empty()) {
-    timerQueue_.push_back(timerTask);
-  } else {
-    auto begin = timerQueue_.begin();
-    int i = 0;
-    for (; i < size; ++i) {
-      auto it = timerQueue_[i];
-      if (timerTask->when < it->when) {
-        timerQueue_.insert(begin + i, timerTask);
-        break;
-      } else if (i == size - 1) {
-        timerQueue_.push_back(timerTask);
+void TimerQueue::fire(TimerTask *timerTask, std::vector<NativeTimerTask *> &batches) {
+  if (weexTaskQueue->weexRuntime->hasInstanceId(timerTask->instanceID)) {
+    NativeTimerTask *batch = nullptr;
+    for (auto candidate : batches) {
+      if (candidate->instanceId == timerTask->instanceID
+          && candidate->is_from_instance == timerTask->from_instance_) {
+        batch = candidate;
         break;
       }
     }
+    if (batch == nullptr) {
+      batch = new NativeTimerTask(timerTask->instanceID,
+                                  timerTask->m_function,
+                                  timerTask->taskId,
+                                  !timerTask->repeat);
+      batch->is_from_instance = timerTask->from_instance_;
+      batches.push_back(batch);
+    } else {
+      batch->addTimer(timerTask->m_function, timerTask->taskId, !timerTask->repeat);
+    }
+    if (timerTask->repeat) {
+      // Re-arm in place rather than allocating a copy for every interval.
+      timerTask->when = microTime() + timerTask->timeout * TIMESPCE;
+      wheel_.add(timerTask);
+      return;
+    }
   }
+  timers_.erase(timerTask->taskId);
+  unlinkFromPage(timerTask);
+  delete timerTask;
+}
 
-  size = timerQueue_.size();
-  if (size > 0) {
-    nextTaskWhen = timerQueue_.front()->when;
+void TimerQueue::cancel(TimerTask *timerTask) {
+  wheel_.remove(timerTask);
+  timers_.erase(timerTask->taskId);
+  weexTaskQueue->removeTimer(timerTask->taskId);
+  if (weexTaskQueue->weexRuntime) {
+    weexTaskQueue->weexRuntime->removeTimerFunctionForRunTimeApi(timerTask->instanceID,
+                                                                 timerTask->m_function,
+                                                                 timerTask->from_instance_);
   }
-  threadLocker.unlock();
-  threadLocker.signal();
-  return size;
+  delete timerTask;
 }
 
-//对比时间
-TimerTask *TimerQueue::getTask() {
-  TimerTask *task = nullptr;
-  while (task == nullptr) {
-    threadLocker.lock();
-    while (timerQueue_.empty() || microTime() < nextTaskWhen) {
-      if (timerQueue_.empty()) {
-        threadLocker.wait();
-      } else {
-        auto i = threadLocker.waitTimeout(nextTaskWhen);
-        if (i == ETIMEDOUT) {
-          break;
-        }
-      }
-    }
-
-    if (timerQueue_.empty()) {
-      threadLocker.unlock();
-      continue;
-    }
-    assert(!taskQueue_.empty());
-    TimerTask *header = timerQueue_.front();
-    nextTaskWhen = header->when;
-    if (microTime() > nextTaskWhen) {
-      timerQueue_.pop_front();
-      task = header;
-    } else {
-      threadLocker.unlock();
-      continue;
-    }
-    threadLocker.unlock();
+void TimerQueue::linkToPage(TimerTask *timerTask) {
+  TimerTask *&head = page_timers_[timerTask->instanceID];
+  timerTask->page_prev_ = nullptr;
+  timerTask->page_next_ = head;
+  if (head) {
+    head->page_prev_ = timerTask;
   }
-  return task;
+  head = timerTask;
 }
 
-void TimerQueue::removeTimer(int timerId) {
-  threadLocker.lock();
-  if (timerQueue_.empty()) {
-    threadLocker.unlock();
-    return;
+void TimerQueue::unlinkFromPage(TimerTask *timerTask) {
+  if (timerTask->page_next_) {
+    timerTask->page_next_->page_prev_ = timerTask->page_prev_;
+  }
+  if (timerTask->page_prev_) {
+    timerTask->page_prev_->page_next_ = timerTask->page_next_;
   } else {
-    for (auto it = timerQueue_.begin(); it < timerQueue_.end(); ++it) {
-      auto reference = *it;
-      if (reference->taskId == timerId) {
-        timerQueue_.erase(it);
-        weexTaskQueue->removeTimer(reference->taskId);
-        if (weexTaskQueue->weexRuntime) {
-          weexTaskQueue->weexRuntime->removeTimerFunctionForRunTimeApi(reference->instanceID,
-                                                                       reference->m_function,
-                                                                       reference->from_instance_);
-        }
-
-        delete (reference);
-        reference = nullptr;
+    auto it = page_timers_.find(timerTask->instanceID);
+    if (it != page_timers_.end()) {
+      if (timerTask->page_next_) {
+        it->second = timerTask->page_next_;
+      } else {
+        page_timers_.erase(it);
       }
     }
   }
+  timerTask->page_prev_ = nullptr;
+  timerTask->page_next_ = nullptr;
+}
 
-  int size = timerQueue_.size();
-  if (size > 0) {
-    nextTaskWhen = timerQueue_.front()->when;
-  }
+TimerQueue::TimerQueue(WeexTaskQueue *taskQueue) : wheel_(microTime() / TIMESPCE) {
+  this->weexTaskQueue = taskQueue;
+  init();
+}
+
+int TimerQueue::addTimerTask(TimerTask *timerTask) {
+  threadLocker.lock();
+  wheel_.add(timerTask);
+  timers_[timerTask->taskId] = timerTask;
+  linkToPage(timerTask);
+  int size = timers_.size();
   threadLocker.unlock();
   threadLocker.signal();
+  return size;
 }
 
-void TimerQueue::destroyPageTimer(std::string instanceId) {
+void TimerQueue::removeTimer(int timerId) {
   threadLocker.lock();
-  if (timerQueue_.empty()) {
-    threadLocker.unlock();
-    return;
+  auto it = timers_.find(timerId);
+  if (it != timers_.end()) {
+    TimerTask *reference = it->second;
+    unlinkFromPage(reference);
+    cancel(reference);
   } else {
-    for (std::deque<TimerTask *>::iterator it = timerQueue_.begin(); it < timerQueue_.end(); ++it) {
-      auto reference = *it;
-      if (reference->instanceID == instanceId) {
-        timerQueue_.erase(it);
-        weexTaskQueue->removeTimer(reference->taskId);
-        if (weexTaskQueue->weexRuntime) {
-          weexTaskQueue->weexRuntime->removeTimerFunctionForRunTimeApi(reference->instanceID,
-                                                                       reference->m_function,
-                                                                       reference->from_instance_);
-        }
-
-        delete (reference);
-        reference = nullptr;
-      }
-    }
+    // A one-shot timer that already fired lives on only in its batch.
+    weexTaskQueue->removeTimer(timerId);
   }
+  threadLocker.unlock();
+}
 
-  int size = timerQueue_.size();
-  if (size > 0) {
-    nextTaskWhen = timerQueue_.front()->when;
+void TimerQueue::destroyPageTimer(std::string instanceId) {
+  threadLocker.lock();
+  auto it = page_timers_.find(instanceId);
+  if (it != page_timers_.end()) {
+    TimerTask *reference = it->second;
+    page_timers_.erase(it);
+    while (reference) {
+      TimerTask *next = reference->page_next_;
+      cancel(reference);
+      reference = next;
+    }
   }
   threadLocker.unlock();
-  threadLocker.signal();
 }
@@ -24,12 +24,16 @@
 #define WEEXV8_TIMERQUEUE_H
 
 #include <pthread.h>
-#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 //#include "android/jsengine/task/timer_task.h"
 #include "js_runtime/weex/task/timer_task.h"
+#include "js_runtime/weex/task/timer_wheel.h"
 #include "base/android/ThreadLocker.h"
 
+class NativeTimerTask;
 class TimerTask;
 class WeexTaskQueue;
 
@@ -44,18 +48,39 @@ public:
 
     int addTimerTask(TimerTask *timerTask);
 
-    TimerTask *getTask();
-
     void start();
 
+    // Timers are fired on a grid of windowMs, so ones expiring within the same
+    // window reach the JS thread as a single NativeTimerTask per instance. A
+    // timer may be delayed by up to windowMs but never fires early. The
+    // default window of 0, like 1, fires every timer on its own millisecond.
+    // Set from the "jsTimerCoalesceMs" core environment option.
+    void setCoalescing(uint64_t windowMs);
+
     bool isInit = false;
 
     explicit TimerQueue(WeexTaskQueue *taskQueue);
 
 private:
-    uint64_t nextTaskWhen;
+    // Adds a due timer to its instance's batch and re-arms or frees it.
+    // Called with threadLocker held.
+    void fire(TimerTask *timerTask, std::vector<NativeTimerTask *> &batches);
+
+    // Drops a pending timer together with its queued task and JS function.
+    // Called with threadLocker held.
+    void cancel(TimerTask *timerTask);
+
+    void linkToPage(TimerTask *timerTask);
+
+    void unlinkFromPage(TimerTask *timerTask);
+
     WeexTaskQueue *weexTaskQueue;
-    std::deque<TimerTask *> timerQueue_;
+    uint64_t coalesce_window_ms_ = 0;
+    TimerWheel wheel_;
+    // Every pending timer by id, and the per-instance list heads threaded
+    // through TimerTask::page_next_.
+    std::unordered_map<int, TimerTask *> timers_;
+    std::unordered_map<std::string, TimerTask *> page_timers_;
     ThreadLocker threadLocker;
 };
 
@@ -26,6 +26,9 @@
 
 #include <cstdint>
 #include <string>
+
+#include "js_runtime/weex/task/timer_wheel.h"
+
 class TimerTask {
 
 public:
@@ -41,6 +44,14 @@ public:
 
     bool from_instance_ = true;
 
+    // Bookkeeping owned by TimerQueue and TimerWheel.
+    uint64_t expires_ = 0;
+    TimerWheel::Slot *wheel_slot_ = nullptr;
+    TimerTask *wheel_prev_ = nullptr;
+    TimerTask *wheel_next_ = nullptr;
+    TimerTask *page_prev_ = nullptr;
+    TimerTask *page_next_ = nullptr;
+
    // WeexGlobalObject* global_object_;
 
     explicit TimerTask(const std::string &id, uint32_t function, uint64_t millSecTimeout, bool repeat = false);
@@ -0,0 +1,155 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+//
+// Hierarchical timing wheel backing TimerQueue.
+//
+
+#include "timer_wheel.h"
+
+#include <algorithm>
+
+#include "js_runtime/weex/task/timer_task.h"
+#include "js_runtime/weex/utils/weex_jsc_utils.h"
+
+TimerWheel::TimerWheel(uint64_t nowMs) : current_(nowMs), size_(0) {
+}
+
+void TimerWheel::add(TimerTask *task) {
+    task->expires_ = (task->when + TIMESPCE - 1) / TIMESPCE;
+    place(task);
+    ++size_;
+}
+
+void TimerWheel::place(TimerTask *task) {
+    uint64_t expires = task->expires_;
+    Slot *slot;
+    if (expires <= current_) {
+        // Already due, fire on the next tick processed.
+        slot = &slots_[0][current_ & kSlotMask];
+    } else {
+        uint64_t delta = expires - current_;
+        if (delta > kMaxDelta) {
+            expires = current_ + kMaxDelta;
+            delta = kMaxDelta;
+        }
+        int level = 0;
+        while (delta >= (1ULL << (kSlotBits * (level + 1)))) {
+            ++level;
+        }
+        slot = &slots_[level][(expires >> (kSlotBits * level)) & kSlotMask];
+    }
+
+    task->wheel_slot_ = slot;
+    task->wheel_next_ = nullptr;
+    task->wheel_prev_ = slot->tail;
+    if (slot->tail) {
+        slot->tail->wheel_next_ = task;
+    } else {
+        slot->head = task;
+    }
+    slot->tail = task;
+}
+
+void TimerWheel::remove(TimerTask *task) {
+    Slot *slot = task->wheel_slot_;
+    if (slot == nullptr) {
+        return;
+    }
+    if (task->wheel_prev_) {
+        task->wheel_prev_->wheel_next_ = task->wheel_next_;
+    } else {
+        slot->head = task->wheel_next_;
+    }
+    if (task->wheel_next_) {
+        task->wheel_next_->wheel_prev_ = task->wheel_prev_;
+    } else {
+        slot->tail = task->wheel_prev_;
+    }
+    task->wheel_slot_ = nullptr;
+    task->wheel_prev_ = nullptr;
+    task->wheel_next_ = nullptr;
+    --size_;
+}
+
+void TimerWheel::cascade(int level, uint64_t index) {
+    Slot &slot = slots_[level][index];
+    TimerTask *task = slot.head;
+    slot.head = nullptr;
+    slot.tail = nullptr;
+    while (task) {
+        TimerTask *next = task->wheel_next_;
+        place(task);
+        task = next;
+    }
+}
+
+void TimerWheel::advance(uint64_t nowMs, std::vector<TimerTask *> &expired) {
+    while (current_ <= nowMs) {
+        if (size_ == 0) {
+            current_ = nowMs + 1;
+            return;
+        }
+
+        uint64_t index = current_ & kSlotMask;
+        if (index == 0) {
+            for (int level = 1; level < kLevelCount; ++level) {
+                uint64_t upper = (current_ >> (kSlotBits * level)) & kSlotMask;
+                cascade(level, upper);
+                if (upper != 0) {
+                    break;
+                }
+            }
+        }
+
+        Slot &slot = slots_[0][index];
+        for (TimerTask *task = slot.head; task;) {
+            TimerTask *next = task->wheel_next_;
+            task->wheel_slot_ = nullptr;
+            task->wheel_prev_ = nullptr;
+            task->wheel_next_ = nullptr;
+            expired.push_back(task);
+            --size_;
+            task = next;
+        }
+        slot.head = nullptr;
+        slot.tail = nullptr;
+
+        // Nothing else can land in level 0 before the next cascade, so jump
+        // straight to the next occupied slot or the next 64 tick boundary,
+        // but never past nowMs or later adds would be placed too late.
+        uint64_t next = index + 1;
+        while (next < kSlotCount && slots_[0][next].head == nullptr) {
+            ++next;
+        }
+        current_ = std::min(current_ + (next - index), nowMs + 1);
+    }
+}
+
+uint64_t TimerWheel::nextWakeMs() const {
+    if (size_ == 0) {
+        return UINT64_MAX;
+    }
+    uint64_t index = current_ & kSlotMask;
+    for (uint64_t i = index; i < kSlotCount; ++i) {
+        if (slots_[0][i].head) {
+            return current_ + (i - index);
+        }
+    }
+    return current_ + (kSlotCount - index);
+}
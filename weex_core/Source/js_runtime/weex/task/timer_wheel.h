@@ -0,0 +1,84 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+//
+// Hierarchical timing wheel backing TimerQueue.
+//
+
+#ifndef WEEXV8_TIMERWHEEL_H
+#define WEEXV8_TIMERWHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class TimerTask;
+
+// Four levels of 64 slots with a one millisecond tick, so timers up to ~4.6
+// hours away are placed directly and anything further is clamped to the last
+// slot and cascaded down when it comes round. Adding and removing a timer is
+// O(1); advancing only visits non-empty level-0 slots and cascades one upper
+// slot every 64 ticks. Timers are linked intrusively through TimerTask, so the
+// wheel never allocates. Not thread safe, TimerQueue holds its lock around it.
+class TimerWheel {
+
+public:
+    struct Slot {
+        TimerTask *head = nullptr;
+        TimerTask *tail = nullptr;
+    };
+
+    explicit TimerWheel(uint64_t nowMs);
+
+    // Schedules a task for its TimerTask::when, rounded up to the next tick.
+    void add(TimerTask *task);
+
+    void remove(TimerTask *task);
+
+    // Moves every task due at or before nowMs into expired, earliest tick
+    // first and in insertion order within a tick.
+    void advance(uint64_t nowMs, std::vector<TimerTask *> &expired);
+
+    // Earliest tick at which advance() may have work to do, UINT64_MAX when
+    // the wheel is empty.
+    uint64_t nextWakeMs() const;
+
+    bool empty() const { return size_ == 0; }
+
+    size_t size() const { return size_; }
+
+private:
+    static const int kSlotBits = 6;
+    static const int kSlotCount = 1 << kSlotBits;
+    static const uint64_t kSlotMask = kSlotCount - 1;
+    static const int kLevelCount = 4;
+    static const uint64_t kMaxDelta = (1ULL << (kSlotBits * kLevelCount)) - 1;
+
+    void place(TimerTask *task);
+
+    void cascade(int level, uint64_t index);
+
+    Slot slots_[kLevelCount][kSlotCount];
+    // The next tick advance() will process. Every level-0 timer is due
+    // within kSlotCount ticks of it.
+    uint64_t current_;
+    size_t size_;
+};
+
+
+#endif //WEEXV8_TIMERWHEEL_H
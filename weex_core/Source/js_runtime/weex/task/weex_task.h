@@ -25,14 +25,27 @@
 
 #include "base/time_calculator.h"
 #include "base/android/ThreadLocker.h"
+#include "base/thread/mpsc_queue.h"
 #include "js_runtime/weex/utils/weex_jsc_utils.h"
 #include "js_runtime/weex/object/weex_runtime_v2.h"
 //#include "android/jsengine/weex_runtime.h"
 
-class WeexTask {
+class WeexTask : public weex::base::MpscNode {
 
 public:
 
+    // Scheduling classes, most urgent first. WeexTaskQueue keeps tasks of one
+    // instance in order and picks between instances by the class of each
+    // instance's oldest task.
+    enum Priority {
+        kPriorityInput = 0,
+        kPriorityTimer,
+        kPriorityNormal,
+        kPriorityCreateInstance,
+        kPriorityService,
+        kPriorityCount
+    };
+
     class Future {
 
     public:
@@ -53,18 +66,23 @@ public:
 
     std::string instanceId;
     int taskId;
-    explicit WeexTask(const std::string &instanceId, int taskId) : future_(nullptr) {
+    explicit WeexTask(const std::string &instanceId, int taskId)
+        : timeCalculator(weex::base::TaskPlatform::JSS_ENGINE, "", instanceId), future_(nullptr) {
         this->instanceId = instanceId;
         this->taskId = taskId;
-        this->timeCalculator = new weex::base::TimeCalculator(weex::base::TaskPlatform::JSS_ENGINE, "", this->instanceId);
     };
 
     explicit WeexTask(const std::string &instanceId) : WeexTask(instanceId, genTaskId()) {};
 
-    virtual ~WeexTask() {if(timeCalculator != nullptr) delete timeCalculator;};
+    virtual ~WeexTask() {};
 
     virtual void run(WeexRuntime *runtime) = 0;
     virtual std::string taskName() = 0;
+    virtual Priority priority() { return kPriorityNormal; }
+
+    // Drops a pending timer carried by this task, returns false if the task
+    // does not carry it.
+    virtual bool cancelTimer(int timerId) { return false; }
 
     inline void set_future(Future* future) {
         future_ = future;
@@ -74,9 +92,16 @@ public:
         return future_;
     }
 
-    weex::base::TimeCalculator *timeCalculator;
+    weex::base::TimeCalculator timeCalculator;
 
     bool is_from_instance = true;
+
+    // Number of instance-less tasks queued ahead of this one, set by
+    // WeexTaskQueue.
+    uint64_t queueEpoch = 0;
+
+    // Trace flow the task continues, taken from the adding thread or new.
+    uint64_t traceFlowId = 0;
 private:
     Future* future_;
 };
@@ -0,0 +1,104 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+//
+// Free lists for the task types created at high rate.
+//
+
+#ifndef WEEXV8_WEEX_TASK_POOL_H
+#define WEEXV8_WEEX_TASK_POOL_H
+
+#include <sched.h>
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+// Keeps up to kCapacity freed blocks of sizeof(T) for reuse. Tasks are
+// created on the bridge threads and deleted on the JS thread, so the list is
+// shared and guarded by a spin lock held for a handful of instructions.
+// Blocks of any other size (a subclass of T) go straight to the heap.
+template <typename T>
+class WeexTaskPool {
+public:
+    static void *allocate(size_t size) {
+        if (size == sizeof(T)) {
+            Pool &pool = instance();
+            pool.lock();
+            if (pool.count > 0) {
+                void *block = pool.blocks[--pool.count];
+                pool.unlock();
+                return block;
+            }
+            pool.unlock();
+        }
+        return ::operator new(size);
+    }
+
+    static void release(void *block, size_t size) {
+        if (block == nullptr) {
+            return;
+        }
+        if (size == sizeof(T)) {
+            Pool &pool = instance();
+            pool.lock();
+            if (pool.count < kCapacity) {
+                pool.blocks[pool.count++] = block;
+                pool.unlock();
+                return;
+            }
+            pool.unlock();
+        }
+        ::operator delete(block);
+    }
+
+private:
+    static const size_t kCapacity = 64;
+
+    struct Pool {
+        std::atomic_flag busy = ATOMIC_FLAG_INIT;
+        size_t count = 0;
+        void *blocks[kCapacity];
+
+        void lock() {
+            while (busy.test_and_set(std::memory_order_acquire)) {
+                sched_yield();
+            }
+        }
+
+        void unlock() {
+            busy.clear(std::memory_order_release);
+        }
+    };
+
+    static Pool &instance() {
+        static Pool pool;
+        return pool;
+    }
+};
+
+// Routes new/delete of Type through WeexTaskPool<Type>. Deleting through a
+// base pointer still lands here as long as the base destructor is virtual.
+#define WEEX_TASK_POOLED(Type)                                      \
+    static void *operator new(size_t size) {                        \
+        return WeexTaskPool<Type>::allocate(size);                  \
+    }                                                               \
+    static void operator delete(void *block, size_t size) {         \
+        WeexTaskPool<Type>::release(block, size);                   \
+    }
+
+#endif //WEEXV8_WEEX_TASK_POOL_H
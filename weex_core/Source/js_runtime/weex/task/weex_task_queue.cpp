@@ -22,22 +22,40 @@
 
 #include "weex_task_queue.h"
 
+#include <sched.h>
 #include <unistd.h>
 #include "js_runtime/weex/task/impl/native_timer_task.h"
 #include "android/jsengine/bridge/script/script_bridge_in_multi_process.h"
 #include "android/jsengine/bridge/script/core_side_in_multi_process.h"
 #include "android/jsengine/object/weex_env.h"
+#include "base/trace/trace_event.h"
 #include "js_runtime/weex/object/weex_runtime_v2.h"
 
 void WeexTaskQueue::run(WeexTask *task) {
     if(task == nullptr || WeexEnv::getEnv()->is_app_crashed()) {
         return;
     }
-    task->timeCalculator->set_task_name(task->taskName());
-    task->timeCalculator->taskStart();
+    if (task->timeCalculator.enabled()) {
+        task->timeCalculator.set_task_name(task->taskName());
+    }
+    // Covers the dom action flush too, so the IPC messages it sends carry
+    // the task's flow.
+    weex::base::ScopedTraceFlow traceFlow(task->traceFlowId);
+    weex::base::ScopedTraceEvent traceEvent;
+    if (weex::base::TraceLog::IsEnabled()) {
+        traceEvent.Begin("weex.js", task->taskName().c_str(), task->instanceId.c_str());
+    }
+    task->timeCalculator.taskStart();
+    running_ = task;
     task->run(weexRuntime);
-    task->timeCalculator->taskEnd();
+    running_ = nullptr;
+    task->timeCalculator.taskEnd();
     delete task;
+    if (isMultiProgress) {
+        // dom actions produced by this task are sent to WeexCore as one batch.
+        static_cast<weex::bridge::js::CoreSideInMultiProcess *>(
+                WeexEnv::getEnv()->scriptBridge()->core_side())->FlushDomActions();
+    }
 }
 
 
@@ -47,64 +65,152 @@ WeexTaskQueue::~WeexTaskQueue() {
 }
 
 int WeexTaskQueue::addTask(WeexTask *task) {
-    return _addTask(task, false);
+    return _addTask(task);
 }
 
 
+int WeexTaskQueue::addTimerTask(const std::string &id, uint32_t function, int taskId,  bool one_shot, bool is_from_instance) {
+    //LOGE("[weex-binding ]addTimerTask  on ==> taskquene %d",taskId);
+    WeexTask *task = new NativeTimerTask(id, function,taskId, one_shot);
+    //task->set_global_object(global_object);
+    task->is_from_instance = is_from_instance;
+    return _addTask(task);
+}
+
 WeexTask *WeexTaskQueue::getTask() {
-    WeexTask *task = nullptr;
-    while (task == nullptr) {
+    while (true) {
         threadLocker.lock();
-        while (taskQueue_.empty() || !isInitOk) {
-            threadLocker.wait();
+        drainInbox();
+        if (size_ != 0 && isInitOk) {
+            WeexTask *task = nullptr;
+            if (!WeexEnv::getEnv()->is_app_crashed()) {
+                task = popTask();
+            }
+            threadLocker.unlock();
+            return task;
         }
+        threadLocker.unlock();
 
-        if (taskQueue_.empty()) {
-            threadLocker.unlock();
+        auto key = event_.PrepareWait();
+        if (pending_.load() != 0) {
+            // a producer is still linking its task in.
+            event_.CancelWait();
+            sched_yield();
             continue;
         }
+        event_.Wait(key);
+    }
+}
 
-        if(WeexEnv::getEnv()->is_app_crashed()) {
-          threadLocker.unlock();
-          return nullptr;
+void WeexTaskQueue::drainInbox() {
+    WeexTask *task;
+    while ((task = inbox_.Pop()) != nullptr) {
+        enqueue(task);
+        pending_.fetch_sub(1);
+    }
+}
+
+WeexTask *WeexTaskQueue::popTask() {
+    WeexTask *task;
+    // An instance-less task runs once everything queued before it has run,
+    // which also releases the lanes that were waiting for it.
+    if (!global_.empty() && epochPending_.front() == 0) {
+        task = global_.front();
+        global_.pop_front();
+        epochPending_.pop_front();
+        ++globalDone_;
+        --size_;
+        Lane *lane = blocked_.head;
+        blocked_ = LaneList();
+        while (lane) {
+            Lane *next = lane->next;
+            lane->list = nullptr;
+            lane->prev = nullptr;
+            lane->next = nullptr;
+            schedule(lane);
+            lane = next;
         }
+        return task;
+    }
 
-        assert(!taskQueue_.empty());
-        task = taskQueue_.front();
-        taskQueue_.pop_front();
-        threadLocker.unlock();
+    // The oldest pending instance task is always runnable here, so some
+    // ready list is non-empty.
+    Lane *lane = nullptr;
+    if (++picks_ < kFairnessInterval) {
+        for (int i = 0; i < WeexTask::kPriorityCount && lane == nullptr; ++i) {
+            lane = ready_[i].head;
+        }
+    } else {
+        picks_ = 0;
+        for (int i = WeexTask::kPriorityCount - 1; i >= 0 && lane == nullptr; --i) {
+            lane = ready_[i].head;
+        }
+    }
+    if (lane == nullptr) {
+        return nullptr;
     }
 
+    task = lane->tasks.front();
+    eraseTask(lane, lane->tasks.begin());
     return task;
 }
 
-int WeexTaskQueue::addTimerTask(const std::string &id, uint32_t function, int taskId,  bool one_shot, bool is_from_instance) {
-    //LOGE("[weex-binding ]addTimerTask  on ==> taskquene %d",taskId);
-    WeexTask *task = new NativeTimerTask(id, function,taskId, one_shot);
-    //task->set_global_object(global_object);
-    task->is_from_instance = is_from_instance;
-    return _addTask(
-            task,
-            false);
+void WeexTaskQueue::schedule(Lane *lane) {
+    LaneList *list;
+    WeexTask *head = lane->tasks.front();
+    if (head->queueEpoch > globalDone_) {
+        list = &blocked_;
+    } else {
+        list = &ready_[head->priority()];
+    }
+
+    lane->list = list;
+    lane->next = nullptr;
+    lane->prev = list->tail;
+    if (list->tail) {
+        list->tail->next = lane;
+    } else {
+        list->head = lane;
+    }
+    list->tail = lane;
 }
 
-void WeexTaskQueue::removeTimer(int taskId) {
-    threadLocker.lock();
-    if (taskQueue_.empty()) {
-        threadLocker.unlock();
+void WeexTaskQueue::unlink(Lane *lane) {
+    LaneList *list = lane->list;
+    if (list == nullptr) {
         return;
+    }
+    if (lane->prev) {
+        lane->prev->next = lane->next;
     } else {
-        for (std::deque<WeexTask *>::iterator it = taskQueue_.begin(); it < taskQueue_.end(); ++it) {
-            auto reference = *it;
-            if (reference->taskId == taskId) {
-                NativeTimerTask* timer_task = static_cast<NativeTimerTask*>(reference);
-                taskQueue_.erase(it);
-                delete (timer_task);
-            }
-        }
+        list->head = lane->next;
+    }
+    if (lane->next) {
+        lane->next->prev = lane->prev;
+    } else {
+        list->tail = lane->prev;
+    }
+    lane->list = nullptr;
+    lane->prev = nullptr;
+    lane->next = nullptr;
+}
+
+void WeexTaskQueue::eraseTask(Lane *lane, std::deque<WeexTask *>::iterator it) {
+    bool wasHead = it == lane->tasks.begin();
+    --epochPending_[(*it)->queueEpoch - globalDone_];
+    --size_;
+    lane->tasks.erase(it);
+    if (!wasHead) {
+        return;
+    }
+    // Requeue behind lanes of the same class, which is what makes instances
+    // of one class take turns.
+    unlink(lane);
+    if (lane->tasks.empty()) {
+        lanes_.erase(lane->id);
+    } else {
+        schedule(lane);
     }
-    threadLocker.unlock();
-    threadLocker.signal();
 }
 
 void WeexTaskQueue::start() {
@@ -146,41 +252,91 @@ void WeexTaskQueue::init() {
     pthread_setname_np(thread, "WeexTaskQueueThread");
 }
 
-int WeexTaskQueue::_addTask(WeexTask *task, bool front) {
-    threadLocker.lock();
-    if (front) {
-        taskQueue_.push_front(task);
-    } else {
-        taskQueue_.push_back(task);
-    }
+WeexTaskQueue::WeexTaskQueue(bool isMultiProgress) : weexRuntime(nullptr) {
+    this->isMultiProgress = isMultiProgress;
+    this->weexRuntime = nullptr;
+    epochPending_.push_back(0);
+}
 
-    int size = taskQueue_.size();
-    threadLocker.unlock();
-    threadLocker.signal();
+int WeexTaskQueue::_addTask(WeexTask *task) {
+    if (weex::base::TraceLog::IsEnabled()) {
+        uint64_t flowId = weex::base::TraceLog::CurrentFlowId();
+        task->traceFlowId = flowId != 0 ? flowId : weex::base::TraceLog::NewFlowId();
+        weex::base::ScopedTraceFlow traceFlow(task->traceFlowId);
+        TRACE_EVENT_WITH_ARG("weex.js", "WeexTaskQueue::addTask", task->instanceId.c_str());
+    }
+    int size = pending_.fetch_add(1) + 1;
+    inbox_.Push(task);
+    event_.Notify();
     return size;
 }
 
-WeexTaskQueue::WeexTaskQueue(bool isMultiProgress) : weexRuntime(nullptr) {
-    this->isMultiProgress = isMultiProgress;
-    this->weexRuntime = nullptr;
+void WeexTaskQueue::enqueue(WeexTask *task) {
+    if (task->instanceId.empty()) {
+        global_.push_back(task);
+        ++globalAdded_;
+        epochPending_.push_back(0);
+    } else {
+        task->queueEpoch = globalAdded_;
+        ++epochPending_.back();
+        Lane &lane = lanes_[task->instanceId];
+        lane.tasks.push_back(task);
+        if (lane.tasks.size() == 1) {
+            lane.id = task->instanceId;
+            schedule(&lane);
+        }
+    }
+    ++size_;
+}
+
+void WeexTaskQueue::removeTimer(int taskId) {
+    // A callback may clear a timer of the batch that is running it.
+    if (running_ != nullptr && running_->cancelTimer(taskId)) {
+        return;
+    }
+    threadLocker.lock();
+    drainInbox();
+    for (auto it = global_.begin(); it != global_.end(); ++it) {
+        auto reference = *it;
+        if (reference->cancelTimer(taskId)) {
+            // keep the emptied task in place, instance-less tasks anchor the
+            // ordering of everything queued after them.
+            threadLocker.unlock();
+            return;
+        }
+    }
+    // A cancelled timer task stays queued, it still releases the JS functions
+    // of its one-shot timers when it runs.
+    for (auto &entry : lanes_) {
+        for (auto reference : entry.second.tasks) {
+            if (reference->cancelTimer(taskId)) {
+                threadLocker.unlock();
+                return;
+            }
+        }
+    }
+    threadLocker.unlock();
 }
 
 void WeexTaskQueue::removeAllTask(const std::string &id) {
     threadLocker.lock();
-    if (taskQueue_.empty()) {
+    drainInbox();
+    auto found = lanes_.find(id);
+    if (found == lanes_.end()) {
         threadLocker.unlock();
         return;
-    } else {
-        for (std::deque<WeexTask *>::iterator it = taskQueue_.begin(); it < taskQueue_.end(); ++it) {
-            auto reference = *it;
-            if (reference->instanceId == id) {
-                taskQueue_.erase(it);
-                delete (reference);
-                reference = nullptr;
-            }
+    }
+    Lane *lane = &found->second;
+    for (auto reference : lane->tasks) {
+        --epochPending_[reference->queueEpoch - globalDone_];
+        --size_;
+        if (reference->future() != nullptr) {
+            std::unique_ptr<WeexJSResult> result(new WeexJSResult());
+            reference->future()->setResult(result);
         }
+        delete (reference);
     }
+    unlink(lane);
+    lanes_.erase(found);
     threadLocker.unlock();
-    threadLocker.signal();
 }
-
@@ -24,9 +24,23 @@
 #define WEEXV8_WEEXTASKQUEUE_H
 
 
+#include <atomic>
 #include <deque>
+#include <string>
+#include <unordered_map>
+#include "base/thread/event_count.h"
+#include "base/thread/mpsc_queue.h"
 #include "js_runtime/weex/task/weex_task.h"
 
+// Tasks of one instance run in the order they were added. Between instances
+// the queue picks the one whose oldest task has the most urgent
+// WeexTask::Priority, round-robin within a class, so a tap on the foreground
+// page does not wait behind another page's bundle evaluation. Tasks without
+// an instance (framework, services, global config) keep their position
+// relative to everything else.
+//
+// Producers only push onto a lock-free inbox. The JS thread moves the inbox
+// into the lanes and sleeps on an EventCount when both are empty.
 class WeexTaskQueue {
 
 public:
@@ -38,8 +52,12 @@ public:
 
     WeexTask *getTask();
 
+    // Cancels a timer in a queued or running timer task. Called on the JS
+    // thread.
     void removeTimer(int taskId);
 
+    // Drops every pending task of an instance. Waiters on a dropped task's
+    // future get an empty result.
     void removeAllTask(const std::string &id);
 
     int addTimerTask(const std::string &id, uint32_t function, int taskId, bool one_shot, bool is_from_instance);
@@ -48,6 +66,12 @@ public:
 
     void init();
 
+    // Tasks added and not run yet, read without the lock so only a hint.
+    size_t backlog() const {
+        return size_.load(std::memory_order_relaxed) +
+               static_cast<size_t>(pending_.load(std::memory_order_relaxed));
+    }
+
     bool isInitOk = false;
 
 public:
@@ -55,10 +79,63 @@ public:
     bool isMultiProgress;
 
 private:
-    int _addTask(WeexTask *task, bool front);
-
-    std::deque<WeexTask *> taskQueue_;
+    struct Lane;
+
+    struct LaneList {
+        Lane *head = nullptr;
+        Lane *tail = nullptr;
+    };
+
+    // Pending tasks of one instance, linked into the ready list of its head
+    // task's priority, or into blocked_ while that task waits for an older
+    // instance-less task.
+    struct Lane {
+        std::string id;
+        std::deque<WeexTask *> tasks;
+        LaneList *list = nullptr;
+        Lane *prev = nullptr;
+        Lane *next = nullptr;
+    };
+
+    // Every kFairnessInterval picks serve the least urgent ready class
+    // first so creation and services are never starved by a busy page.
+    static const int kFairnessInterval = 16;
+
+    int _addTask(WeexTask *task);
+
+    // Moves published tasks into their lanes. Called with threadLocker held,
+    // which also makes the caller the inbox's only consumer.
+    void drainInbox();
+
+    void enqueue(WeexTask *task);
+
+    WeexTask *popTask();
+
+    void schedule(Lane *lane);
+
+    void unlink(Lane *lane);
+
+    void eraseTask(Lane *lane, std::deque<WeexTask *>::iterator it);
+
+    std::unordered_map<std::string, Lane> lanes_;
+    LaneList ready_[WeexTask::kPriorityCount];
+    LaneList blocked_;
+    std::deque<WeexTask *> global_;
+    // Pending instance tasks per epoch, starting at globalDone_.
+    std::deque<int> epochPending_;
+    uint64_t globalAdded_ = 0;
+    uint64_t globalDone_ = 0;
+    std::atomic<size_t> size_{0};
+    int picks_ = 0;
+    // Guards the lanes, shared by the JS thread and the remove calls.
     ThreadLocker threadLocker;
+    weex::base::MpscQueue<WeexTask> inbox_;
+    // Tasks added but not drained yet, raised before the push so a parked
+    // consumer never misses one.
+    std::atomic<int> pending_{0};
+    weex::base::EventCount event_;
+    // Task being run, only touched on the JS thread.
+    WeexTask *running_ = nullptr;
 };
 
 
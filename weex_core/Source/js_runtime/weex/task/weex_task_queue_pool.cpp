@@ -0,0 +1,106 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+//
+// Shards instances over several WeexTaskQueue/WeexRuntimeV2 pairs.
+//
+
+#include "js_runtime/weex/task/weex_task_queue_pool.h"
+
+#include "base/log_defines.h"
+#include "js_runtime/weex/task/weex_task_queue.h"
+#include "js_runtime/weex/task/impl/init_framework_task.h"
+
+void WeexTaskQueuePool::setPrimary(WeexTaskQueue *queue) {
+    if (queues_.empty()) {
+        queues_.push_back({queue, 0});
+    } else {
+        queues_[0].queue = queue;
+    }
+}
+
+void WeexTaskQueuePool::grow(int count, const std::string &script, std::vector<INIT_FRAMEWORK_PARAMS *> &params) {
+    if (queues_.empty()) {
+        return;
+    }
+    if (count > kMaxQueueCount) {
+        count = kMaxQueueCount;
+    }
+    while (static_cast<int>(queues_.size()) < count) {
+        auto queue = new WeexTaskQueue(queues_[0].queue->isMultiProgress);
+        queue->addTask(new InitFrameworkTask(script, params));
+        queue->init();
+        queues_.push_back({queue, 0});
+        LOGE("start js runtime %d", static_cast<int>(queues_.size()) - 1);
+    }
+}
+
+WeexTaskQueue *WeexTaskQueuePool::find(const std::string &id) const {
+    auto iter = placements_.find(id);
+    return iter == placements_.end() ? nullptr : iter->second;
+}
+
+WeexTaskQueue *WeexTaskQueuePool::place(const std::string &id) {
+    WeexTaskQueue *queue = find(id);
+    if (queue != nullptr || queues_.empty()) {
+        return queue;
+    }
+    Entry *best = &queues_[0];
+    size_t bestBacklog = best->queue->backlog();
+    for (size_t i = 1; i < queues_.size(); ++i) {
+        Entry *entry = &queues_[i];
+        size_t backlog = entry->queue->backlog();
+        if (entry->instances < best->instances ||
+                (entry->instances == best->instances && backlog < bestBacklog)) {
+            best = entry;
+            bestBacklog = backlog;
+        }
+    }
+    bind(id, best->queue);
+    return best->queue;
+}
+
+void WeexTaskQueuePool::bind(const std::string &id, WeexTaskQueue *queue) {
+    release(id);
+    placements_[id] = queue;
+    Entry *entry = entryOf(queue);
+    if (entry != nullptr) {
+        ++entry->instances;
+    }
+}
+
+void WeexTaskQueuePool::release(const std::string &id) {
+    auto iter = placements_.find(id);
+    if (iter == placements_.end()) {
+        return;
+    }
+    Entry *entry = entryOf(iter->second);
+    if (entry != nullptr) {
+        --entry->instances;
+    }
+    placements_.erase(iter);
+}
+
+WeexTaskQueuePool::Entry *WeexTaskQueuePool::entryOf(WeexTaskQueue *queue) {
+    for (auto &entry : queues_) {
+        if (entry.queue == queue) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
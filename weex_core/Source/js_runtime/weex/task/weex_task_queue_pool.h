@@ -0,0 +1,79 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+//
+// Shards instances over several WeexTaskQueue/WeexRuntimeV2 pairs.
+//
+
+#ifndef WEEXV8_WEEXTASKQUEUEPOOL_H
+#define WEEXV8_WEEXTASKQUEUEPOOL_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "android/jsengine/object/args/init_framework_args.h"
+
+class WeexTaskQueue;
+
+// Each queue runs its own thread and VM, so instances placed on different
+// queues evaluate JS in parallel, e.g. the two pages of a split screen or a
+// page prefetched behind the visible one. An instance is placed once, on the
+// queue with the fewest live instances (then the shortest backlog), and
+// stays there until it is released. Queue 0 is the one the bridge created;
+// the others are started by grow and initialize their own framework.
+//
+// Not thread safe, used from the bridge thread like the rest of
+// ScriptSideInQueue.
+class WeexTaskQueuePool {
+
+public:
+    static const int kMaxQueueCount = 4;
+
+    void setPrimary(WeexTaskQueue *queue);
+
+    // Starts queues until there are count of them.
+    void grow(int count, const std::string &script, std::vector<INIT_FRAMEWORK_PARAMS *> &params);
+
+    size_t size() const { return queues_.size(); }
+
+    WeexTaskQueue *at(size_t index) const { return queues_[index].queue; }
+
+    // Queue an instance was placed on, nullptr if it was not.
+    WeexTaskQueue *find(const std::string &id) const;
+
+    // Places an instance unless it already is.
+    WeexTaskQueue *place(const std::string &id);
+
+    // Places an instance on a given queue, which need not be in the pool.
+    void bind(const std::string &id, WeexTaskQueue *queue);
+
+    void release(const std::string &id);
+
+private:
+    struct Entry {
+        WeexTaskQueue *queue;
+        int instances;
+    };
+
+    Entry *entryOf(WeexTaskQueue *queue);
+
+    std::vector<Entry> queues_;
+    std::unordered_map<std::string, WeexTaskQueue *> placements_;
+};
+
+#endif //WEEXV8_WEEXTASKQUEUEPOOL_H
@@ -0,0 +1,132 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef IPCBATCH_H
+#define IPCBATCH_H
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+// A batch packs several messages into one byte array so that they can travel
+// through the page queue as a single IPC message. Record layout:
+// msg uint32_t
+// argc uint32_t
+// argc times: length uint32_t, data char[length], '\0'
+class IPCBatchWriter {
+public:
+    void begin(uint32_t msg, uint32_t argc)
+    {
+        if (m_buffer.empty())
+            m_buffer.reserve(4096);
+        append(&msg, sizeof(msg));
+        append(&argc, sizeof(argc));
+        ++m_count;
+    }
+
+    void add(const char* data, size_t length = 0)
+    {
+        if (data == nullptr) {
+            length = 0;
+        } else if (length == 0) {
+            length = strlen(data);
+        }
+        uint32_t n = static_cast<uint32_t>(length);
+        append(&n, sizeof(n));
+        if (n)
+            append(data, n);
+        m_buffer.push_back('\0');
+    }
+
+    void clear()
+    {
+        m_buffer.clear();
+        m_count = 0;
+    }
+
+    const char* data() const { return m_buffer.data(); }
+    size_t length() const { return m_buffer.size(); }
+    size_t count() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+
+private:
+    void append(const void* data, size_t length)
+    {
+        const char* p = static_cast<const char*>(data);
+        m_buffer.insert(m_buffer.end(), p, p + length);
+    }
+
+    std::vector<char> m_buffer;
+    size_t m_count = 0;
+};
+
+// Walks a batch without copying, arguments point into the batch itself and
+// are always terminated with zero.
+class IPCBatchReader {
+public:
+    static const uint32_t kMaxArgs = 8;
+
+    IPCBatchReader(const char* data, size_t length)
+        : m_cursor(data)
+        , m_end(data + length)
+    {
+    }
+
+    bool next()
+    {
+        m_argc = 0;
+        if (!read(&m_msg) || !read(&m_argc) || m_argc > kMaxArgs) {
+            m_argc = 0;
+            return false;
+        }
+        for (uint32_t i = 0; i < m_argc; ++i) {
+            uint32_t n;
+            if (!read(&n) || static_cast<size_t>(m_end - m_cursor) < n + 1u) {
+                m_argc = 0;
+                return false;
+            }
+            m_args[i] = m_cursor;
+            m_lengths[i] = n;
+            m_cursor += n + 1;
+        }
+        return true;
+    }
+
+    uint32_t msg() const { return m_msg; }
+    uint32_t argc() const { return m_argc; }
+    const char* arg(uint32_t index) const { return index < m_argc ? m_args[index] : nullptr; }
+    uint32_t argLength(uint32_t index) const { return index < m_argc ? m_lengths[index] : 0; }
+
+private:
+    bool read(uint32_t* value)
+    {
+        if (static_cast<size_t>(m_end - m_cursor) < sizeof(uint32_t))
+            return false;
+        memcpy(value, m_cursor, sizeof(uint32_t));
+        m_cursor += sizeof(uint32_t);
+        return true;
+    }
+
+    const char* m_cursor;
+    const char* m_end;
+    uint32_t m_msg = 0;
+    uint32_t m_argc = 0;
+    const char* m_args[kMaxArgs];
+    uint32_t m_lengths[kMaxArgs];
+};
+#endif /* IPCBATCH_H */
@@ -32,6 +32,7 @@
 #include "IPCLog.h"
 #include "IPCResult.h"
 #include "IPCString.h"
+#include "IPCTracer.h"
 #include "Serializing/IPCSerializer.h"
 #include "futex.h"
 #include <errno.h>
@@ -40,11 +41,28 @@
 #include <vector>
 
 namespace {
+// Appended after the data of a package when tracing is enabled on the sender
+// side or the sending thread has a trace flow. Peers which do not trace
+// ignore it, since BufferAssembler stops after the data indicated by the
+// types. sendTime is 0 when only the flow is sent.
+struct TraceTrailer {
+    uint32_t magic;
+    uint32_t sendTimeLow;
+    uint32_t sendTimeHigh;
+    uint32_t flowLow;
+    uint32_t flowHigh;
+};
+static const uint32_t kTraceTrailerMagic = 0x46435049; // "IPCF"
+
+// Package length of a page which only refers to a package in the large
+// payload region, followed by msg, offset and length.
+static const uint32_t kLargePayloadTag = static_cast<uint32_t>(-1);
+
 class BufferAssembler
     : public IPCResult,
       public IPCArguments {
 public:
-    void readFromBuffer(const char*);
+    const char* readFromBuffer(const char*);
     void readTypes(const char*&);
     void readData(const char*&);
     // IPCResult
@@ -65,10 +83,11 @@ private:
     std::vector<std::unique_ptr<char[]>> m_datas;
 };
 
-void BufferAssembler::readFromBuffer(const char* blob)
+const char* BufferAssembler::readFromBuffer(const char* blob)
 {
     readTypes(blob);
     readData(blob);
+    return blob;
 }
 
 void BufferAssembler::readTypes(const char*& blob)
@@ -215,7 +234,11 @@ size_t BufferAssembler::getCount()
 }
 
 IPCCommunicator::IPCCommunicator(IPCFutexPageQueue* futexPageQueue)
-    : m_futexPageQueue(futexPageQueue)
+    : m_largePayload(nullptr)
+    , m_packageLength(0)
+    , m_peerSendTime(0)
+    , m_peerFlow(0)
+    , m_futexPageQueue(futexPageQueue)
 {
 }
 
@@ -226,14 +249,14 @@ IPCCommunicator::~IPCCommunicator()
 std::unique_ptr<IPCResult> IPCCommunicator::assembleResult()
 {
     std::unique_ptr<BufferAssembler> bufferAssembler(new BufferAssembler());
-    bufferAssembler->readFromBuffer(getBlob());
+    readTraceTrailer(bufferAssembler->readFromBuffer(getBlob()));
     return std::unique_ptr<IPCResult>(bufferAssembler.release());
 }
 
 std::unique_ptr<IPCArguments> IPCCommunicator::assembleArguments()
 {
     std::unique_ptr<BufferAssembler> bufferAssembler(new BufferAssembler());
-    bufferAssembler->readFromBuffer(getBlob());
+    readTraceTrailer(bufferAssembler->readFromBuffer(getBlob()));
     return std::unique_ptr<IPCArguments>(bufferAssembler.release());
 }
 
@@ -282,7 +305,39 @@ void IPCCommunicator::doSendBufferOnly(IPCBuffer* buffer)
 {
     const char* data = static_cast<const char*>(buffer->get());
     uint32_t length = buffer->length();
-    doSendBufferOnly(data, length);
+    bool timed = tracer()->isEnabled();
+    uint64_t flow = IPCTracer::currentFlow();
+    if (!timed && !flow) {
+        doSendBufferOnly(data, length);
+        return;
+    }
+    std::unique_ptr<char[]> traced(new char[length + sizeof(TraceTrailer)]);
+    memcpy(traced.get(), data, length);
+    uint64_t now = timed ? IPCTracer::now() : 0;
+    TraceTrailer trailer = { kTraceTrailerMagic, static_cast<uint32_t>(now), static_cast<uint32_t>(now >> 32),
+        static_cast<uint32_t>(flow), static_cast<uint32_t>(flow >> 32) };
+    memcpy(traced.get() + length, &trailer, sizeof(trailer));
+    doSendBufferOnly(traced.get(), length + sizeof(TraceTrailer));
+}
+
+IPCTracer* IPCCommunicator::tracer()
+{
+    return m_futexPageQueue->tracer();
+}
+
+void IPCCommunicator::readTraceTrailer(const char* end)
+{
+    m_peerSendTime = 0;
+    m_peerFlow = 0;
+    const char* packageEnd = getBlob() - sizeof(uint32_t) + m_packageLength;
+    if (packageEnd - end != static_cast<ptrdiff_t>(sizeof(TraceTrailer)))
+        return;
+    TraceTrailer trailer;
+    memcpy(&trailer, end, sizeof(trailer));
+    if (trailer.magic != kTraceTrailerMagic)
+        return;
+    m_peerSendTime = static_cast<uint64_t>(trailer.sendTimeHigh) << 32 | trailer.sendTimeLow;
+    m_peerFlow = static_cast<uint64_t>(trailer.flowHigh) << 32 | trailer.flowLow;
 }
 
 uint32_t IPCCommunicator::doReadPackage()
@@ -292,6 +347,14 @@ uint32_t IPCCommunicator::doReadPackage()
     m_futexPageQueue->lockReadPage();
     void* sharedMemory = m_futexPageQueue->getCurrentReadPage();
     length = static_cast<uint32_t*>(sharedMemory)[0];
+    if (length == kLargePayloadTag) {
+        uint32_t* header = static_cast<uint32_t*>(sharedMemory);
+        // stays valid until releaseBlob unlocks the page.
+        m_largePayload = m_futexPageQueue->getPeerLargePayload(header[2], header[3]);
+        m_packageLength = header[3];
+        return header[1];
+    }
+    m_packageLength = length;
     uint32_t availableSize = m_futexPageQueue->getPageSize() - sizeof(uint32_t);
     if (length < 2 * sizeof(uint32_t)) {
         releaseBlob();
@@ -311,6 +374,20 @@ void IPCCommunicator::doSendBufferOnly(const void* _data, size_t length)
     size_t pageSize = m_futexPageQueue->getPageSize();
     ssize_t byteTransfered;
     uint32_t* dstLength = static_cast<uint32_t*>(m_futexPageQueue->getCurrentWritePage());
+    if (length > pageSize - sizeof(uint32_t)) {
+        uint32_t offset;
+        void* payload = m_futexPageQueue->allocLargePayload(length, &offset);
+        if (payload) {
+            IPC_LOGD("send bytes through large payload region: length: %zu offset: %u", length, offset);
+            memcpy(payload, data, length);
+            dstLength[0] = kLargePayloadTag;
+            memcpy(dstLength + 1, data, sizeof(uint32_t));
+            dstLength[2] = offset;
+            dstLength[3] = static_cast<uint32_t>(length);
+            m_futexPageQueue->stepWrite();
+            return;
+        }
+    }
     // special handle the first part, which need a size
     // as header.
     dstLength[0] = length;
@@ -366,6 +443,8 @@ void IPCCommunicator::doRecvBufferOnly(void* _data, size_t length)
 
 const char* IPCCommunicator::getBlob()
 {
+    if (m_largePayload)
+        return m_largePayload + sizeof(uint32_t);
     if (m_package.get())
         return m_package.get() + sizeof(uint32_t);
     return static_cast<const char*>(m_futexPageQueue->getCurrentReadPage()) + sizeof(uint32_t) * 2;
@@ -373,6 +452,7 @@ const char* IPCCommunicator::getBlob()
 
 void IPCCommunicator::releaseBlob()
 {
+    m_largePayload = nullptr;
     m_package.reset();
     m_futexPageQueue->unlockReadPageAndStep();
 }
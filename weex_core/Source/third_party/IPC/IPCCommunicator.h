@@ -25,11 +25,13 @@
 #ifndef IPCCOMMUNICATOR_H
 #define IPCCOMMUNICATOR_H
 #include <memory>
+#include <stdint.h>
 
 class IPCResult;
 class IPCArguments;
 class IPCBuffer;
 class IPCFutexPageQueue;
+class IPCTracer;
 class IPCCommunicator {
 protected:
     explicit IPCCommunicator(IPCFutexPageQueue* futexPageQueue);
@@ -42,12 +44,25 @@ protected:
     uint32_t doReadPackage();
     const char* getBlob();
     void releaseBlob();
+    IPCTracer* tracer();
+    // monotonic time the peer started to send the last assembled package,
+    // 0 if the peer does not trace.
+    inline uint64_t peerSendTime() const { return m_peerSendTime; }
+    inline uint32_t packageLength() const { return m_packageLength; }
+    // trace flow id the peer sent the last assembled package under, or 0.
+    inline uint64_t peerFlow() const { return m_peerFlow; }
 
 private:
+    void readTraceTrailer(const char* end);
     void doSendBufferOnly(const void* data, size_t s);
     size_t doSendBufferPage(const void* data, size_t s, size_t pageSize);
     void doRecvBufferOnly(void* data, size_t s);
     std::unique_ptr<char[]> m_package;
+    // points into the peer's half of the large payload region.
+    const char* m_largePayload;
+    uint32_t m_packageLength;
+    uint64_t m_peerSendTime;
+    uint64_t m_peerFlow;
     // weakref to a IPCFutexPageQueue object.
     IPCFutexPageQueue* m_futexPageQueue;
 };
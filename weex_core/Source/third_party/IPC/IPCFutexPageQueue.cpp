@@ -38,12 +38,21 @@
 IPCFutexPageQueue::IPCFutexPageQueue(void* sharedMemory, size_t s, size_t id)
     : m_currentWrite(id)
     , m_currentRead(id ^ 1)
-    , m_pageSize(s / m_pagesCount)
+    , m_id(id)
+    , m_writeSequence(0)
+    , m_largePayloadSize(s - ipc_size)
+    , m_largePayloadHead(0)
+    , m_pageSize(ipc_size / m_pagesCount)
     , m_sharedMemory(sharedMemory)
     , m_tid(gettid())
+    , m_tracer(id ? "js" : "core")
+    , m_timeoutSec(m_defaultTimeoutSec)
 {
-    IPC_DCHECK(s == ipc_size);
+    IPC_DCHECK(s == ipc_size || s == ipc_mapping_size);
     IPC_LOGD("id: %zu", id);
+    if (m_largePayloadSize && mprotect(getLargePayloadHalf(id ^ 1), m_largePayloadSize / 2, PROT_READ) == -1) {
+        IPC_LOGE("failed to protect large payload region: %s", strerror(errno));
+    }
     for (int i = m_currentWrite; i < m_pagesCount; i += 2) {
         uint32_t* data = static_cast<uint32_t*>(getPage(i));
         data[1] |= m_finishTag;
@@ -53,11 +62,12 @@ IPCFutexPageQueue::IPCFutexPageQueue(void* sharedMemory, size_t s, size_t id)
 
 IPCFutexPageQueue::~IPCFutexPageQueue()
 {
-    // build a terminate msg.
-    uint32_t* data = static_cast<uint32_t*>(getPage(m_currentWrite));
-    data[1] = sizeof(uint32_t) * 2;
-    data[2] = MSG_TERMINATE;
-    data[3] = static_cast<uint32_t>(IPCType::END);
+    // build a terminate msg, laid out like any package after the futex and
+    // state words.
+    uint32_t* data = static_cast<uint32_t*>(getCurrentWritePage());
+    data[0] = sizeof(uint32_t) * 2;
+    data[1] = MSG_TERMINATE;
+    data[2] = static_cast<uint32_t>(IPCType::END);
     try {
         unlock(m_currentWrite);
     } catch (IPCException& e) {
@@ -65,6 +75,8 @@ IPCFutexPageQueue::~IPCFutexPageQueue()
     }
     IPC_LOGE("do munmap")
     munmap(m_sharedMemory, m_pageSize << 2);
+    if (m_largePayloadSize)
+        munmap(getLargePayloadHalf(0), m_largePayloadSize);
 }
 
 void IPCFutexPageQueue::stepWrite()
@@ -75,6 +87,51 @@ void IPCFutexPageQueue::stepWrite()
     m_currentWrite = step(m_currentWrite);
     lock(m_currentWrite, true);
     unlock(current);
+    ++m_writeSequence;
+}
+
+void IPCFutexPageQueue::reclaimLargePayloads()
+{
+    while (!m_largePayloads.empty() && m_writeSequence >= m_largePayloads.front().sequence + m_pagesCount / 2)
+        m_largePayloads.pop_front();
+    if (m_largePayloads.empty() && m_largePayloadHead) {
+        // give the pages back, bundles are usually sent once.
+        madvise(getLargePayloadHalf(m_id), m_largePayloadHead, MADV_REMOVE);
+        m_largePayloadHead = 0;
+    }
+}
+
+void* IPCFutexPageQueue::allocLargePayload(size_t length, uint32_t* offset)
+{
+    size_t halfSize = m_largePayloadSize / 2;
+    if (!halfSize || length > halfSize)
+        return nullptr;
+    reclaimLargePayloads();
+    size_t begin = m_largePayloadHead;
+    if (!m_largePayloads.empty()) {
+        size_t tail = m_largePayloads.front().begin;
+        if (begin <= tail) {
+            if (tail - begin < length)
+                return nullptr;
+        } else if (halfSize - begin < length) {
+            // wrap around.
+            if (tail < length)
+                return nullptr;
+            begin = 0;
+        }
+    }
+    m_largePayloadHead = (begin + length + 7) & ~static_cast<size_t>(7);
+    m_largePayloads.push_back({ m_writeSequence, begin });
+    *offset = static_cast<uint32_t>(begin);
+    return getLargePayloadHalf(m_id) + begin;
+}
+
+const char* IPCFutexPageQueue::getPeerLargePayload(uint32_t offset, uint32_t length)
+{
+    size_t halfSize = m_largePayloadSize / 2;
+    if (offset > halfSize || length > halfSize - offset || length < 2 * sizeof(uint32_t))
+        throw IPCException("invalid large payload %u %u", offset, length);
+    return getLargePayloadHalf(m_id ^ 1) + offset;
 }
 
 void IPCFutexPageQueue::unlock(size_t id)
@@ -228,3 +285,8 @@ void IPCFutexPageQueue::dumpPageInfo(std::string &info) {
     auto msg = new IPCException("tid:%d,readId:%zu,writeId:%zu,info:%s",m_tid,m_currentRead,m_currentWrite,builder.c_str());
     info.assign(msg->msg());
 }
+
+void IPCFutexPageQueue::dumpTraceInfo(std::string& info)
+{
+    m_tracer.dumpInfo(info);
+}
@@ -25,6 +25,8 @@
 #ifndef IPCFUTEXPAGEQUEUE_H
 #define IPCFUTEXPAGEQUEUE_H
 
+#include "IPCTracer.h"
+#include <deque>
 #include <stdint.h>
 #include <string>
 
@@ -38,6 +40,10 @@
 // data  whatever types indicate
 // A page queue is composed of m_pagesCount pages
 // and will use repeatedly.
+//
+// When mapped with ipc_mapping_size, the memory after the pages is a large
+// payload region. Each side writes packages which do not fit in one page into
+// its own half of it and only sends the offset and length through a page.
 class IPCFutexPageQueue {
 public:
     IPCFutexPageQueue(void* sharedMemory, size_t s, size_t id);
@@ -51,7 +57,20 @@ public:
     inline size_t getPageSize() const { return m_pageSize - sizeof(uint32_t) * 2; }
 
     static const size_t ipc_size = 2 * 1024 * 1024;
+    static const size_t large_payload_size = 16 * 1024 * 1024;
+    static const size_t ipc_mapping_size = ipc_size + large_payload_size;
+
+    // returns nullptr when there is no large payload region or it is full, the
+    // caller should fall back to sending page by page.
+    void* allocLargePayload(size_t length, uint32_t* offset);
+    // the peer's half is mapped read only.
+    const char* getPeerLargePayload(uint32_t offset, uint32_t length);
     void dumpPageInfo(std::string& info);
+    // tracing is disabled by default, see IPCTracer.
+    inline IPCTracer* tracer() { return &m_tracer; }
+    void dumpTraceInfo(std::string& info);
+    // seconds to wait for the peer to release a page before throwing.
+    inline void setTimeout(int seconds) { m_timeoutSec = seconds; }
 
 private:
     void unlock(size_t id);
@@ -60,15 +79,32 @@ private:
     inline size_t step(size_t s) { return (s + 2) & (m_pagesCount - 1); }
     void setFinishedTag();
     void clearFinishedTag();
+    void reclaimLargePayloads();
+    inline char* getLargePayloadHalf(size_t id) { return static_cast<char*>(m_sharedMemory) + ipc_size + id * (m_largePayloadSize / 2); }
+
+    struct LargePayload {
+        // m_writeSequence when the package referring to it was written.
+        uint64_t sequence;
+        size_t begin;
+    };
 
     size_t m_currentWrite;
     size_t m_currentRead;
+    size_t m_id;
+    // count of stepWrite, when it advances by m_pagesCount / 2 the page written
+    // at that time has been read and released by the peer.
+    uint64_t m_writeSequence;
+    size_t m_largePayloadSize;
+    size_t m_largePayloadHead;
+    std::deque<LargePayload> m_largePayloads;
     size_t m_pageSize;
     void* m_sharedMemory;
     int m_tid;
+    IPCTracer m_tracer;
+    int m_timeoutSec;
     static const uint32_t m_finishTag = static_cast<uint32_t>(1);
     static const size_t m_pagesCount = 16;
-    static const int m_timeoutSec = 32;
+    static const int m_defaultTimeoutSec = 32;
 };
 
 #endif /* IPCFUTEXPAGEQUEUE_H */
@@ -29,6 +29,7 @@
 #include "IPCException.h"
 #include "IPCHandler.h"
 #include "IPCResult.h"
+#include "IPCTracer.h"
 #include "IPCType.h"
 #include <unistd.h>
 
@@ -70,7 +71,17 @@ void IPCListenerImpl::listen()
         std::unique_ptr<IPCArguments> arguments = assembleArguments();
         releaseBlob();
         IPCArguments*  pArguments = arguments.get();
-        std::unique_ptr<IPCResult> sendBack = m_handler->handle(msg, pArguments);
+        IPCTracer* ipcTracer = tracer();
+        uint64_t handleStart = ipcTracer->isEnabled() ? IPCTracer::now() : 0;
+        if (handleStart && peerSendTime())
+            ipcTracer->record(msg, IPCTracer::QUEUE, peerSendTime(), handleStart, 0);
+        std::unique_ptr<IPCResult> sendBack;
+        {
+            IPCTracer::ScopedFlow flow(peerFlow());
+            sendBack = m_handler->handle(msg, pArguments);
+        }
+        if (handleStart)
+            ipcTracer->record(msg, IPCTracer::HANDLE, handleStart, IPCTracer::now(), packageLength());
         if (!isAsync) {
             std::unique_ptr<IPCBuffer> resultBuffer = generateResultBuffer(sendBack.get());
             doSendBufferOnly(resultBuffer.get());
@@ -25,6 +25,8 @@
 #ifndef IPCMESSAGEJS_H
 #define IPCMESSAGEJS_H
 
+#include <stdint.h>
+
 // Message from Platform to Script in ScriptBridge
 enum class IPCJSMsg {
     INITFRAMEWORK,
@@ -80,7 +82,73 @@ enum class IPCProxyMsg {
     HEARTBEAT,
     POSTLOGDETAIL,
     JSACTIONCALLBACK,
+    // several dom actions of one page packed by IPCBatchWriter.
+    CALLDOMBATCH,
 };
+
+// Names used by IPCTracer, keep them in the order of the enums above.
+inline const char* IPCJSMsgName(uint32_t msg) {
+    static const char* names[] = {
+        "INITFRAMEWORK",
+        "EXECJSSERVICE",
+        "TAKEHEAPSNAPSHOT",
+        "EXECJS",
+        "CREATEINSTANCE",
+        "DESTORYINSTANCE",
+        "EXECJSONINSTANCE",
+        "EXECJSWITHRESULT",
+        "EXECJSWITHCALLBACK",
+        "UPDATEGLOBALCONFIG",
+        "UpdateInitFrameworkParams",
+        "EXECTIMERCALLBACK",
+        "INITAPPFRAMEWORK",
+        "CREATEAPPCONTEXT",
+        "EXECJSONAPPWITHRESULT",
+        "CALLJSONAPPCONTEXT",
+        "DESTORYAPPCONTEXT",
+        "SETLOGLEVEL",
+        "JSACTION",
+    };
+    return msg < sizeof(names) / sizeof(names[0]) ? names[msg] : nullptr;
+}
+
+inline const char* IPCProxyMsgName(uint32_t msg) {
+    static const char* names[] = {
+        "SETJSFVERSION",
+        "REPORTEXCEPTION",
+        "CALLNATIVE",
+        "CALLNATIVEMODULE",
+        "CALLNATIVECOMPONENT",
+        "CALLADDELEMENT",
+        "SETTIMEOUT",
+        "NATIVELOG",
+        "CALLCREATEBODY",
+        "CALLUPDATEFINISH",
+        "CALLCREATEFINISH",
+        "CALLREFRESHFINISH",
+        "CALLUPDATEATTRS",
+        "CALLUPDATESTYLE",
+        "CALLREMOVEELEMENT",
+        "CALLMOVEELEMENT",
+        "CALLADDEVENT",
+        "CALLREMOVEEVENT",
+        "CALLGCANVASLINK",
+        "CALLT3DLINK",
+        "SETINTERVAL",
+        "CLEARINTERVAL",
+        "POSTMESSAGE",
+        "DISPATCHMESSAGE",
+        "DISPATCHMESSAGESYNC",
+        "ONRECEIVEDRESULT",
+        "UPDATECOMPONENTDATA",
+        "HEARTBEAT",
+        "POSTLOGDETAIL",
+        "JSACTIONCALLBACK",
+        "CALLDOMBATCH",
+    };
+    return msg < sizeof(names) / sizeof(names[0]) ? names[msg] : nullptr;
+}
+
 // Message from Script to Core in ScriptBridge
 
 enum class JSACTION {
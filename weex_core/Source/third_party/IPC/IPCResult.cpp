@@ -24,6 +24,7 @@
 
 #include "IPCResult.h"
 #include <cstdlib>
+#include <string.h>
 
 namespace {
 class VoidResult : public IPCResult {
@@ -0,0 +1,198 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef IPCSCHEMA_H
+#define IPCSCHEMA_H
+#include "IPCArguments.h"
+#include "IPCByteArray.h"
+#include "IPCHandler.h"
+#include "IPCMessageJS.h"
+#include "IPCResult.h"
+#include <memory>
+#include <stddef.h>
+#include <string.h>
+
+// Declarative argument lists of IPCProxyMsg. Every argument travels as an
+// IPCType::BYTEARRAY, the kind only decides what the sender passes in:
+// IPCCStr is a nul terminated string, IPCBytes a buffer with an explicit
+// length which may contain zeros (wson, json).
+struct IPCCStr {
+    typedef const char* Param;
+    static inline const char* data(Param param) { return param; }
+    static inline size_t length(Param param) { return param ? strlen(param) : 0; }
+};
+
+struct IPCBytesParam {
+    IPCBytesParam(const char* data, size_t length)
+        : data(data)
+        , length(length)
+    {
+    }
+    const char* data;
+    size_t length;
+};
+
+struct IPCBytes {
+    typedef IPCBytesParam Param;
+    static inline const char* data(Param param) { return param.data; }
+    static inline size_t length(Param param) { return param.data ? param.length : 0; }
+};
+
+template <IPCProxyMsg Msg, typename... Kinds>
+struct IPCSchema {
+    static constexpr IPCProxyMsg kMsg = Msg;
+    static constexpr size_t kArgCount = sizeof...(Kinds);
+
+    // Sink is anything with add(const char* data, size_t length), such as
+    // IPCSerializer. A wrong argument count or kind does not compile.
+    template <typename Sink>
+    static void encode(Sink& sink, typename Kinds::Param... params)
+    {
+        int unused[] = { 0, (sink.add(Kinds::data(params), Kinds::length(params)), 0)... };
+        (void)unused;
+    }
+};
+
+// Typed access to received arguments, pointing into the IPCArguments which
+// must outlive the view. Missing arguments or ones of another type read as
+// nullptr, like getArumentAsCStr.
+template <typename Schema>
+class IPCMessageView {
+public:
+    explicit IPCMessageView(IPCArguments* arguments)
+        : m_arguments(arguments)
+    {
+    }
+
+    template <size_t I>
+    const char* get() const
+    {
+        static_assert(I < Schema::kArgCount, "argument index is out of the schema");
+        const IPCByteArray* bytes = byteArray(I);
+        return bytes ? bytes->content : nullptr;
+    }
+
+    template <size_t I>
+    size_t length() const
+    {
+        static_assert(I < Schema::kArgCount, "argument index is out of the schema");
+        const IPCByteArray* bytes = byteArray(I);
+        return bytes ? bytes->length : 0;
+    }
+
+    const IPCByteArray* byteArray(size_t index) const
+    {
+        if (index >= m_arguments->getCount() || m_arguments->getType(index) != IPCType::BYTEARRAY)
+            return nullptr;
+        return m_arguments->getByteArray(index);
+    }
+
+private:
+    IPCArguments* m_arguments;
+};
+
+// Owned copy of all arguments in a single allocation, for handlers which pass
+// them to another thread. Each argument stays nul terminated.
+template <typename Schema>
+class IPCMessageCopy {
+public:
+    explicit IPCMessageCopy(const IPCMessageView<Schema>& view)
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < Schema::kArgCount; ++i) {
+            const IPCByteArray* bytes = view.byteArray(i);
+            m_lengths[i] = bytes ? bytes->length : 0;
+            m_offsets[i] = bytes ? static_cast<uint32_t>(total) : kAbsent;
+            if (bytes)
+                total += bytes->length + 1;
+        }
+        m_buffer.reset(new char[total ? total : 1]);
+        for (size_t i = 0; i < Schema::kArgCount; ++i) {
+            if (m_offsets[i] == kAbsent)
+                continue;
+            char* dst = m_buffer.get() + m_offsets[i];
+            memcpy(dst, view.byteArray(i)->content, m_lengths[i]);
+            dst[m_lengths[i]] = '\0';
+        }
+    }
+
+    template <size_t I>
+    const char* get() const
+    {
+        static_assert(I < Schema::kArgCount, "argument index is out of the schema");
+        return m_offsets[I] == kAbsent ? nullptr : m_buffer.get() + m_offsets[I];
+    }
+
+    template <size_t I>
+    size_t length() const
+    {
+        static_assert(I < Schema::kArgCount, "argument index is out of the schema");
+        return m_lengths[I];
+    }
+
+private:
+    static const uint32_t kAbsent = static_cast<uint32_t>(-1);
+    static const size_t kSlots = Schema::kArgCount ? Schema::kArgCount : 1;
+    std::unique_ptr<char[]> m_buffer;
+    uint32_t m_offsets[kSlots];
+    uint32_t m_lengths[kSlots];
+};
+
+// Registers a handler under the message of its schema.
+template <typename Schema>
+inline void registerIPCHandler(IPCHandler* handler, std::unique_ptr<IPCResult> (*function)(const IPCMessageView<Schema>&))
+{
+    handler->registerHandler(static_cast<int>(Schema::kMsg), [function](IPCArguments* arguments) {
+        return function(IPCMessageView<Schema>(arguments));
+    });
+}
+
+namespace IPCProxySchema {
+typedef IPCSchema<IPCProxyMsg::SETJSFVERSION, IPCCStr> SetJSFVersion;
+typedef IPCSchema<IPCProxyMsg::REPORTEXCEPTION, IPCCStr, IPCCStr, IPCCStr> ReportException;
+typedef IPCSchema<IPCProxyMsg::CALLNATIVE, IPCCStr, IPCCStr, IPCCStr> CallNative;
+typedef IPCSchema<IPCProxyMsg::CALLNATIVEMODULE, IPCCStr, IPCCStr, IPCCStr, IPCBytes, IPCBytes> CallNativeModule;
+typedef IPCSchema<IPCProxyMsg::CALLNATIVECOMPONENT, IPCCStr, IPCCStr, IPCCStr, IPCBytes, IPCBytes> CallNativeComponent;
+typedef IPCSchema<IPCProxyMsg::CALLADDELEMENT, IPCCStr, IPCCStr, IPCBytes, IPCCStr> CallAddElement;
+typedef IPCSchema<IPCProxyMsg::SETTIMEOUT, IPCCStr, IPCCStr> SetTimeout;
+typedef IPCSchema<IPCProxyMsg::NATIVELOG, IPCCStr> NativeLog;
+typedef IPCSchema<IPCProxyMsg::CALLCREATEBODY, IPCCStr, IPCBytes> CallCreateBody;
+typedef IPCSchema<IPCProxyMsg::CALLUPDATEFINISH, IPCCStr, IPCBytes, IPCBytes> CallUpdateFinish;
+typedef IPCSchema<IPCProxyMsg::CALLCREATEFINISH, IPCCStr> CallCreateFinish;
+typedef IPCSchema<IPCProxyMsg::CALLREFRESHFINISH, IPCCStr, IPCCStr, IPCCStr> CallRefreshFinish;
+typedef IPCSchema<IPCProxyMsg::CALLUPDATEATTRS, IPCCStr, IPCCStr, IPCBytes> CallUpdateAttrs;
+typedef IPCSchema<IPCProxyMsg::CALLUPDATESTYLE, IPCCStr, IPCCStr, IPCBytes> CallUpdateStyle;
+typedef IPCSchema<IPCProxyMsg::CALLREMOVEELEMENT, IPCCStr, IPCCStr> CallRemoveElement;
+typedef IPCSchema<IPCProxyMsg::CALLMOVEELEMENT, IPCCStr, IPCCStr, IPCCStr, IPCCStr> CallMoveElement;
+typedef IPCSchema<IPCProxyMsg::CALLADDEVENT, IPCCStr, IPCCStr, IPCCStr> CallAddEvent;
+typedef IPCSchema<IPCProxyMsg::CALLREMOVEEVENT, IPCCStr, IPCCStr, IPCCStr> CallRemoveEvent;
+typedef IPCSchema<IPCProxyMsg::CALLGCANVASLINK, IPCCStr, IPCCStr, IPCCStr> CallGCanvasLink;
+typedef IPCSchema<IPCProxyMsg::CALLT3DLINK, IPCCStr, IPCCStr> CallT3DLink;
+typedef IPCSchema<IPCProxyMsg::SETINTERVAL, IPCCStr, IPCCStr, IPCCStr> SetInterval;
+typedef IPCSchema<IPCProxyMsg::CLEARINTERVAL, IPCCStr, IPCCStr> ClearInterval;
+typedef IPCSchema<IPCProxyMsg::POSTMESSAGE, IPCBytes, IPCCStr> PostMessage;
+typedef IPCSchema<IPCProxyMsg::DISPATCHMESSAGE, IPCCStr, IPCBytes, IPCCStr, IPCCStr> DispatchMessage;
+typedef IPCSchema<IPCProxyMsg::DISPATCHMESSAGESYNC, IPCCStr, IPCBytes, IPCCStr> DispatchMessageSync;
+typedef IPCSchema<IPCProxyMsg::ONRECEIVEDRESULT, IPCCStr, IPCBytes> OnReceivedResult;
+typedef IPCSchema<IPCProxyMsg::UPDATECOMPONENTDATA, IPCCStr, IPCCStr, IPCCStr> UpdateComponentData;
+typedef IPCSchema<IPCProxyMsg::HEARTBEAT, IPCCStr> HeartBeat;
+typedef IPCSchema<IPCProxyMsg::POSTLOGDETAIL, IPCCStr, IPCCStr, IPCCStr, IPCCStr, IPCCStr> PostLogDetail;
+typedef IPCSchema<IPCProxyMsg::CALLDOMBATCH, IPCCStr, IPCBytes> CallDomBatch;
+}
+#endif /* IPCSCHEMA_H */
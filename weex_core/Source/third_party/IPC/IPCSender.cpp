@@ -32,6 +32,7 @@
 #include "IPCHandler.h"
 #include "IPCResult.h"
 #include "IPCString.h"
+#include "IPCTracer.h"
 #include "Serializing/IPCSerializer.h"
 #include <errno.h>
 #include <string.h>
@@ -62,7 +63,12 @@ IPCSenderImpl::~IPCSenderImpl()
 
 std::unique_ptr<IPCResult> IPCSenderImpl::send(IPCBuffer* buffer)
 {
+    IPCTracer* ipcTracer = tracer();
+    uint32_t sentMsg = *static_cast<const uint32_t*>(buffer->get());
+    uint64_t sendStart = ipcTracer->isEnabled() ? IPCTracer::now() : 0;
     doSendBufferOnly(buffer);
+    if (sendStart)
+        ipcTracer->record(sentMsg, IPCTracer::SEND, sendStart, IPCTracer::now(), buffer->length());
     if (checkBufferAsync(buffer))
         return createVoidResult();
     while (true) {
@@ -72,6 +78,8 @@ std::unique_ptr<IPCResult> IPCSenderImpl::send(IPCBuffer* buffer)
         if (msg == MSG_END) {
             std::unique_ptr<IPCResult> result = assembleResult();
             releaseBlob();
+            if (sendStart)
+                ipcTracer->record(sentMsg, IPCTracer::REPLY, sendStart, IPCTracer::now(), 0);
             return result;
         } else if (msg == MSG_TERMINATE) {
             releaseBlob();
@@ -79,7 +87,16 @@ std::unique_ptr<IPCResult> IPCSenderImpl::send(IPCBuffer* buffer)
         }
         std::unique_ptr<IPCArguments> arguments = assembleArguments();
         releaseBlob();
-        std::unique_ptr<IPCResult> sendBack = m_handler->handle(msg, arguments.get());
+        uint64_t handleStart = ipcTracer->isEnabled() ? IPCTracer::now() : 0;
+        if (handleStart && peerSendTime())
+            ipcTracer->record(msg, IPCTracer::QUEUE, peerSendTime(), handleStart, 0);
+        std::unique_ptr<IPCResult> sendBack;
+        {
+            IPCTracer::ScopedFlow flow(peerFlow());
+            sendBack = m_handler->handle(msg, arguments.get());
+        }
+        if (handleStart)
+            ipcTracer->record(msg, IPCTracer::HANDLE, handleStart, IPCTracer::now(), packageLength());
         if (!isAsync) {
             std::unique_ptr<IPCBuffer> resultBuffer = generateResultBuffer(sendBack.get());
             doSendBufferOnly(resultBuffer.get());
@@ -0,0 +1,250 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "IPCTracer.h"
+#include "IPCType.h"
+#include <algorithm>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+const char* kPhaseNames[IPCTracer::PHASE_COUNT] = { "send", "queue", "handle", "reply" };
+
+size_t bucketIndex(uint64_t us)
+{
+    if (us < 8)
+        return static_cast<size_t>(us);
+    int exponent = 63 - __builtin_clzll(us);
+    size_t index = static_cast<size_t>(exponent - 2) * 8 + ((us >> (exponent - 3)) & 7);
+    return index;
+}
+
+uint64_t bucketLowerBound(size_t index)
+{
+    if (index < 8)
+        return index;
+    size_t exponent = index / 8 + 2;
+    return static_cast<uint64_t>(8 + index % 8) << (exponent - 3);
+}
+}
+
+IPCTracer::IPCTracer(const char* name)
+    : m_name(name ? name : "")
+    , m_enabled(false)
+    , m_recordTraceEvents(false)
+    , m_sendResolver(nullptr)
+    , m_receiveResolver(nullptr)
+    , m_eventsHead(0)
+{
+}
+
+uint64_t IPCTracer::now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+}
+
+static std::atomic<IPCTracer::GetFlowFunc> s_getFlow(nullptr);
+static std::atomic<IPCTracer::SetFlowFunc> s_setFlow(nullptr);
+
+void IPCTracer::setFlowHooks(GetFlowFunc getFlow, SetFlowFunc setFlow)
+{
+    s_getFlow.store(getFlow, std::memory_order_relaxed);
+    s_setFlow.store(setFlow, std::memory_order_relaxed);
+}
+
+uint64_t IPCTracer::currentFlow()
+{
+    GetFlowFunc getFlow = s_getFlow.load(std::memory_order_relaxed);
+    return getFlow ? getFlow() : 0;
+}
+
+IPCTracer::ScopedFlow::ScopedFlow(uint64_t flow)
+    : m_previous(0)
+    , m_active(false)
+{
+    SetFlowFunc setFlow = s_setFlow.load(std::memory_order_relaxed);
+    if (!setFlow || !flow)
+        return;
+    m_previous = currentFlow();
+    m_active = true;
+    setFlow(flow);
+}
+
+IPCTracer::ScopedFlow::~ScopedFlow()
+{
+    if (m_active)
+        s_setFlow.load(std::memory_order_relaxed)(m_previous);
+}
+
+void IPCTracer::setEnabled(bool enabled, NameResolver sendResolver, NameResolver receiveResolver)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (sendResolver)
+        m_sendResolver = sendResolver;
+    if (receiveResolver)
+        m_receiveResolver = receiveResolver;
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void IPCTracer::setRecordTraceEvents(bool record)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_recordTraceEvents = record;
+    if (record)
+        m_events.reserve(kMaxTraceEvents);
+}
+
+void IPCTracer::record(uint32_t msg, Phase phase, uint64_t start, uint64_t end, size_t bytes)
+{
+    if (!isEnabled())
+        return;
+    msg &= MSG_MASK;
+    if (phase == QUEUE || phase == HANDLE)
+        msg |= kReceivedFlag;
+    uint64_t duration = end > start ? end - start : 0;
+    std::lock_guard<std::mutex> guard(m_mutex);
+    std::unique_ptr<MsgStats>& stats = m_stats[msg];
+    if (!stats) {
+        stats.reset(new MsgStats);
+        memset(stats.get(), 0, sizeof(MsgStats));
+    }
+    if (phase == SEND || phase == HANDLE) {
+        ++stats->count;
+        stats->bytes += bytes;
+    }
+    stats->phases[phase].add(duration / 1000);
+    if (!m_recordTraceEvents)
+        return;
+    TraceEvent event = { msg, phase, static_cast<int>(syscall(__NR_gettid)), start, duration };
+    if (m_events.size() < kMaxTraceEvents) {
+        m_events.push_back(event);
+    } else {
+        m_events[m_eventsHead] = event;
+        m_eventsHead = (m_eventsHead + 1) % kMaxTraceEvents;
+    }
+}
+
+void IPCTracer::reset()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_stats.clear();
+    m_events.clear();
+    m_eventsHead = 0;
+}
+
+void IPCTracer::Histogram::add(uint64_t us)
+{
+    ++count;
+    total += us;
+    if (us > max)
+        max = us;
+    size_t index = bucketIndex(us);
+    if (index >= kBucketCount)
+        index = kBucketCount - 1;
+    ++buckets[index];
+}
+
+uint64_t IPCTracer::Histogram::percentile(double p) const
+{
+    if (!count)
+        return 0;
+    uint64_t target = static_cast<uint64_t>(p * count);
+    if (target >= count)
+        target = count - 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        seen += buckets[i];
+        if (seen > target)
+            return std::min(bucketLowerBound(i + 1) - 1, max);
+    }
+    return max;
+}
+
+const char* IPCTracer::msgName(uint32_t key, char* buffer, size_t size)
+{
+    bool received = !!(key & kReceivedFlag);
+    uint32_t msg = key & MSG_MASK;
+    NameResolver resolver = received ? m_receiveResolver : m_sendResolver;
+    const char* name = resolver ? resolver(msg) : nullptr;
+    if (name)
+        snprintf(buffer, size, "%s%s", received ? "<-" : "->", name);
+    else
+        snprintf(buffer, size, "%smsg_%u", received ? "<-" : "->", msg);
+    return buffer;
+}
+
+void IPCTracer::dumpInfo(std::string& info)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    char line[256];
+    char name[64];
+    snprintf(line, sizeof(line), "[%s] enabled:%d\n", m_name.c_str(), isEnabled() ? 1 : 0);
+    info.assign(line);
+    for (auto& it : m_stats) {
+        const MsgStats& stats = *it.second;
+        snprintf(line, sizeof(line), "%s count:%" PRIu64 " bytes:%" PRIu64,
+            msgName(it.first, name, sizeof(name)), stats.count, stats.bytes);
+        info.append(line);
+        for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+            const Histogram& h = stats.phases[phase];
+            if (!h.count)
+                continue;
+            snprintf(line, sizeof(line), " %s(us)[n:%" PRIu64 " avg:%" PRIu64 " p50:%" PRIu64 " p99:%" PRIu64 " max:%" PRIu64 "]",
+                kPhaseNames[phase], h.count, h.total / h.count, h.percentile(0.5), h.percentile(0.99), h.max);
+            info.append(line);
+        }
+        info.append("\n");
+    }
+}
+
+void IPCTracer::dumpTraceEvents(std::string& json)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    char event[256];
+    char name[64];
+    int pid = getpid();
+    json.assign("{\"traceEvents\":[");
+    for (size_t i = 0; i < m_events.size(); ++i) {
+        const TraceEvent& e = m_events[(m_eventsHead + i) % m_events.size()];
+        snprintf(event, sizeof(event),
+            "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+            i ? "," : "", msgName(e.msg, name, sizeof(name)), kPhaseNames[e.phase], pid, e.tid,
+            e.start / 1000.0, e.duration / 1000.0);
+        json.append(event);
+    }
+    json.append("]}");
+}
+
+bool IPCTracer::writeTraceEvents(const char* path)
+{
+    std::string json;
+    dumpTraceEvents(json);
+    FILE* file = fopen(path, "w");
+    if (!file)
+        return false;
+    bool success = fwrite(json.data(), 1, json.size(), file) == json.size();
+    fclose(file);
+    return success;
+}
@@ -0,0 +1,123 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef IPCTRACER_H
+#define IPCTRACER_H
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Per message statistics of one IPCFutexPageQueue. Latencies are kept in
+// log-linear histograms (8 sub buckets per power of two, in microseconds), so
+// percentiles are within 12.5% of the real value whatever the range.
+class IPCTracer {
+public:
+    enum Phase {
+        // writing the package into the page queue, including the wait for free pages.
+        SEND,
+        // from the peer starting to send the package to this side reading it.
+        QUEUE,
+        // time spent in the IPCHandler.
+        HANDLE,
+        // whole round trip of a sync message as seen by the sender.
+        REPLY,
+        PHASE_COUNT,
+    };
+    typedef const char* (*NameResolver)(uint32_t msg);
+    typedef uint64_t (*GetFlowFunc)();
+    typedef void (*SetFlowFunc)(uint64_t);
+
+    // Makes a received package's flow id the thread's current one while it
+    // is handled.
+    class ScopedFlow {
+    public:
+        explicit ScopedFlow(uint64_t flow);
+        ~ScopedFlow();
+
+    private:
+        uint64_t m_previous;
+        bool m_active;
+    };
+
+    explicit IPCTracer(const char* name);
+    // CLOCK_MONOTONIC in nanoseconds, comparable between processes.
+    static uint64_t now();
+
+    // The embedder's trace flow id (weex::base::TraceLog) of the sending
+    // thread travels in the package trailer; IPC only passes it through.
+    static void setFlowHooks(GetFlowFunc getFlow, SetFlowFunc setFlow);
+    static uint64_t currentFlow();
+
+    inline bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    // messages sent and received on one queue come from different enums
+    // (e.g. IPCJSMsg and IPCProxyMsg), so they are named separately.
+    void setEnabled(bool enabled, NameResolver sendResolver = nullptr, NameResolver receiveResolver = nullptr);
+    void setRecordTraceEvents(bool record);
+
+    void record(uint32_t msg, Phase phase, uint64_t start, uint64_t end, size_t bytes);
+    void reset();
+
+    void dumpInfo(std::string& info);
+    // Chrome trace event format, can be loaded in chrome://tracing or Perfetto.
+    void dumpTraceEvents(std::string& json);
+    bool writeTraceEvents(const char* path);
+
+private:
+    static const size_t kBucketCount = 304;
+    static const size_t kMaxTraceEvents = 16384;
+
+    struct Histogram {
+        uint64_t count;
+        uint64_t total;
+        uint64_t max;
+        uint32_t buckets[kBucketCount];
+        void add(uint64_t us);
+        uint64_t percentile(double p) const;
+    };
+    struct MsgStats {
+        uint64_t count;
+        uint64_t bytes;
+        Histogram phases[PHASE_COUNT];
+    };
+    struct TraceEvent {
+        uint32_t msg;
+        Phase phase;
+        int tid;
+        uint64_t start;
+        uint64_t duration;
+    };
+
+    static const uint32_t kReceivedFlag = 1U << 31;
+    const char* msgName(uint32_t key, char* buffer, size_t size);
+
+    std::string m_name;
+    std::atomic<bool> m_enabled;
+    bool m_recordTraceEvents;
+    NameResolver m_sendResolver;
+    NameResolver m_receiveResolver;
+    std::mutex m_mutex;
+    std::unordered_map<uint32_t, std::unique_ptr<MsgStats>> m_stats;
+    std::vector<TraceEvent> m_events;
+    size_t m_eventsHead;
+};
+#endif /* IPCTRACER_H */
@@ -30,6 +30,7 @@
 #include "../IPCType.h"
 #include <sstream>
 #include <stdlib.h>
+#include <string.h>
 #include <string>
 #include <vector>
 
@@ -70,7 +70,7 @@
 
 struct timespec;
 
-static inline __always_inline int __futex(volatile void* ftx, int op, int value, const struct timespec* timeout)
+static inline __attribute__((__always_inline__)) int __futex(volatile void* ftx, int op, int value, const struct timespec* timeout)
 {
     // Our generated syscall assembler sets errno, but our callers (pthread functions) don't want to.
     int result = syscall(__NR_futex, ftx, op, value, timeout);
@@ -0,0 +1,510 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+// Stress and fault injection test of the futex page queue transport.
+//
+// Forks a child which plays the js process: the parent sends randomized
+// mixes of sync, async and nested messages from one byte to several pages
+// (and beyond the large payload region) over a memfd shared like the real
+// ipc mapping, the child checks every byte and the order of arrival. Then it
+// injects faults: a peer dying inside a handler while holding its page lock
+// (FUTEX_OWNER_DIED), a peer killed during a flood, and a stopped peer which
+// makes lock() time out. Every scenario must end in bounded time.
+//
+// A page lock whose owner died is always flagged FUTEX_OWNER_DIED by the
+// kernel when the lock is on the owner's robust list. Otherwise it depends on
+// whether the peer was already waiting for it, and lock() may fail with ESRCH
+// instead. The child dies both ways.
+//
+// Prints messages/sec, MB/s and p50/p99/max latency per message class so
+// transport changes can be compared. Exits non zero if a scenario fails.
+
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Buffering/IPCBuffer.h"
+#include "IPCArguments.h"
+#include "IPCByteArray.h"
+#include "IPCException.h"
+#include "IPCFutexPageQueue.h"
+#include "IPCHandler.h"
+#include "IPCListener.h"
+#include "IPCResult.h"
+#include "IPCSender.h"
+#include "IPCType.h"
+#include "Serializing/IPCSerializer.h"
+#include "base/log_defines.h"
+
+// The transport logs through base/log_defines.h, nothing is installed here so
+// only the symbols are needed.
+weex::base::LogImplement *weex::base::LogImplement::g_instance = nullptr;
+namespace WeexCore {
+void PrintLog(LogLevel level, const char *tag, const char *file,
+              unsigned long line, const char *format, ...) {}
+}  // namespace WeexCore
+
+namespace {
+
+enum StressMsg : uint32_t {
+  kData = 1,
+  // the child sends kEcho back before it replies.
+  kNested,
+  kEcho,
+  // the child exits inside the handler, holding its write page.
+  kDie,
+  // same, with the page lock on its robust list.
+  kDieRobust,
+};
+
+const int kChildDiedInHandler = 42;
+
+struct Options {
+  size_t messages = 2000;
+  uint32_t seed = 1;
+  double sync_ratio = 0.5;
+  double nested_ratio = 0.05;
+  size_t max_size = 12 * 1024 * 1024;
+  int timeout_sec = 2;
+  bool faults = true;
+  bool trace = false;
+};
+
+uint64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// Payloads are slices of this buffer, filled before fork so the child can
+// compare without any extra channel.
+std::vector<char> g_source;
+
+class LatencyStats {
+ public:
+  explicit LatencyStats(const char *name) : name_(name) {}
+  void Add(uint64_t ns) { samples_.push_back(ns); }
+  void Print() {
+    if (samples_.empty()) return;
+    std::sort(samples_.begin(), samples_.end());
+    printf("  %-14s %8zu %10.1f %10.1f %10.1f\n", name_, samples_.size(),
+           Percentile(0.5) / 1000.0, Percentile(0.99) / 1000.0,
+           samples_.back() / 1000.0);
+  }
+
+ private:
+  uint64_t Percentile(double p) {
+    size_t index = static_cast<size_t>(p * (samples_.size() - 1) + 0.5);
+    return samples_[index];
+  }
+  const char *name_;
+  std::vector<uint64_t> samples_;
+};
+
+// One queue mapping, mapped a second time for the child like the js process
+// maps the fd it receives.
+struct SharedQueue {
+  int fd = -1;
+  void *parent_mapping = nullptr;
+  void *child_mapping = nullptr;
+
+  bool Create() {
+    size_t size = IPCFutexPageQueue::ipc_mapping_size;
+    fd = static_cast<int>(syscall(SYS_memfd_create, "IPCStressTest", 0));
+    if (fd == -1 || ftruncate(fd, size) == -1) return false;
+    parent_mapping =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    child_mapping =
+        mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    return parent_mapping != MAP_FAILED && child_mapping != MAP_FAILED;
+  }
+};
+
+std::unique_ptr<IPCBuffer> BuildMessage(uint32_t msg, int32_t seq,
+                                        size_t offset, size_t size) {
+  std::unique_ptr<IPCSerializer> serializer = createIPCSerializer();
+  serializer->setMsg(msg);
+  serializer->add(seq);
+  serializer->add(static_cast<int32_t>(offset));
+  serializer->add(g_source.data() + offset, size);
+  return serializer->finish();
+}
+
+// Registers the page the child holds as a robust pi futex, so the kernel
+// marks it FUTEX_OWNER_DIED when the child exits.
+void DieAsRobustOwner(IPCFutexPageQueue *queue) {
+  static struct robust_list_head head;
+  static struct robust_list entry;
+  char *lock_word =
+      static_cast<char *>(queue->getCurrentWritePage()) - 2 * sizeof(uint32_t);
+  entry.next = &head.list;
+  // the low bit marks a pi futex.
+  head.list.next = reinterpret_cast<struct robust_list *>(
+      reinterpret_cast<uintptr_t>(&entry) | 1);
+  head.futex_offset = lock_word - reinterpret_cast<char *>(&entry);
+  head.list_op_pending = nullptr;
+  syscall(SYS_set_robust_list, &head, sizeof(head));
+  _exit(kChildDiedInHandler);
+}
+
+// Child side: listens until the parent terminates, exits with the number of
+// corrupted or reordered messages.
+void RunChild(void *mapping) {
+  IPCFutexPageQueue queue(mapping, IPCFutexPageQueue::ipc_mapping_size, 1);
+  std::unique_ptr<IPCHandler> handler = createIPCHandler();
+  std::unique_ptr<IPCSender> sender = createIPCSender(&queue, handler.get());
+  int32_t expected = 0;
+  int errors = 0;
+  auto check = [&](uint32_t msg, IPCArguments *arguments) {
+    int32_t seq = arguments->get<int32_t>(0);
+    size_t offset = static_cast<size_t>(arguments->get<int32_t>(1));
+    const IPCByteArray *bytes = arguments->getByteArray(2);
+    if (seq != expected) {
+      fprintf(stderr, "child: message %d arrived, expected %d\n", seq, expected);
+      ++errors;
+    }
+    expected = seq + 1;
+    if (offset + bytes->length > g_source.size() ||
+        memcmp(bytes->content, g_source.data() + offset, bytes->length)) {
+      fprintf(stderr, "child: message %d is corrupted\n", seq);
+      ++errors;
+    }
+    if (msg == kNested) {
+      std::unique_ptr<IPCBuffer> echo = BuildMessage(kEcho, seq, 0, 16);
+      std::unique_ptr<IPCResult> result = sender->send(echo.get());
+      if (result->getType() != IPCType::INT32 || result->get<int32_t>() != seq) {
+        fprintf(stderr, "child: bad echo reply for %d\n", seq);
+        ++errors;
+      }
+    }
+    return createInt32Result(static_cast<int32_t>(bytes->length));
+  };
+  handler->registerHandler(kData, [&](IPCArguments *arguments) {
+    return check(kData, arguments);
+  });
+  handler->registerHandler(kNested, [&](IPCArguments *arguments) {
+    return check(kNested, arguments);
+  });
+  handler->registerHandler(kDie, [](IPCArguments *) {
+    _exit(kChildDiedInHandler);
+    return createVoidResult();
+  });
+  handler->registerHandler(kDieRobust, [&queue](IPCArguments *) {
+    DieAsRobustOwner(&queue);
+    return createVoidResult();
+  });
+  std::unique_ptr<IPCListener> listener = createIPCListener(&queue, handler.get());
+  try {
+    listener->listen();
+  } catch (IPCException &e) {
+    if (strcmp(e.msg(), "peer terminates")) {
+      fprintf(stderr, "child: %s\n", e.msg());
+      ++errors;
+    }
+  }
+  _exit(std::min(errors, 40));
+}
+
+// Parent side of a scenario: owns the queue (id 0, created before the child
+// like the core process does) and the child.
+class Session {
+ public:
+  explicit Session(const Options &options) : options_(options) {}
+  ~Session() { Finish(); }
+
+  bool Start() {
+    if (!shared_.Create()) {
+      fprintf(stderr, "failed to create shared memory: %s\n", strerror(errno));
+      return false;
+    }
+    queue_.reset(new IPCFutexPageQueue(shared_.parent_mapping,
+                                       IPCFutexPageQueue::ipc_mapping_size, 0));
+    queue_->setTimeout(options_.timeout_sec);
+    if (options_.trace) queue_->tracer()->setEnabled(true);
+    child_ = fork();
+    if (child_ == 0) RunChild(shared_.child_mapping);
+    handler_ = createIPCHandler();
+    handler_->registerHandler(kEcho, [](IPCArguments *arguments) {
+      return createInt32Result(arguments->get<int32_t>(0));
+    });
+    sender_ = createIPCSender(queue_.get(), handler_.get());
+    queue_->spinWaitPeer();
+    return true;
+  }
+
+  IPCSender *sender() { return sender_.get(); }
+  IPCFutexPageQueue *queue() { return queue_.get(); }
+  pid_t child() const { return child_; }
+
+  // Terminates the child through the queue and returns its exit status.
+  int Finish() {
+    if (child_ <= 0) return status_;
+    if (options_.trace) {
+      std::string info;
+      queue_->dumpTraceInfo(info);
+      printf("%s\n", info.c_str());
+    }
+    sender_.reset();
+    queue_.reset();
+    waitpid(child_, &status_, 0);
+    child_ = 0;
+    close(shared_.fd);
+    return status_;
+  }
+
+ private:
+  const Options &options_;
+  SharedQueue shared_;
+  std::unique_ptr<IPCFutexPageQueue> queue_;
+  std::unique_ptr<IPCHandler> handler_;
+  std::unique_ptr<IPCSender> sender_;
+  pid_t child_ = 0;
+  int status_ = 0;
+};
+
+enum SizeClass { kPage, kRegion, kChunked, kSizeClassCount };
+
+SizeClass ClassOf(size_t size) {
+  size_t page = IPCFutexPageQueue::ipc_size / 16;
+  if (size < page - 64) return kPage;
+  if (size < IPCFutexPageQueue::large_payload_size / 2 - 64) return kRegion;
+  return kChunked;
+}
+
+bool RunMixed(const Options &options) {
+  Session session(options);
+  if (!session.Start()) return false;
+  std::mt19937 rng(options.seed);
+  std::uniform_real_distribution<double> unit(0, 1);
+  double log_max = log(static_cast<double>(options.max_size));
+  LatencyStats stats[2][kSizeClassCount] = {
+      {LatencyStats("async page"), LatencyStats("async region"),
+       LatencyStats("async chunked")},
+      {LatencyStats("sync page"), LatencyStats("sync region"),
+       LatencyStats("sync chunked")}};
+  LatencyStats nested("nested");
+  uint64_t bytes = 0;
+  bool ok = true;
+  uint64_t start = NowNs();
+  try {
+    for (size_t i = 0; i < options.messages; ++i) {
+      size_t size = static_cast<size_t>(exp(unit(rng) * log_max));
+      size = std::max<size_t>(1, std::min(size, options.max_size));
+      size_t offset = rng() % (options.max_size - size + 1);
+      double kind = unit(rng);
+      uint32_t msg = kData;
+      if (kind < options.nested_ratio)
+        msg = kNested;
+      else if (kind >= options.sync_ratio)
+        msg |= MSG_FLAG_ASYNC;
+      std::unique_ptr<IPCBuffer> buffer =
+          BuildMessage(msg, static_cast<int32_t>(i), offset, size);
+      uint64_t send_start = NowNs();
+      std::unique_ptr<IPCResult> result = session.sender()->send(buffer.get());
+      uint64_t elapsed = NowNs() - send_start;
+      bytes += size;
+      bool async = !!(msg & MSG_FLAG_ASYNC);
+      if (msg == kNested)
+        nested.Add(elapsed);
+      else
+        stats[async ? 0 : 1][ClassOf(size)].Add(elapsed);
+      if (!async && (result->getType() != IPCType::INT32 ||
+                     result->get<int32_t>() != static_cast<int32_t>(size))) {
+        fprintf(stderr, "bad reply for message %zu\n", i);
+        ok = false;
+      }
+    }
+  } catch (IPCException &e) {
+    fprintf(stderr, "mixed: %s\n", e.msg());
+    ok = false;
+  }
+  double seconds = (NowNs() - start) / 1e9;
+  int status = session.Finish();
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    fprintf(stderr, "mixed: child failed with status %x\n", status);
+    ok = false;
+  }
+  printf("mixed: %zu messages in %.3f s, %.0f msgs/s, %.1f MB/s\n",
+         options.messages, seconds, options.messages / seconds,
+         bytes / seconds / (1024 * 1024));
+  printf("  %-14s %8s %10s %10s %10s\n", "class", "count", "p50(us)",
+         "p99(us)", "max(us)");
+  for (auto &row : stats)
+    for (auto &stat : row) stat.Print();
+  nested.Print();
+  return ok;
+}
+
+// Sends async messages until the transport reports the fault, |inject| is
+// called once after |after| messages. Returns the time from the injection to
+// the exception in ms, or -1 if it never came.
+template <typename Inject>
+double FloodUntilFault(Session &session, size_t after, Inject inject,
+                       std::string &error) {
+  uint64_t injected = 0;
+  for (size_t i = 0; i < (1U << 20); ++i) {
+    if (i == after) {
+      inject();
+      injected = NowNs();
+    }
+    std::unique_ptr<IPCBuffer> buffer = BuildMessage(
+        kData | MSG_FLAG_ASYNC, static_cast<int32_t>(i), i % 4096, 4096);
+    try {
+      session.sender()->send(buffer.get());
+    } catch (IPCException &e) {
+      error = e.msg();
+      return injected ? (NowNs() - injected) / 1e6 : 0;
+    }
+  }
+  return -1;
+}
+
+bool Report(const char *scenario, double ms, const std::string &error,
+            double limit_ms) {
+  bool ok = ms >= 0 && ms <= limit_ms;
+  printf("%s: %s after %.1f ms (%s)\n", scenario, ok ? "detected" : "FAILED",
+         ms, error.c_str());
+  return ok;
+}
+
+// The child dies while the parent waits for the reply of a sync message.
+bool RunHandlerDeath(const Options &options, uint32_t msg,
+                     const char *scenario) {
+  Session session(options);
+  if (!session.Start()) return false;
+  std::string error;
+  double ms = -1;
+  uint64_t start = NowNs();
+  try {
+    std::unique_ptr<IPCBuffer> buffer = BuildMessage(msg, 0, 0, 16);
+    session.sender()->send(buffer.get());
+  } catch (IPCException &e) {
+    error = e.msg();
+    ms = (NowNs() - start) / 1e6;
+  }
+  int status = session.Finish();
+  bool ok = Report(scenario, ms, error, options.timeout_sec * 1000.0 + 500);
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != kChildDiedInHandler) {
+    fprintf(stderr, "%s: unexpected child status %x\n", scenario, status);
+    ok = false;
+  }
+  return ok;
+}
+
+bool RunPeerKilled(const Options &options) {
+  Session session(options);
+  if (!session.Start()) return false;
+  std::string error;
+  pid_t child = session.child();
+  double ms = FloodUntilFault(session, 64, [child] { kill(child, SIGKILL); },
+                              error);
+  session.Finish();
+  return Report("peer killed", ms, error, options.timeout_sec * 1000.0 + 500);
+}
+
+bool RunPeerStalled(const Options &options) {
+  Session session(options);
+  if (!session.Start()) return false;
+  std::string error;
+  pid_t child = session.child();
+  double ms = FloodUntilFault(session, 64, [child] { kill(child, SIGSTOP); },
+                              error);
+  // lock() has to wait the whole timeout for a live but stuck peer.
+  bool ok = Report("lock timeout", ms, error,
+                   options.timeout_sec * 1000.0 + 500);
+  if (ms >= 0 && ms < options.timeout_sec * 1000.0 - 100) {
+    fprintf(stderr, "lock timeout: gave up before the timeout\n");
+    ok = false;
+  }
+  kill(child, SIGKILL);
+  session.Finish();
+  return ok;
+}
+
+void Usage(const char *name) {
+  fprintf(stderr,
+          "usage: %s [--messages N] [--seed N] [--sync-ratio R] "
+          "[--nested-ratio R] [--max-size BYTES] [--timeout SEC] "
+          "[--no-faults] [--trace]\n",
+          name);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg(argv[i]);
+    const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (arg == "--no-faults") {
+      options.faults = false;
+    } else if (arg == "--trace") {
+      options.trace = true;
+    } else if (value == nullptr) {
+      Usage(argv[0]);
+      return 2;
+    } else if (arg == "--messages") {
+      options.messages = strtoul(value, nullptr, 10), ++i;
+    } else if (arg == "--seed") {
+      options.seed = static_cast<uint32_t>(strtoul(value, nullptr, 10)), ++i;
+    } else if (arg == "--sync-ratio") {
+      options.sync_ratio = atof(value), ++i;
+    } else if (arg == "--nested-ratio") {
+      options.nested_ratio = atof(value), ++i;
+    } else if (arg == "--max-size") {
+      options.max_size = std::max<size_t>(4096, strtoul(value, nullptr, 10)), ++i;
+    } else if (arg == "--timeout") {
+      options.timeout_sec = std::max(1, atoi(value)), ++i;
+    } else {
+      Usage(argv[0]);
+      return 2;
+    }
+  }
+  // a hang is a failure too.
+  alarm(600);
+
+  std::mt19937 rng(options.seed);
+  g_source.resize(options.max_size);
+  for (auto &c : g_source) c = static_cast<char>(rng());
+
+  printf("seed %u, %zu messages, max size %zu, sync ratio %.2f\n",
+         options.seed, options.messages, options.max_size, options.sync_ratio);
+  bool ok = RunMixed(options);
+  if (options.faults) {
+    ok = RunHandlerDeath(options, kDie, "owner gone") && ok;
+    ok = RunHandlerDeath(options, kDieRobust, "owner died") && ok;
+    ok = RunPeerKilled(options) && ok;
+    ok = RunPeerStalled(options) && ok;
+  }
+  printf("%s\n", ok ? "PASSED" : "FAILED");
+  return ok ? 0 : 1;
+}
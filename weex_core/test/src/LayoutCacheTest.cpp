@@ -0,0 +1,200 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+// LayoutCache entries: a stored layout restores into an equal tree, also from
+// a cache opened again on the same directory, Validate flags only the nodes
+// that differ, and the cache stays within its entry and byte bounds.
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string>
+
+#include "core/config/core_environment.h"
+#include "core/render/node/factory/render_creator.h"
+#include "core/render/node/render_object.h"
+#include "core/render/page/layout_cache.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using WeexCore::LayoutCache;
+using WeexCore::RenderCreator;
+using WeexCore::RenderObject;
+
+const std::pair<float, float> kPageSize(750, NAN);
+
+RenderObject* NewRender(const std::string& ref) {
+  return static_cast<RenderObject*>(
+      RenderCreator::GetInstance()->CreateRender("div", ref));
+}
+
+// A 750 wide root holding |count| rows of the given height.
+RenderObject* BuildTree(int count, const std::string& row_height) {
+  RenderObject* root = NewRender("root");
+  root->AddStyle("width", "750", false);
+  for (int i = 0; i < count; i++) {
+    RenderObject* row = NewRender(std::to_string(i));
+    row->AddStyle("height", row_height, false);
+    root->AddRenderObject(i, row);
+  }
+  return root;
+}
+
+uint64_t KeyOf(RenderObject* root) {
+  return LayoutCache::HashTree(root, kPageSize, 750, 750);
+}
+
+class LayoutCacheTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    WeexCore::WXCoreEnvironment::getInstance()->SetDeviceWidth("750");
+    char path[] = "/tmp/layout_cache_test_XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(path));
+    directory_ = path;
+  }
+
+  void TearDown() override {
+    if (DIR* dir = opendir(directory_.c_str())) {
+      while (struct dirent* item = readdir(dir)) {
+        unlink((directory_ + "/" + item->d_name).c_str());
+      }
+      closedir(dir);
+    }
+    rmdir(directory_.c_str());
+  }
+
+  // Lays out a tree of |count| rows and stores it. Returns its key.
+  uint64_t StoreTree(LayoutCache* cache, int count) {
+    RenderObject* root = BuildTree(count, "100");
+    root->calculateLayout(kPageSize);
+    uint64_t key = KeyOf(root);
+    EXPECT_TRUE(cache->Store(key, root));
+    delete root;
+    return key;
+  }
+
+  bool RestoreTree(LayoutCache* cache, int count) {
+    RenderObject* root = BuildTree(count, "100");
+    bool restored = cache->Restore(KeyOf(root), root);
+    delete root;
+    return restored;
+  }
+
+  std::string directory_;
+};
+
+TEST_F(LayoutCacheTest, RoundTrip) {
+  LayoutCache cache(directory_);
+  RenderObject* stored = BuildTree(3, "100");
+  stored->calculateLayout(kPageSize);
+  uint64_t key = KeyOf(stored);
+  ASSERT_NE(0u, key);
+  ASSERT_TRUE(cache.Store(key, stored));
+
+  // An equal tree gets the same key and every stored result.
+  RenderObject* restored = BuildTree(3, "100");
+  ASSERT_EQ(key, KeyOf(restored));
+  ASSERT_TRUE(cache.Restore(key, restored));
+  for (int i = 0; i < 3; i++) {
+    RenderObject* row = restored->GetChild(i);
+    EXPECT_FLOAT_EQ(750, row->getLayoutWidth());
+    EXPECT_FLOAT_EQ(100, row->getLayoutHeight());
+    EXPECT_FLOAT_EQ(100 * i, row->getLayoutPositionTop());
+  }
+  EXPECT_FLOAT_EQ(300, restored->getLayoutHeight());
+
+  // A fresh layout of the same tree matches the entry node for node.
+  restored->calculateLayout(kPageSize);
+  EXPECT_EQ(0u, cache.Validate(key, restored));
+  EXPECT_FALSE(restored->hasNewLayout());
+
+  // A tree with taller rows keys differently and, checked against the old
+  // entry, differs in the root and every row.
+  RenderObject* taller = BuildTree(3, "200");
+  EXPECT_NE(key, KeyOf(taller));
+  taller->calculateLayout(kPageSize);
+  EXPECT_EQ(4u, cache.Validate(key, taller));
+  EXPECT_FALSE(cache.Restore(KeyOf(taller), taller));
+
+  // An entry only restores into a tree of its size.
+  RenderObject* smaller = BuildTree(2, "100");
+  EXPECT_FALSE(cache.Restore(key, smaller));
+  EXPECT_EQ(3u, cache.Validate(key, smaller));
+
+  EXPECT_TRUE(cache.Remove(key));
+  EXPECT_FALSE(cache.Restore(key, restored));
+  EXPECT_EQ(0u, cache.entry_count());
+
+  delete stored;
+  delete restored;
+  delete taller;
+  delete smaller;
+}
+
+TEST_F(LayoutCacheTest, EntriesOutliveTheCache) {
+  uint64_t key;
+  {
+    LayoutCache cache(directory_);
+    key = StoreTree(&cache, 2);
+  }
+  // A crash between writing and renaming leaves a temporary file behind.
+  std::string temp_path = directory_ + "/0000000000000001.layout.tmp";
+  FILE* temp = fopen(temp_path.c_str(), "wb");
+  ASSERT_NE(nullptr, temp);
+  fclose(temp);
+
+  LayoutCache cache(directory_);
+  EXPECT_EQ(1u, cache.entry_count());
+  EXPECT_NE(0, access(temp_path.c_str(), F_OK));
+  RenderObject* root = BuildTree(2, "100");
+  EXPECT_TRUE(cache.Restore(key, root));
+  EXPECT_FLOAT_EQ(200, root->getLayoutHeight());
+  delete root;
+}
+
+TEST_F(LayoutCacheTest, EvictsLeastRecentlyUsed) {
+  LayoutCache cache(directory_, 2, LayoutCache::kMaxTotalBytes);
+  StoreTree(&cache, 1);
+  StoreTree(&cache, 2);
+  // Using the first entry makes the second the one to go next.
+  EXPECT_TRUE(RestoreTree(&cache, 1));
+  StoreTree(&cache, 3);
+  EXPECT_EQ(2u, cache.entry_count());
+  EXPECT_TRUE(RestoreTree(&cache, 1));
+  EXPECT_FALSE(RestoreTree(&cache, 2));
+  EXPECT_TRUE(RestoreTree(&cache, 3));
+}
+
+TEST_F(LayoutCacheTest, EvictsBeyondByteBound) {
+  // An entry is a small header and a record per node. This leaves room for
+  // the entries of 2 and 3 nodes, or for the one of 9 nodes alone.
+  LayoutCache cache(directory_, LayoutCache::kMaxEntryCount,
+                    9 * sizeof(WeexCore::WXCorelayoutResult) + 64);
+  StoreTree(&cache, 1);
+  StoreTree(&cache, 2);
+  EXPECT_EQ(2u, cache.entry_count());
+  StoreTree(&cache, 8);
+  EXPECT_EQ(1u, cache.entry_count());
+  EXPECT_FALSE(RestoreTree(&cache, 1));
+  EXPECT_FALSE(RestoreTree(&cache, 2));
+  EXPECT_TRUE(RestoreTree(&cache, 8));
+}
+
+}  // namespace
@@ -0,0 +1,173 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+// Contention benchmark of the task queue handoff: 1 to 8 producer threads
+// feed one consumer through either a mutex/condition guarded deque, which is
+// what WeexTaskQueue and BackToWeexCoreQueue used, or the intrusive MpscQueue
+// with an EventCount. The consumer checks that every element arrives once and
+// in order per producer. Prints items/sec per configuration and exits non
+// zero on a lost, duplicated or reordered element.
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#include "base/thread/event_count.h"
+#include "base/thread/mpsc_queue.h"
+
+namespace {
+
+struct Item : public weex::base::MpscNode {
+  int producer = 0;
+  int sequence = 0;
+};
+
+class LockedQueue {
+ public:
+  LockedQueue() {
+    pthread_mutex_init(&mutex_, nullptr);
+    pthread_cond_init(&condition_, nullptr);
+  }
+  ~LockedQueue() {
+    pthread_mutex_destroy(&mutex_);
+    pthread_cond_destroy(&condition_);
+  }
+
+  void Push(Item* item) {
+    pthread_mutex_lock(&mutex_);
+    queue_.push_back(item);
+    pthread_mutex_unlock(&mutex_);
+    pthread_cond_signal(&condition_);
+  }
+
+  Item* Take() {
+    pthread_mutex_lock(&mutex_);
+    while (queue_.empty()) pthread_cond_wait(&condition_, &mutex_);
+    Item* item = queue_.front();
+    queue_.pop_front();
+    pthread_mutex_unlock(&mutex_);
+    return item;
+  }
+
+ private:
+  pthread_mutex_t mutex_;
+  pthread_cond_t condition_;
+  std::deque<Item*> queue_;
+};
+
+class LockFreeQueue {
+ public:
+  void Push(Item* item) {
+    pending_.fetch_add(1);
+    queue_.Push(item);
+    event_.Notify();
+  }
+
+  Item* Take() {
+    while (true) {
+      Item* item = queue_.Pop();
+      if (item != nullptr) {
+        pending_.fetch_sub(1);
+        return item;
+      }
+      auto key = event_.PrepareWait();
+      if (pending_.load() != 0) {
+        event_.CancelWait();
+        sched_yield();
+        continue;
+      }
+      event_.Wait(key);
+    }
+  }
+
+ private:
+  weex::base::MpscQueue<Item> queue_;
+  std::atomic<int> pending_{0};
+  weex::base::EventCount event_;
+};
+
+// Returns items/sec, or a negative value if the consumer saw a bad sequence.
+template <typename Queue>
+double Run(int producers, int per_producer, bool bursty) {
+  Queue queue;
+  std::vector<Item> items(static_cast<size_t>(producers) * per_producer);
+  std::vector<int> next(producers, 0);
+  bool ok = true;
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p] {
+      for (int i = 0; i < per_producer; ++i) {
+        Item* item = &items[static_cast<size_t>(p) * per_producer + i];
+        item->producer = p;
+        item->sequence = i;
+        queue.Push(item);
+        // Let the consumer drain and park now and then, which is how the
+        // bridge threads actually behave.
+        if (bursty && (i & 63) == 63) std::this_thread::yield();
+      }
+    });
+  }
+  long total = static_cast<long>(producers) * per_producer;
+  for (long n = 0; n < total; ++n) {
+    Item* item = queue.Take();
+    if (item->sequence != next[item->producer]++) ok = false;
+  }
+  for (auto& thread : threads) thread.join();
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  return ok ? total / seconds : -1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int per_producer = 200000;
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (strcmp(argv[i], "--items") == 0) per_producer = atoi(argv[++i]);
+  }
+
+  int failures = 0;
+  printf("%-10s %-7s %16s %16s %8s\n", "producers", "mode", "mutex items/s",
+         "mpsc items/s", "speedup");
+  for (int producers : {1, 2, 4, 8}) {
+    for (bool bursty : {false, true}) {
+      double locked = Run<LockedQueue>(producers, per_producer, bursty);
+      double lock_free = Run<LockFreeQueue>(producers, per_producer, bursty);
+      if (locked < 0 || lock_free < 0) {
+        printf("producers %d: bad sequence (mutex %s, mpsc %s)\n", producers,
+               locked < 0 ? "failed" : "ok", lock_free < 0 ? "failed" : "ok");
+        ++failures;
+        continue;
+      }
+      printf("%-10d %-7s %16.0f %16.0f %7.2fx\n", producers,
+             bursty ? "bursty" : "flood", locked, lock_free,
+             lock_free / locked);
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+// Recycle-list templates and their copies: a copy keeps the values it was
+// copied from when the template is removed from the page or changed, and
+// RenderList::LayoutCell never hands a copy a layout cached for other values.
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/config/core_environment.h"
+#include "core/render/manager/render_manager.h"
+#include "core/render/node/factory/render_creator.h"
+#include "core/render/node/factory/render_type.h"
+#include "core/render/node/render_list.h"
+#include "core/render/node/render_object.h"
+#include "core/render/page/render_page.h"
+#include "gtest/gtest.h"
+#include "support/test_platform_side.h"
+
+namespace {
+
+using WeexCore::RenderCreator;
+using WeexCore::RenderList;
+using WeexCore::RenderManager;
+using WeexCore::RenderObject;
+using WeexCore::TestPlatformSide;
+
+typedef std::vector<std::pair<std::string, std::string>> Pairs;
+
+const char kPage[] = "recycle";
+
+RenderObject* NewRender(const std::string& type, const std::string& ref) {
+  return static_cast<RenderObject*>(
+      RenderCreator::GetInstance()->CreateRender(type, ref));
+}
+
+class RecycleListTemplateTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    WeexCore::WXCoreEnvironment::getInstance()->SetDeviceWidth("750");
+    platform_ = TestPlatformSide::Install();
+    RenderManager* manager = RenderManager::GetInstance();
+
+    RenderObject* root = NewRender("div", "_root");
+    list_ = static_cast<RenderList*>(
+        NewRender(WeexCore::kRenderRecycleList, "list"));
+    root->AddRenderObject(0, list_);
+    ASSERT_TRUE(manager->CreatePage(kPage, root));
+
+    // Added through the page, so the template is registered like one the
+    // script created.
+    RenderObject* slot = NewRender(WeexCore::kRenderCellSlot, "slot");
+    slot->AddStyle("alignItems", "flex-start", false);
+    RenderObject* text = NewRender("text", "text");
+    text->AddAttr("value", "ab");
+    text->AddStyle("color", "red", false);
+    slot->AddRenderObject(0, text);
+    ASSERT_TRUE(manager->AddRenderObject(kPage, "list", 0, slot));
+    ASSERT_EQ(1u, list_->CellSlots().size());
+  }
+
+  void TearDown() override { RenderManager::GetInstance()->ClosePage(kPage); }
+
+  RenderObject* Template(const std::string& ref) {
+    return static_cast<WeexCore::RenderPage*>(
+               RenderManager::GetInstance()->GetPage(kPage))
+        ->GetRenderObject(ref);
+  }
+
+  // Copies a cell the way the platform does, node by node. The list owns
+  // the copy.
+  RenderObject* CopyCell(RenderObject* slot, RenderObject* text) {
+    RenderObject* slot_copy = NewRender(slot->type(), slot->ref());
+    slot_copy->CopyFrom(slot);
+    list_->AddCellSlotCopyTrack(slot_copy);
+    RenderObject* text_copy = NewRender(text->type(), text->ref());
+    text_copy->CopyFrom(text);
+    text_copy->BindMeasureFunc();
+    slot_copy->AddRenderObject(0, text_copy);
+    return slot_copy;
+  }
+
+  float LayoutCell(RenderObject* slot_copy) {
+    list_->LayoutCell(slot_copy, std::make_pair(750.f, NAN));
+    return slot_copy->GetChild(0)->getLayoutWidth();
+  }
+
+  TestPlatformSide* platform_;
+  RenderList* list_;
+};
+
+TEST_F(RecycleListTemplateTest, CopiesOutliveRemovedTemplate) {
+  RenderObject* copy = CopyCell(Template("slot"), Template("text"));
+  RenderObject* text_copy = copy->GetChild(0);
+
+  ASSERT_TRUE(RenderManager::GetInstance()->RemoveRenderObject(kPage, "text"));
+  EXPECT_EQ(nullptr, Template("text"));
+  EXPECT_EQ("ab", text_copy->GetAttr("value"));
+  EXPECT_EQ("red", text_copy->GetStyle("color"));
+  EXPECT_FLOAT_EQ(20, LayoutCell(copy));
+}
+
+TEST_F(RecycleListTemplateTest, TemplateChangesReachOnlyNewCopies) {
+  RenderObject* before = CopyCell(Template("slot"), Template("text"));
+  EXPECT_FLOAT_EQ(20, LayoutCell(before));
+  int measures = platform_->measure_count;
+
+  // Another copy of the same template reuses the cached layout.
+  RenderObject* same = CopyCell(Template("slot"), Template("text"));
+  EXPECT_FLOAT_EQ(20, LayoutCell(same));
+  EXPECT_EQ(measures, platform_->measure_count);
+
+  Pairs attrs = {{"value", "abcd"}};
+  Pairs styles = {{"color", "blue"}};
+  RenderManager::GetInstance()->UpdateAttr(kPage, "text", &attrs);
+  RenderManager::GetInstance()->UpdateStyle(kPage, "text", &styles);
+  EXPECT_EQ("ab", before->GetChild(0)->GetAttr("value"));
+  EXPECT_EQ("red", before->GetChild(0)->GetStyle("color"));
+
+  RenderObject* after = CopyCell(Template("slot"), Template("text"));
+  EXPECT_EQ("abcd", after->GetChild(0)->GetAttr("value"));
+  EXPECT_EQ("blue", after->GetChild(0)->GetStyle("color"));
+  EXPECT_FLOAT_EQ(40, LayoutCell(after));
+  EXPECT_LT(measures, platform_->measure_count);
+
+  // A copy of a copy keeps the copy's template values and overrides.
+  before->GetChild(0)->UpdateAttr("value", "a");
+  RenderObject* nested = CopyCell(before, before->GetChild(0));
+  EXPECT_EQ("a", nested->GetChild(0)->GetAttr("value"));
+  EXPECT_EQ("red", nested->GetChild(0)->GetStyle("color"));
+  EXPECT_FLOAT_EQ(10, LayoutCell(nested));
+}
+
+}  // namespace
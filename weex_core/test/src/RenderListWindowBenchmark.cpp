@@ -0,0 +1,156 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+// Layout benchmark of windowed lists: builds a long column list whose cells
+// hold a few children each, and times the first layout pass and a relayout
+// after a scroll, once with every cell laid out and once with layoutWindow
+// set. Prints both and exits non zero if the windowed list disagrees with
+// the full one on where the scrolled-to cell is or on the content length.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/config/core_environment.h"
+#include "core/render/manager/render_manager.h"
+#include "core/render/node/factory/render_creator.h"
+#include "core/render/node/render_list.h"
+#include "core/render/node/render_object.h"
+#include "core/render/page/render_page.h"
+#include "support/test_platform_side.h"
+
+namespace {
+
+using WeexCore::RenderCreator;
+using WeexCore::RenderList;
+using WeexCore::RenderManager;
+using WeexCore::RenderObject;
+using WeexCore::RenderPage;
+
+const int kChildrenPerCell = 6;
+const int kChildHeight = 20;
+const int kListHeight = 1000;
+
+RenderObject* NewRender(const char* type, const std::string& ref) {
+  return static_cast<RenderObject*>(
+      RenderCreator::GetInstance()->CreateRender(type, ref));
+}
+
+struct Result {
+  double first_pass;
+  double relayout;
+  float scrolled_top;
+  float content_length;
+};
+
+double Since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+Result Run(const std::string& page_id, int cells, bool windowed) {
+  RenderObject* root = NewRender("div", "_root");
+  root->AddStyle("width", "750", false);
+  root->AddStyle("height", std::to_string(kListHeight), false);
+  RenderObject* list = NewRender("list", "list");
+  list->AddStyle("width", "750", false);
+  list->AddStyle("height", std::to_string(kListHeight), false);
+  root->AddRenderObject(0, list);
+  for (int i = 0; i < cells; ++i) {
+    std::string ref = std::to_string(i);
+    RenderObject* cell = NewRender("cell", ref);
+    for (int j = 0; j < kChildrenPerCell; ++j) {
+      RenderObject* child = NewRender("div", ref + "-" + std::to_string(j));
+      child->AddStyle("height", std::to_string(kChildHeight), false);
+      child->AddStyle("marginLeft", "10", false);
+      cell->AddRenderObject(j, child);
+    }
+    list->AddRenderObject(i, cell);
+  }
+
+  RenderManager* manager = RenderManager::GetInstance();
+  manager->CreatePage(page_id, root);
+  RenderPage* page = static_cast<RenderPage*>(manager->GetPage(page_id));
+  RenderList* scroller = static_cast<RenderList*>(page->GetRenderObject("list"));
+  if (windowed) {
+    std::vector<std::pair<std::string, std::string>> attrs = {
+        {"layoutWindow", "true"},
+        {"estimatedCellSize",
+         std::to_string(kChildrenPerCell * kChildHeight)}};
+    manager->UpdateAttr(page_id, "list", &attrs);
+  }
+
+  Result result;
+  auto start = std::chrono::steady_clock::now();
+  manager->CreateFinish(page_id);
+  result.first_pass = Since(start);
+
+  // Half way down, and the list relaid out as an update inside it would.
+  int target = cells / 2;
+  float offset = static_cast<float>(target * kChildrenPerCell * kChildHeight);
+  start = std::chrono::steady_clock::now();
+  scroller->SetScrollOffset(offset);
+  scroller->markDirty();
+  page->set_is_dirty(true);
+  page->LayoutImmediately();
+  result.relayout = Since(start);
+
+  RenderObject* last = page->GetRenderObject(std::to_string(cells - 1));
+  result.scrolled_top =
+      page->GetRenderObject(std::to_string(target))->getLayoutPositionTop();
+  result.content_length = last->getLayoutPositionTop() + last->getLayoutHeight();
+  manager->ClosePage(page_id);
+  return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int cells = 5000;
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (strcmp(argv[i], "--cells") == 0) cells = atoi(argv[++i]);
+  }
+
+  WeexCore::WXCoreEnvironment::getInstance()->SetDeviceWidth("750");
+  WeexCore::WXCoreEnvironment::getInstance()->SetDeviceHeight(
+      std::to_string(kListHeight));
+  WeexCore::TestPlatformSide::Install();
+
+  Result full = Run("full", cells, false);
+  Result windowed = Run("windowed", cells, true);
+
+  printf("%-26s %14s %14s %14s\n", "", "full", "windowed", "ratio");
+  printf("%-26s %14.2f %14.2f %13.2fx\n", "first pass ms",
+         full.first_pass * 1e3, windowed.first_pass * 1e3,
+         full.first_pass / windowed.first_pass);
+  printf("%-26s %14.2f %14.2f %13.2fx\n", "relayout after scroll ms",
+         full.relayout * 1e3, windowed.relayout * 1e3,
+         full.relayout / windowed.relayout);
+  printf("%-26s %14.0f %14.0f\n", "content length",
+         full.content_length, windowed.content_length);
+
+  bool agree = full.scrolled_top == windowed.scrolled_top &&
+               full.content_length == windowed.content_length;
+  if (!agree) printf("windowed layout differs from the full one\n");
+  return agree ? 0 : 1;
+}
@@ -0,0 +1,199 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+// Windowed lists: with layoutWindow set, a list lays out only the cells near
+// its scroll offset. Cells outside the window keep their last size, or an
+// estimate if they were never measured, and scrolling past half the overscan
+// brings the newly visible ones in.
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/config/core_environment.h"
+#include "core/render/manager/render_manager.h"
+#include "core/render/node/factory/render_creator.h"
+#include "core/render/node/render_list.h"
+#include "core/render/node/render_object.h"
+#include "core/render/page/render_page.h"
+#include "gtest/gtest.h"
+#include "support/test_platform_side.h"
+
+namespace {
+
+using WeexCore::RenderCreator;
+using WeexCore::RenderList;
+using WeexCore::RenderManager;
+using WeexCore::RenderObject;
+using WeexCore::RenderPage;
+using WeexCore::TestPlatformSide;
+
+typedef std::vector<std::pair<std::string, std::string>> Pairs;
+
+const int kCellCount = 100;
+const float kCellHeight = 100;
+const float kListHeight = 1000;
+
+RenderObject* NewRender(const std::string& type, const std::string& ref) {
+  return static_cast<RenderObject*>(
+      RenderCreator::GetInstance()->CreateRender(type, ref));
+}
+
+std::string CellRef(int i) { return "cell" + std::to_string(i); }
+
+class RenderListWindowTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    WeexCore::WXCoreEnvironment::getInstance()->SetDeviceWidth("750");
+    // The first pass takes the viewport from the device, the list has no
+    // size yet.
+    WeexCore::WXCoreEnvironment::getInstance()->SetDeviceHeight(
+        std::to_string(kListHeight));
+    TestPlatformSide::Install();
+
+    RenderObject* root = NewRender("div", "_root");
+    root->AddStyle("width", "750", false);
+    root->AddStyle("height", std::to_string(kListHeight), false);
+    RenderObject* list = NewRender("list", "list");
+    list->AddStyle("width", "750", false);
+    list->AddStyle("height", std::to_string(kListHeight), false);
+    root->AddRenderObject(0, list);
+    // Every cell is kCellHeight tall through its only child.
+    for (int i = 0; i < kCellCount; ++i) {
+      RenderObject* cell = NewRender("cell", CellRef(i));
+      RenderObject* content = NewRender("div", CellRef(i) + "-content");
+      content->AddStyle("height", std::to_string(kCellHeight), false);
+      cell->AddRenderObject(0, content);
+      list->AddRenderObject(i, cell);
+    }
+    ASSERT_TRUE(RenderManager::GetInstance()->CreatePage("window", root));
+    page_ = static_cast<RenderPage*>(RenderManager::GetInstance()->GetPage("window"));
+    list_ = static_cast<RenderList*>(page_->GetRenderObject("list"));
+  }
+
+  void TearDown() override { RenderManager::GetInstance()->ClosePage("window"); }
+
+  void SetWindow(const std::string& overscan, const std::string& estimate) {
+    Pairs attrs = {{"layoutWindow", "true"},
+                   {"layoutOverscan", overscan},
+                   {"estimatedCellSize", estimate}};
+    RenderManager::GetInstance()->UpdateAttr("window", "list", &attrs);
+  }
+
+  RenderObject* Cell(int i) { return page_->GetRenderObject(CellRef(i)); }
+
+  RenderObject* Content(int i) {
+    return page_->GetRenderObject(CellRef(i) + "-content");
+  }
+
+  float ContentLength() {
+    RenderObject* last = Cell(kCellCount - 1);
+    return last->getLayoutPositionTop() + last->getLayoutHeight();
+  }
+
+  // The cells laid out by the last pass, which must be contiguous.
+  std::pair<int, int> LaidOutCells() {
+    int first = -1;
+    int last = -1;
+    for (int i = 0; i < kCellCount; ++i) {
+      if (Cell(i)->isLayoutDeferred()) continue;
+      if (first < 0) first = i;
+      EXPECT_TRUE(last < 0 || last == i - 1) << "cell " << i;
+      last = i;
+    }
+    return std::make_pair(first, last);
+  }
+
+  void Scroll(float offset) {
+    if (list_->SetScrollOffset(offset)) {
+      page_->set_is_dirty(true);
+    }
+    page_->LayoutImmediately();
+  }
+
+  RenderPage* page_;
+  RenderList* list_;
+};
+
+TEST_F(RenderListWindowTest, LaysOutEveryCellByDefault) {
+  ASSERT_TRUE(RenderManager::GetInstance()->CreateFinish("window"));
+  EXPECT_EQ(std::make_pair(0, kCellCount - 1), LaidOutCells());
+  EXPECT_FLOAT_EQ(kCellCount * kCellHeight, ContentLength());
+  EXPECT_FALSE(list_->SetScrollOffset(5000));
+}
+
+TEST_F(RenderListWindowTest, DefersCellsOutsideTheWindow) {
+  SetWindow("500", "100");
+  ASSERT_TRUE(RenderManager::GetInstance()->CreateFinish("window"));
+
+  // The window spans the list plus 500 of overscan after it.
+  std::pair<int, int> laid_out = LaidOutCells();
+  EXPECT_EQ(0, laid_out.first);
+  EXPECT_EQ(15, laid_out.second);
+  EXPECT_FLOAT_EQ(kCellHeight, Content(laid_out.second)->getLayoutHeight());
+
+  // Cells never measured take the estimate, so they neither collapse nor
+  // shift what follows.
+  RenderObject* deferred = Cell(50);
+  EXPECT_TRUE(deferred->isLayoutDeferred());
+  EXPECT_FLOAT_EQ(kCellHeight, deferred->getLayoutHeight());
+  EXPECT_FLOAT_EQ(50 * kCellHeight, deferred->getLayoutPositionTop());
+  EXPECT_FLOAT_EQ(kCellCount * kCellHeight, ContentLength());
+}
+
+TEST_F(RenderListWindowTest, UnmeasuredCellsTakeTheEstimate) {
+  SetWindow("500", "40");
+  ASSERT_TRUE(RenderManager::GetInstance()->CreateFinish("window"));
+
+  // The estimate only decides which cells are in the first window.
+  std::pair<int, int> laid_out = LaidOutCells();
+  EXPECT_EQ(0, laid_out.first);
+  EXPECT_EQ(37, laid_out.second);
+  EXPECT_FLOAT_EQ(40, Cell(80)->getLayoutHeight());
+}
+
+TEST_F(RenderListWindowTest, ScrollingMovesTheWindow) {
+  SetWindow("500", "100");
+  ASSERT_TRUE(RenderManager::GetInstance()->CreateFinish("window"));
+  float content_length = ContentLength();
+
+  // Within half the overscan the window stays where it is.
+  EXPECT_FALSE(list_->SetScrollOffset(250));
+  EXPECT_FALSE(page_->is_dirty());
+  EXPECT_EQ(std::make_pair(0, 15), LaidOutCells());
+
+  EXPECT_FALSE(Content(30)->getLayoutHeight() == kCellHeight);
+  Scroll(3000);
+  EXPECT_EQ(std::make_pair(24, 45), LaidOutCells());
+  EXPECT_FLOAT_EQ(kCellHeight, Content(30)->getLayoutHeight());
+  EXPECT_FLOAT_EQ(30 * kCellHeight, Cell(30)->getLayoutPositionTop());
+  // Cells that left the window keep their size.
+  EXPECT_TRUE(Cell(0)->isLayoutDeferred());
+  EXPECT_FLOAT_EQ(kCellHeight, Cell(0)->getLayoutHeight());
+  EXPECT_FLOAT_EQ(content_length, ContentLength());
+
+  Scroll(9000);
+  EXPECT_EQ(std::make_pair(84, kCellCount - 1), LaidOutCells());
+  EXPECT_FLOAT_EQ(content_length, ContentLength());
+
+  Scroll(0);
+  EXPECT_EQ(std::make_pair(0, 15), LaidOutCells());
+  EXPECT_FLOAT_EQ(content_length, ContentLength());
+}
+
+}  // namespace
@@ -0,0 +1,147 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+// RenderPage keeps its memory stats up to date as nodes come and go. Whatever
+// changed a node in between, through the page or behind it as the platform
+// and lists do, taking it out must subtract exactly what it added.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/config/core_environment.h"
+#include "core/render/manager/render_manager.h"
+#include "core/render/node/factory/render_creator.h"
+#include "core/render/node/render_object.h"
+#include "core/render/page/render_page.h"
+#include "gtest/gtest.h"
+#include "support/test_platform_side.h"
+
+namespace {
+
+using WeexCore::RenderCreator;
+using WeexCore::RenderManager;
+using WeexCore::RenderObject;
+using WeexCore::RenderPage;
+using WeexCore::TestPlatformSide;
+
+typedef std::vector<std::pair<std::string, std::string>> Pairs;
+
+// Indices into RenderMemoryStats::ToVector().
+const size_t kRenderObjects = 0;
+const size_t kLayoutNodes = 1;
+const size_t kStyleBytes = 2;
+const size_t kAttrBytes = 3;
+
+RenderObject* NewRender(const std::string& ref) {
+  return static_cast<RenderObject*>(
+      RenderCreator::GetInstance()->CreateRender("div", ref));
+}
+
+class RenderMemoryStatsTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    WeexCore::WXCoreEnvironment::getInstance()->SetDeviceWidth("750");
+    TestPlatformSide::Install();
+    ASSERT_TRUE(
+        RenderManager::GetInstance()->CreatePage("stats", NewRender("_root")));
+    page_ = static_cast<RenderPage*>(RenderManager::GetInstance()->GetPage("stats"));
+    ASSERT_NE(nullptr, page_);
+  }
+
+  void TearDown() override { RenderManager::GetInstance()->ClosePage("stats"); }
+
+  // The counters of the render tree, leaving out posted actions and the
+  // arena.
+  std::vector<int64_t> Stats() {
+    std::vector<int64_t> stats = page_->GetMemoryStats();
+    return std::vector<int64_t>(stats.begin(), stats.begin() + kAttrBytes + 1);
+  }
+
+  // Appends a node holding a few styles, attributes and an event, with one
+  // child of its own.
+  void AddSubtree(const std::string& ref) {
+    RenderObject* render = NewRender(ref);
+    render->AddStyle("width", "100", false);
+    render->AddStyle("backgroundColor", "red", false);
+    render->AddAttr("title", "hello");
+    render->AddAttr("dataCustomName", std::string(200, 'x'));
+    render->AddEvent("click");
+    RenderObject* child = NewRender(ref + "-child");
+    child->AddStyle("customStyleName", "1", false);
+    render->AddRenderObject(0, child);
+    ASSERT_TRUE(
+        RenderManager::GetInstance()->AddRenderObject("stats", "_root", -1, render));
+  }
+
+  RenderPage* page_;
+};
+
+TEST_F(RenderMemoryStatsTest, CountsNodesAndValues) {
+  std::vector<int64_t> empty = Stats();
+  AddSubtree("1");
+  std::vector<int64_t> added = Stats();
+  EXPECT_EQ(empty[kRenderObjects] + 2, added[kRenderObjects]);
+  EXPECT_EQ(empty[kLayoutNodes] + 2, added[kLayoutNodes]);
+  EXPECT_GT(added[kStyleBytes], empty[kStyleBytes]);
+  EXPECT_GT(added[kAttrBytes], empty[kAttrBytes] + 200);
+
+  ASSERT_TRUE(RenderManager::GetInstance()->RemoveRenderObject("stats", "1"));
+  EXPECT_EQ(empty, Stats());
+}
+
+TEST_F(RenderMemoryStatsTest, FollowsUpdatesThroughThePage) {
+  std::vector<int64_t> empty = Stats();
+  AddSubtree("1");
+  std::vector<int64_t> added = Stats();
+
+  Pairs styles = {{"color", std::string(100, 'y')}};
+  Pairs attrs = {{"anotherCustomName", std::string(100, 'z')}};
+  RenderManager::GetInstance()->UpdateStyle("stats", "1", &styles);
+  RenderManager::GetInstance()->UpdateAttr("stats", "1", &attrs);
+  RenderManager::GetInstance()->AddEvent("stats", "1", "longpress");
+  EXPECT_GT(Stats()[kAttrBytes], added[kAttrBytes] + 100);
+
+  RenderManager::GetInstance()->RemoveEvent("stats", "1", "click");
+  ASSERT_TRUE(RenderManager::GetInstance()->RemoveRenderObject("stats", "1"));
+  EXPECT_EQ(empty, Stats());
+}
+
+TEST_F(RenderMemoryStatsTest, ToleratesChangesBehindThePage) {
+  std::vector<int64_t> empty = Stats();
+  AddSubtree("1");
+  std::vector<int64_t> added = Stats();
+
+  // What the platform and lists do, without telling the page.
+  RenderObject* render = page_->GetRenderObject("1");
+  RenderObject* child = page_->GetRenderObject("1-child");
+  render->UpdateStyle("color", std::string(100, 'y'));
+  render->UpdateAttr("anotherCustomName", std::string(300, 'z'));
+  child->UpdateAttr("yetAnotherName", std::string(300, 'w'));
+  EXPECT_EQ(added, Stats());
+
+  // The next update through the page catches the node up.
+  Pairs attrs = {{"title", "world"}};
+  RenderManager::GetInstance()->UpdateAttr("stats", "1", &attrs);
+  EXPECT_GT(Stats()[kAttrBytes], added[kAttrBytes] + 300);
+
+  ASSERT_TRUE(RenderManager::GetInstance()->RemoveRenderObject("stats", "1"));
+  EXPECT_EQ(empty, Stats());
+}
+
+}  // namespace
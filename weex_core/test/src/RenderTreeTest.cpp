@@ -0,0 +1,181 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+// Deep trees through the render pipeline. Each pass that used to recurse once
+// per level, parsing the WSON body, registering and unregistering render
+// objects, collecting formatting contexts, posting add element actions and
+// deleting a subtree, now walks with an explicit stack; kDepth is deep enough
+// that a recursive pass would overflow the native stack. Flex measuring still
+// recurses per level, so trees that get laid out are kept to kLayoutDepth.
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "core/config/core_environment.h"
+#include "core/render/manager/render_manager.h"
+#include "core/render/node/factory/render_creator.h"
+#include "core/render/node/render_object.h"
+#include "core/render/page/render_page.h"
+#include "gtest/gtest.h"
+#include "support/test_platform_side.h"
+#include "wson/wson.h"
+#include "wson/wson_parser.h"
+
+namespace WeexCore {
+// Defined in core/parser/dom_wson.cpp, which only exports Wson2RenderObject;
+// that one caps the body at 1MB.
+RenderObject* parserWson2RenderObject(wson_parser& parser, RenderObject* parent,
+                                      int index, const std::string& page_id,
+                                      bool reserve_styles);
+}  // namespace WeexCore
+
+namespace {
+
+using WeexCore::RenderCreator;
+using WeexCore::RenderManager;
+using WeexCore::RenderObject;
+using WeexCore::RenderPage;
+using WeexCore::TestPlatformSide;
+
+const int kDepth = 50000;
+const int kLayoutDepth = 5000;
+
+void PushKey(wson_buffer* buffer, const std::string& key) {
+  // Map keys are UTF-16 without a type byte.
+  std::vector<uint16_t> utf16(key.begin(), key.end());
+  wson_push_property(buffer, utf16.data(), utf16.size() * sizeof(uint16_t));
+}
+
+void PushString(wson_buffer* buffer, const std::string& value) {
+  wson_push_type_uint8_string(
+      buffer, reinterpret_cast<const uint8_t*>(value.data()), value.size());
+}
+
+// A body holding a chain of |depth| divs, each the only child of the one
+// before, refs "0" to "depth - 1".
+wson_buffer* BuildDeepBody(int depth) {
+  wson_buffer* buffer = wson_buffer_new();
+  for (int i = 0; i < depth; ++i) {
+    wson_push_type_map(buffer, 4);
+    PushKey(buffer, "ref");
+    PushString(buffer, std::to_string(i));
+    PushKey(buffer, "type");
+    PushString(buffer, "div");
+    PushKey(buffer, "style");
+    wson_push_type_map(buffer, 1);
+    PushKey(buffer, "paddingLeft");
+    PushString(buffer, "1");
+    PushKey(buffer, "children");
+    wson_push_type_array(buffer, i + 1 < depth ? 1 : 0);
+  }
+  return buffer;
+}
+
+RenderObject* BuildDeepChain(const std::string& prefix, int depth) {
+  RenderObject* root = static_cast<RenderObject*>(
+      RenderCreator::GetInstance()->CreateRender("div", prefix + "0"));
+  RenderObject* tail = root;
+  for (int i = 1; i < depth; ++i) {
+    RenderObject* child = static_cast<RenderObject*>(
+        RenderCreator::GetInstance()->CreateRender("div",
+                                                   prefix + std::to_string(i)));
+    tail->AddRenderObject(0, child);
+    tail = child;
+  }
+  return root;
+}
+
+class RenderTreeTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    WeexCore::WXCoreEnvironment::getInstance()->SetDeviceWidth("750");
+    platform_ = TestPlatformSide::Install();
+  }
+
+  TestPlatformSide* platform_;
+};
+
+TEST_F(RenderTreeTest, DeepWsonBody) {
+  wson_buffer* body = BuildDeepBody(kDepth);
+  RenderManager* manager = RenderManager::GetInstance();
+  ASSERT_TRUE(manager->CreatePage("deep-wson", [body](RenderPage* page) {
+    wson_parser parser(static_cast<const char*>(body->data), body->position);
+    return WeexCore::parserWson2RenderObject(parser, nullptr, 0, "deep-wson",
+                                             page->reserve_css_styles());
+  }));
+  wson_buffer_free(body);
+
+  RenderPage* page =
+      static_cast<RenderPage*>(manager->GetPage("deep-wson"));
+  ASSERT_NE(nullptr, page);
+  RenderObject* leaf = page->GetRenderObject(std::to_string(kDepth - 1));
+  ASSERT_NE(nullptr, leaf);
+  EXPECT_EQ(std::to_string(kDepth - 2), leaf->parent_render()->ref());
+  EXPECT_EQ(1, platform_->create_body_count);
+  EXPECT_EQ(kDepth - 1, platform_->add_element_count);
+
+  ASSERT_TRUE(manager->RemoveRenderObject("deep-wson", "1"));
+  EXPECT_EQ(nullptr, page->GetRenderObject("1"));
+  EXPECT_EQ(nullptr, page->GetRenderObject(std::to_string(kDepth - 1)));
+  EXPECT_NE(nullptr, page->GetRenderObject("0"));
+  EXPECT_EQ(1, platform_->remove_element_count);
+
+  EXPECT_TRUE(manager->ClosePage("deep-wson"));
+}
+
+TEST_F(RenderTreeTest, DeepRenderChain) {
+  RenderManager* manager = RenderManager::GetInstance();
+  ASSERT_TRUE(manager->CreatePage("deep-chain", BuildDeepChain("", 1)));
+  RenderPage* page =
+      static_cast<RenderPage*>(manager->GetPage("deep-chain"));
+  ASSERT_NE(nullptr, page);
+
+  ASSERT_TRUE(
+      manager->AddRenderObject("deep-chain", "0", 0, BuildDeepChain("c", kDepth)));
+  EXPECT_EQ(kDepth, platform_->add_element_count);
+  EXPECT_NE(nullptr, page->GetRenderObject("c" + std::to_string(kDepth - 1)));
+
+  ASSERT_TRUE(manager->RemoveRenderObject("deep-chain", "c0"));
+  EXPECT_EQ(nullptr, page->GetRenderObject("c" + std::to_string(kDepth - 1)));
+  EXPECT_TRUE(manager->ClosePage("deep-chain"));
+
+  // A chain that was never attached to a page is freed by its root alone.
+  delete BuildDeepChain("d", kDepth);
+}
+
+TEST_F(RenderTreeTest, DeepLayout) {
+  wson_buffer* body = BuildDeepBody(kLayoutDepth);
+  RenderManager* manager = RenderManager::GetInstance();
+  ASSERT_TRUE(manager->CreatePage("deep-layout",
+                                  static_cast<const char*>(body->data)));
+  wson_buffer_free(body);
+
+  ASSERT_TRUE(manager->CreateFinish("deep-layout"));
+  EXPECT_EQ(kLayoutDepth, platform_->layout_count);
+  RenderPage* page =
+      static_cast<RenderPage*>(manager->GetPage("deep-layout"));
+  RenderObject* leaf = page->GetRenderObject(std::to_string(kLayoutDepth - 1));
+  ASSERT_NE(nullptr, leaf);
+  // Every level sits inside its parent's one pixel of padding.
+  EXPECT_FLOAT_EQ(1, leaf->getLayoutPositionLeft());
+  EXPECT_TRUE(manager->ClosePage("deep-layout"));
+}
+
+}  // namespace
@@ -0,0 +1,302 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+// Checks the update diff: RenderObject::IsStyleUnchanged must answer true for
+// a style exactly when ApplyStyle would leave the node as it is, for every
+// kind of style it handles, and RenderPage must still send updates the diff
+// cannot judge, raw styles kept for a relayout and values the platform
+// changes on its own.
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "core/config/core_environment.h"
+#include "core/moniter/render_performance.h"
+#include "core/render/manager/render_manager.h"
+#include "core/render/node/factory/render_creator.h"
+#include "core/render/node/render_object.h"
+#include "core/render/page/render_page.h"
+#include "gtest/gtest.h"
+#include "support/test_platform_side.h"
+
+namespace {
+
+using WeexCore::RenderCreator;
+using WeexCore::RenderManager;
+using WeexCore::RenderObject;
+using WeexCore::TestPlatformSide;
+
+typedef std::vector<std::pair<std::string, std::string>> Pairs;
+
+RenderObject* NewRender(const std::string& ref) {
+  return static_cast<RenderObject*>(
+      RenderCreator::GetInstance()->CreateRender("div", ref));
+}
+
+bool HasStyle(RenderObject* render, const std::string& key) {
+  return render->styles() != nullptr &&
+         render->styles()->find(key) != render->styles()->end();
+}
+
+// Everything ApplyStyle may change, printed so a mismatch shows what moved.
+std::string Snapshot(RenderObject* render, const std::string& key) {
+  char buffer[1024];
+  snprintf(buffer, sizeof(buffer),
+           "flex %g %d %d %d %d %d dir %d pos %d | w %g %d h %g %d | "
+           "min %g %g max %g %g | edge %g %g %g %g | m %g %g %g %g | "
+           "p %g %g %g %g | b %g %g %g %g | %s %s",
+           render->getFlex(), render->getAlignItems(), render->getAlignSelf(),
+           render->getFlexDirection(), render->getJustifyContent(),
+           render->getFlexWrap(), render->getDirection(),
+           render->getStylePositionType(), render->getStyleWidth(),
+           render->getStyleWidthLevel(), render->getStyleHeight(),
+           render->getStyleHeightLevel(), render->getMinWidth(),
+           render->getMinHeight(), render->getMaxWidth(),
+           render->getMaxHeight(), render->getStylePositionLeft(),
+           render->getStylePositionTop(), render->getStylePositionRight(),
+           render->getStylePositionBottom(), render->getMarginLeft(),
+           render->getMarginTop(), render->getMarginRight(),
+           render->getMarginBottom(), render->getPaddingLeft(),
+           render->getPaddingTop(), render->getPaddingRight(),
+           render->getPaddingBottom(), render->getBorderWidthLeft(),
+           render->getBorderWidthTop(), render->getBorderWidthRight(),
+           render->getBorderWidthBottom(),
+           HasStyle(render, key) ? "set" : "unset", render->GetStyle(key).c_str());
+  return buffer;
+}
+
+struct StyleCase {
+  Pairs initial;
+  std::string key;
+  std::string value;
+};
+
+void ExpectAgreesWithApplyStyle(const std::vector<StyleCase>& cases) {
+  for (const StyleCase& c : cases) {
+    RenderObject* render = NewRender("1");
+    for (auto& style : c.initial) {
+      render->AddStyle(style.first, style.second, false);
+    }
+    bool unchanged = render->IsStyleUnchanged(c.key, c.value);
+    std::string before = Snapshot(render, c.key);
+    render->UpdateStyle(c.key, c.value);
+    std::string after = Snapshot(render, c.key);
+    EXPECT_EQ(before == after, unchanged)
+        << c.key << ": \"" << c.value << "\"\n  before " << before
+        << "\n  after  " << after;
+    delete render;
+  }
+}
+
+TEST(UpdateDiffTest, LayoutEnums) {
+  ExpectAgreesWithApplyStyle({
+      {{{"alignItems", "center"}}, "alignItems", "center"},
+      {{{"alignItems", "center"}}, "alignItems", "flex-end"},
+      {{}, "alignItems", "stretch"},
+      {{{"alignSelf", "center"}}, "alignSelf", "center"},
+      {{}, "alignSelf", "flex-start"},
+      {{{"flexDirection", "row"}}, "flexDirection", "row"},
+      {{{"flexDirection", "row"}}, "flexDirection", "column"},
+      {{{"justifyContent", "center"}}, "justifyContent", "center"},
+      {{}, "justifyContent", "space-between"},
+      {{{"flexWrap", "wrap"}}, "flexWrap", "wrap"},
+      {{}, "flexWrap", "wrap"},
+      {{{"direction", "rtl"}}, "direction", "rtl"},
+      {{}, "direction", "rtl"},
+  });
+}
+
+TEST(UpdateDiffTest, Flex) {
+  ExpectAgreesWithApplyStyle({
+      {{{"flex", "1"}}, "flex", "1"},
+      {{{"flex", "1"}}, "flex", "1.0"},
+      {{{"flex", "1"}}, "flex", "2"},
+      {{{"flex", "1"}}, "flex", ""},
+      {{}, "flex", ""},
+      {{{"flex", "1"}}, "flex", "none"},
+  });
+}
+
+TEST(UpdateDiffTest, Sizes) {
+  ExpectAgreesWithApplyStyle({
+      {{{"width", "100"}}, "width", "100"},
+      {{{"width", "100"}}, "width", "100px"},
+      {{{"width", "100"}}, "width", "200"},
+      {{{"width", "100"}}, "width", ""},
+      {{{"width", "100"}}, "width", "auto"},
+      {{}, "width", "100"},
+      {{{"height", "50"}}, "height", "50"},
+      {{{"height", "50"}}, "height", "60"},
+      {{}, "height", ""},
+      {{{"minWidth", "10"}}, "minWidth", "10"},
+      {{{"minWidth", "10"}}, "minWidth", "20"},
+      {{{"minHeight", "10"}}, "minHeight", ""},
+      {{{"maxWidth", "10"}}, "maxWidth", "10"},
+      {{}, "maxHeight", "30"},
+  });
+}
+
+TEST(UpdateDiffTest, Position) {
+  ExpectAgreesWithApplyStyle({
+      {{{"position", "absolute"}}, "position", "absolute"},
+      {{{"position", "absolute"}}, "position", "relative"},
+      {{}, "position", "relative"},
+      {{{"position", "sticky"}}, "position", "sticky"},
+      {{{"left", "10"}}, "left", "10"},
+      {{{"left", "10"}}, "left", "20"},
+      {{{"top", "10"}}, "top", ""},
+      {{}, "right", "5"},
+      {{{"bottom", "0"}}, "bottom", "0"},
+  });
+}
+
+TEST(UpdateDiffTest, EdgeShorthandsAndLonghands) {
+  ExpectAgreesWithApplyStyle({
+      {{{"margin", "10"}}, "margin", "10"},
+      {{{"margin", "10"}}, "margin", "20"},
+      {{{"margin", "10"}, {"marginLeft", "5"}}, "margin", "10"},
+      {{{"margin", "10"}}, "marginLeft", "10"},
+      {{{"margin", "10"}}, "marginTop", "5"},
+      {{}, "margin", "0"},
+      {{}, "marginRight", ""},
+      {{{"marginBottom", "3"}}, "marginBottom", ""},
+      {{{"padding", "4"}}, "padding", "4"},
+      {{{"padding", "4"}, {"paddingTop", "1"}}, "padding", "4"},
+      {{{"padding", "4"}}, "paddingRight", "4"},
+      {{{"paddingLeft", "4"}}, "paddingLeft", "8"},
+      {{}, "paddingBottom", "0"},
+      {{{"borderWidth", "2"}}, "borderWidth", "2"},
+      {{{"borderWidth", "2"}, {"borderLeftWidth", "1"}}, "borderWidth", "2"},
+      {{{"borderWidth", "2"}}, "borderTopWidth", "2"},
+      {{{"borderRightWidth", "2"}}, "borderRightWidth", "3"},
+      {{}, "borderBottomWidth", ""},
+  });
+}
+
+TEST(UpdateDiffTest, PlainAndJsonStyles) {
+  ExpectAgreesWithApplyStyle({
+      {{{"color", "red"}}, "color", "red"},
+      {{{"color", "red"}}, "color", "blue"},
+      {{}, "color", ""},
+      {{}, "color", "red"},
+      {{{"fontSize", "12"}}, "fontSize", "12.0"},
+      {{{"boxShadow", "{\"a\":1}"}}, "boxShadow", "{\"a\":1}"},
+      {{{"boxShadow", "{\"a\":1}"}}, "boxShadow", "{\"a\":2}"},
+      {{}, "columns", "[1,2]"},
+  });
+}
+
+class UpdateDiffPageTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    WeexCore::WXCoreEnvironment::getInstance()->SetDeviceWidth("750");
+    platform_ = TestPlatformSide::Install();
+  }
+
+  void TearDown() override {
+    WeexCore::WXCoreEnvironment::getInstance()->PutOption("enableUpdateDiff",
+                                                          "");
+    RenderManager::GetInstance()->ClosePage("diff");
+  }
+
+  void CreatePage(bool diff) {
+    WeexCore::WXCoreEnvironment::getInstance()->PutOption(
+        "enableUpdateDiff", diff ? "true" : "");
+    RenderObject* root = NewRender("_root");
+    root->AddStyle("width", "750", false);
+    RenderObject* child = NewRender("1");
+    child->AddStyle("width", "100", false);
+    child->AddStyle("opacity", "1", false);
+    child->AddStyle("color", "red", false);
+    child->AddAttr("value", "hello");
+    child->AddAttr("title", "hello");
+    root->AddRenderObject(0, child);
+    ASSERT_TRUE(RenderManager::GetInstance()->CreatePage("diff", root));
+    platform_->Reset();
+  }
+
+  bool UpdateStyle(const std::string& ref, Pairs pairs) {
+    return RenderManager::GetInstance()->UpdateStyle("diff", ref, &pairs);
+  }
+
+  bool UpdateAttr(const std::string& ref, Pairs pairs) {
+    return RenderManager::GetInstance()->UpdateAttr("diff", ref, &pairs);
+  }
+
+  TestPlatformSide* platform_;
+};
+
+TEST_F(UpdateDiffPageTest, OffByDefault) {
+  CreatePage(false);
+  UpdateStyle("1", {{"color", "red"}});
+  UpdateAttr("1", {{"title", "hello"}});
+  EXPECT_EQ(Pairs({{"color", "red"}}), platform_->updated_styles);
+  EXPECT_EQ(Pairs({{"title", "hello"}}), platform_->updated_attrs);
+}
+
+TEST_F(UpdateDiffPageTest, DropsUnchanged) {
+  CreatePage(true);
+  EXPECT_FALSE(UpdateStyle("1", {{"color", "red"}}));
+  UpdateStyle("1", {{"color", "red"}, {"backgroundColor", "blue"}});
+  UpdateAttr("1", {{"title", "hello"}});
+  UpdateAttr("1", {{"title", "world"}});
+  EXPECT_EQ(Pairs({{"backgroundColor", "blue"}}), platform_->updated_styles);
+  EXPECT_EQ(Pairs({{"title", "world"}}), platform_->updated_attrs);
+}
+
+TEST_F(UpdateDiffPageTest, ReleasesSuppressedUpdates) {
+  CreatePage(true);
+  // Every other path releases the buffer of the parsed pairs as well.
+  Pairs styles = {{"color", "red"}, {"width", "100"}};
+  Pairs attrs = {{"title", "hello"}};
+  EXPECT_FALSE(RenderManager::GetInstance()->UpdateStyle("diff", "1", &styles));
+  EXPECT_FALSE(RenderManager::GetInstance()->UpdateAttr("diff", "1", &attrs));
+  EXPECT_EQ(0u, styles.capacity());
+  EXPECT_EQ(0u, attrs.capacity());
+}
+
+TEST_F(UpdateDiffPageTest, KeepsPlatformMutableValues) {
+  CreatePage(true);
+  // An animation may have moved these, or the user typed into the input.
+  UpdateStyle("1", {{"opacity", "1"}});
+  UpdateAttr("1", {{"value", "hello"}});
+  EXPECT_EQ(Pairs({{"opacity", "1"}}), platform_->updated_styles);
+  EXPECT_EQ(Pairs({{"value", "hello"}}), platform_->updated_attrs);
+}
+
+TEST_F(UpdateDiffPageTest, KeepsRawStylesOfRoot) {
+  CreatePage(true);
+  WeexCore::RenderPage* page = static_cast<WeexCore::RenderPage*>(
+      RenderManager::GetInstance()->GetPage("diff"));
+  RenderObject* root = page->GetRenderObject("_root");
+  // Both parse to what the root already has, but the root replays its raw
+  // styles on a relayout, so the new strings have to be stored.
+  UpdateStyle("_root", {{"flexDirection", "column"}});
+  EXPECT_EQ("column", root->GetStyle("flexDirection"));
+  UpdateStyle("_root", {{"left", "10"}});
+  UpdateStyle("_root", {{"left", "10.0"}});
+  EXPECT_EQ("10.0", root->GetStyle("left"));
+
+  EXPECT_EQ(0, page->getPerformance()->suppressedStyleUpdates);
+
+  UpdateStyle("_root", {{"left", "10.0"}});
+  EXPECT_EQ(1, page->getPerformance()->suppressedStyleUpdates);
+}
+
+}  // namespace
@@ -0,0 +1,215 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+// Footprint benchmark of per node style, attribute and event storage: builds
+// the same synthetic render tree nodes once with std::map/std::set, which is
+// what RenderObject used, and once with SmallStringMap/SmallStringSet. Heap
+// usage comes from the allocator, so both the node allocations of the std
+// containers and the malloc blocks of the small ones are counted, as are
+// keys outside the shared name vocabulary. Prints bytes per node and build/lookup times, and exits
+// non zero if the two representations disagree on any lookup or ordering.
+
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "core/common/small_string_map.h"
+
+namespace {
+
+using WeexCore::SmallStringMap;
+using WeexCore::SmallStringSet;
+
+const char* const kStyleKeys[] = {
+    "width",       "height",     "flexDirection", "backgroundColor",
+    "color",       "fontSize",   "marginTop",     "paddingLeft",
+    "alignItems",  "position",   "borderRadius",  "justifyContent",
+    "lineHeight",  "opacity",    "top",           "left"};
+const char* const kAttrKeys[] = {"value", "src", "class", "ref", "lines",
+                                 "resize", "scrollDirection", "show"};
+const char* const kEvents[] = {"click", "appear", "disappear", "scroll",
+                               "longpress"};
+
+struct Spec {
+  std::vector<std::pair<std::string, std::string>> styles;
+  std::vector<std::pair<std::string, std::string>> attributes;
+  std::vector<std::string> events;
+};
+
+struct StdNode {
+  std::map<std::string, std::string> styles;
+  std::map<std::string, std::string> attributes;
+  std::set<std::string> events;
+};
+
+struct SmallNode {
+  SmallStringMap styles;
+  SmallStringMap attributes;
+  SmallStringSet events;
+};
+
+size_t HeapInUse() {
+#if defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  return mallinfo2().uordblks;
+#else
+  return static_cast<size_t>(mallinfo().uordblks);
+#endif
+}
+
+// Most nodes carry a handful of styles, one or two attributes and rarely
+// more than one event; a few containers carry many styles.
+std::vector<Spec> MakeSpecs(int count) {
+  std::mt19937 random(20190605);
+  std::vector<Spec> specs(count);
+  const int style_count = sizeof(kStyleKeys) / sizeof(kStyleKeys[0]);
+  const int attr_count = sizeof(kAttrKeys) / sizeof(kAttrKeys[0]);
+  const int event_count = sizeof(kEvents) / sizeof(kEvents[0]);
+  for (Spec& spec : specs) {
+    int styles = random() % 10 == 0 ? 8 + random() % 8 : 1 + random() % 5;
+    for (int i = 0; i < styles; ++i) {
+      spec.styles.emplace_back(kStyleKeys[random() % style_count],
+                               std::to_string(random() % 750) + "px");
+    }
+    int attributes = random() % 3;
+    for (int i = 0; i < attributes; ++i) {
+      spec.attributes.emplace_back(kAttrKeys[random() % attr_count],
+                                   "v" + std::to_string(random() % 100));
+    }
+    int events = random() % 4 == 0 ? 1 + random() % 2 : 0;
+    for (int i = 0; i < events; ++i) {
+      spec.events.emplace_back(kEvents[random() % event_count]);
+    }
+  }
+  return specs;
+}
+
+template <typename Node>
+void Fill(Node* node, const Spec& spec) {
+  for (const auto& style : spec.styles) node->styles[style.first] = style.second;
+  for (const auto& attr : spec.attributes) node->attributes.insert(attr);
+  for (const auto& event : spec.events) node->events.insert(event);
+}
+
+template <typename Node>
+std::vector<std::unique_ptr<Node>> Build(const std::vector<Spec>& specs,
+                                         size_t* bytes, double* seconds) {
+  std::vector<std::unique_ptr<Node>> nodes;
+  nodes.reserve(specs.size());
+  size_t before = HeapInUse();
+  auto start = std::chrono::steady_clock::now();
+  for (const Spec& spec : specs) {
+    nodes.emplace_back(new Node());
+    Fill(nodes.back().get(), spec);
+  }
+  *seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                           start)
+                 .count();
+  *bytes = HeapInUse() - before;
+  return nodes;
+}
+
+template <typename Node>
+double Lookup(const std::vector<std::unique_ptr<Node>>& nodes, size_t* hits) {
+  auto start = std::chrono::steady_clock::now();
+  size_t found = 0;
+  for (const auto& node : nodes) {
+    for (const char* key : kStyleKeys) {
+      auto it = node->styles.find(key);
+      if (it != node->styles.end()) found += it->second.size();
+    }
+    found += node->events.count("click");
+  }
+  *hits = found;
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+bool Same(const StdNode& expected, const SmallNode& actual) {
+  if (expected.styles.size() != actual.styles.size() ||
+      expected.attributes.size() != actual.attributes.size() ||
+      expected.events.size() != actual.events.size()) {
+    return false;
+  }
+  auto style = actual.styles.begin();
+  for (const auto& entry : expected.styles) {
+    if (entry.first != style->first || entry.second != style->second) {
+      return false;
+    }
+    ++style;
+  }
+  auto attr = actual.attributes.begin();
+  for (const auto& entry : expected.attributes) {
+    if (entry.first != attr->first || entry.second != attr->second) {
+      return false;
+    }
+    ++attr;
+  }
+  auto event = actual.events.begin();
+  for (const auto& entry : expected.events) {
+    if (entry != *event) return false;
+    ++event;
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int node_count = 10000;
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (strcmp(argv[i], "--nodes") == 0) node_count = atoi(argv[++i]);
+  }
+
+  std::vector<Spec> specs = MakeSpecs(node_count);
+  size_t std_bytes = 0, small_bytes = 0;
+  double std_build = 0, small_build = 0;
+  auto std_nodes = Build<StdNode>(specs, &std_bytes, &std_build);
+  auto small_nodes = Build<SmallNode>(specs, &small_bytes, &small_build);
+
+  size_t std_hits = 0, small_hits = 0;
+  double std_lookup = Lookup(std_nodes, &std_hits);
+  double small_lookup = Lookup(small_nodes, &small_hits);
+
+  int mismatches = std_hits != small_hits ? 1 : 0;
+  for (size_t i = 0; i < specs.size(); ++i) {
+    if (!Same(*std_nodes[i], *small_nodes[i])) ++mismatches;
+  }
+
+  printf("%-22s %14s %14s %14s\n", "", "std::map/set", "small", "ratio");
+  printf("%-22s %14.1f %14.1f %13.2fx\n", "heap bytes per node",
+         static_cast<double>(std_bytes) / node_count,
+         static_cast<double>(small_bytes) / node_count,
+         static_cast<double>(std_bytes) / small_bytes);
+  printf("%-22s %14zu %14zu\n", "sizeof(node)", sizeof(StdNode),
+         sizeof(SmallNode));
+  printf("%-22s %14.2f %14.2f %13.2fx\n", "build ms", std_build * 1e3,
+         small_build * 1e3, std_build / small_build);
+  printf("%-22s %14.2f %14.2f %13.2fx\n", "lookup ms", std_lookup * 1e3,
+         small_lookup * 1e3, std_lookup / small_lookup);
+  if (mismatches != 0) printf("%d nodes differ\n", mismatches);
+  return mismatches == 0 ? 0 : 1;
+}
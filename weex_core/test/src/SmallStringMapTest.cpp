@@ -0,0 +1,165 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+// SmallStringMap and SmallStringSet names: vocabulary names are shared by
+// every container, any other name is owned by its entry, survives the moves
+// and copies of its container and is freed with it.
+
+#include <malloc.h>
+#include <string>
+#include <vector>
+
+#include "core/common/small_string_map.h"
+#include "core/css/constants_name.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+using WeexCore::FindKnownName;
+using WeexCore::IsKnownName;
+using WeexCore::SmallStringMap;
+using WeexCore::SmallStringSet;
+
+size_t HeapInUse() {
+#if defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  return mallinfo2().uordblks;
+#else
+  return static_cast<size_t>(mallinfo().uordblks);
+#endif
+}
+
+TEST(SmallStringMapTest, SharesVocabularyNames) {
+  SmallStringMap first;
+  SmallStringMap second;
+  first["width"] = "10";
+  second.InsertOrAssign("width", "20");
+  EXPECT_EQ(&first.begin()->first, &second.begin()->first);
+  EXPECT_TRUE(IsKnownName(&first.begin()->first));
+  EXPECT_EQ(FindKnownName("width"), &first.begin()->first);
+
+  // Text measurement and layout cache keys rely on these being shared.
+  for (const char* name :
+       {WeexCore::FONT_SIZE, WeexCore::FONT_STYLE, WeexCore::FONT_WEIGHT,
+        WeexCore::FONT_FAMILY, WeexCore::LINE_HEIGHT, WeexCore::TEXT_OVERFLOW,
+        WeexCore::LETTER_SPACING, WeexCore::WHITE_SPACE, WeexCore::VALUE,
+        WeexCore::LINES}) {
+    EXPECT_NE(nullptr, FindKnownName(name)) << name;
+  }
+}
+
+TEST(SmallStringMapTest, OwnsOtherNames) {
+  SmallStringMap map;
+  size_t empty_size = map.ByteSize();
+  // Inserted out of order and past the inline entries, so entries move.
+  for (const char* key : {"zeta", "width", "gamma", "alpha", "beta"}) {
+    map[key] = key;
+  }
+  ASSERT_EQ(5u, map.size());
+  std::vector<std::string> keys;
+  for (const auto& entry : map) {
+    keys.push_back(entry.first);
+    EXPECT_EQ(entry.first, entry.second);
+    EXPECT_EQ(entry.first == "width", IsKnownName(&entry.first));
+  }
+  EXPECT_EQ((std::vector<std::string>{"alpha", "beta", "gamma", "width",
+                                      "zeta"}),
+            keys);
+  EXPECT_LE(empty_size + 4 * sizeof(std::string), map.ByteSize());
+
+  SmallStringMap copy = map;
+  EXPECT_NE(&map.find("alpha")->first, &copy.find("alpha")->first);
+  EXPECT_EQ(&map.find("width")->first, &copy.find("width")->first);
+  map.clear();
+  EXPECT_EQ("gamma", copy.find("gamma")->first);
+  EXPECT_EQ(1u, copy.erase("gamma"));
+  EXPECT_EQ(copy.end(), copy.find("gamma"));
+  EXPECT_EQ("zeta", copy.find("zeta")->second);
+}
+
+TEST(SmallStringMapTest, MovesOwnedNamesWithTheirEntries) {
+  SmallStringMap map;
+  map["zz-page-name"] = "v";
+  const std::string* name = &map.begin()->first;
+  // Each insert lands before it, shifting it and growing past the inline
+  // entries; the entry keeps the same name rather than a copy.
+  for (const char* key : {"yy", "xx", "ww", "vv", "uu", "tt"}) {
+    map[key] = key;
+    EXPECT_EQ(name, &map.find("zz-page-name")->first) << key;
+  }
+  map.erase("tt");
+  EXPECT_EQ(name, &map.find("zz-page-name")->first);
+  SmallStringMap moved = std::move(map);
+  EXPECT_EQ(name, &moved.find("zz-page-name")->first);
+
+  SmallStringSet set;
+  set.insert("zz-page-event");
+  const std::string* event = &*set.begin();
+  for (const char* value : {"yy", "xx", "ww", "vv"}) {
+    set.insert(value);
+    EXPECT_EQ(event, &*set.find("zz-page-event")) << value;
+  }
+}
+
+TEST(SmallStringMapTest, VocabularyComesFromConstantNames) {
+#define EXPECT_KNOWN_CONSTANT(identifier, name) \
+  EXPECT_EQ(FindKnownName(name), FindKnownName(WeexCore::identifier)) << name; \
+  EXPECT_NE(nullptr, FindKnownName(name)) << name;
+  WEEX_CORE_CONSTANT_NAMES(EXPECT_KNOWN_CONSTANT)
+#undef EXPECT_KNOWN_CONSTANT
+  EXPECT_NE(nullptr, FindKnownName("borderRadius"));
+  EXPECT_NE(nullptr, FindKnownName("click"));
+  EXPECT_EQ(nullptr, FindKnownName("zz-page-name"));
+}
+
+TEST(SmallStringMapTest, FreesOtherNames) {
+  // Warm up, so that allocations made once per process are not counted.
+  { SmallStringMap map; map["warm"] = ""; }
+  size_t before = HeapInUse();
+  for (int i = 0; i < 1000; ++i) {
+    SmallStringMap map;
+    SmallStringSet set;
+    for (int j = 0; j < 5; ++j) {
+      std::string name = "page-defined-name-" + std::to_string(i * 5 + j);
+      map[name] = "v";
+      set.insert(name);
+    }
+  }
+  // A pool keeping each of the 5000 names would hold far more than this.
+  EXPECT_LT(HeapInUse(), before + 4096);
+}
+
+TEST(SmallStringSetTest, SharesVocabularyAndOwnsOtherNames) {
+  SmallStringSet set;
+  set.insert("myEvent");
+  set.insert("click");
+  set.insert("appear");
+  EXPECT_FALSE(set.insert("click").second);
+  ASSERT_EQ(3u, set.size());
+  EXPECT_EQ(FindKnownName("click"), &*set.find("click"));
+  EXPECT_FALSE(IsKnownName(&*set.find("myEvent")));
+
+  SmallStringSet copy = set;
+  set.clear();
+  std::vector<std::string> names(copy.begin(), copy.end());
+  EXPECT_EQ((std::vector<std::string>{"appear", "click", "myEvent"}), names);
+  EXPECT_EQ(1u, copy.erase("myEvent"));
+  EXPECT_EQ(0u, copy.count("myEvent"));
+}
+
+}  // namespace
@@ -0,0 +1,99 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+// TimerBatch runs the timers that expired together. A timer cleared before or
+// while its batch runs must not fire, and one-shot functions are released
+// exactly once either way.
+
+#include <cstdint>
+#include <vector>
+
+#include "js_runtime/weex/task/timer_batch.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+struct Calls {
+  std::vector<uint32_t> executed;
+  std::vector<uint32_t> released;
+};
+
+void RunBatch(TimerBatch &batch, Calls &calls) {
+  batch.run([&](uint32_t function) { calls.executed.push_back(function); },
+            [&](uint32_t function) { calls.released.push_back(function); });
+}
+
+TEST(TimerBatchTest, RunsTimersInOrder) {
+  TimerBatch batch;
+  batch.add(1, 101, true);
+  batch.add(2, 102, false);
+  batch.add(3, 103, true);
+  Calls calls;
+  RunBatch(batch, calls);
+  EXPECT_EQ(std::vector<uint32_t>({1, 2, 3}), calls.executed);
+  EXPECT_EQ(std::vector<uint32_t>({1, 3}), calls.released);
+}
+
+TEST(TimerBatchTest, CancelBeforeRun) {
+  TimerBatch batch;
+  batch.add(1, 101, true);
+  batch.add(2, 102, false);
+  EXPECT_TRUE(batch.cancel(101));
+  EXPECT_FALSE(batch.cancel(101));
+  EXPECT_TRUE(batch.cancel(102));
+  EXPECT_FALSE(batch.cancel(999));
+  Calls calls;
+  RunBatch(batch, calls);
+  EXPECT_TRUE(calls.executed.empty());
+  // The interval's function is released by TimerQueue when it is cleared.
+  EXPECT_EQ(std::vector<uint32_t>({1}), calls.released);
+}
+
+TEST(TimerBatchTest, ACancelsBInSameTick) {
+  TimerBatch batch;
+  batch.add(1, 101, true);
+  batch.add(2, 102, true);
+  batch.add(3, 103, true);
+  Calls calls;
+  batch.run(
+      [&](uint32_t function) {
+        calls.executed.push_back(function);
+        if (function == 1) {
+          EXPECT_TRUE(batch.cancel(102));
+        }
+      },
+      [&](uint32_t function) { calls.released.push_back(function); });
+  EXPECT_EQ(std::vector<uint32_t>({1, 3}), calls.executed);
+  EXPECT_EQ(std::vector<uint32_t>({1, 2, 3}), calls.released);
+}
+
+TEST(TimerBatchTest, CancelsItselfWhileRunning) {
+  TimerBatch batch;
+  batch.add(1, 101, true);
+  Calls calls;
+  batch.run(
+      [&](uint32_t function) {
+        calls.executed.push_back(function);
+        EXPECT_TRUE(batch.cancel(101));
+      },
+      [&](uint32_t function) { calls.released.push_back(function); });
+  EXPECT_EQ(std::vector<uint32_t>({1}), calls.executed);
+  EXPECT_EQ(std::vector<uint32_t>({1}), calls.released);
+}
+
+}  // namespace
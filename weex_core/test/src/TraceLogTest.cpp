@@ -0,0 +1,200 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+// TraceLog: slices and flows recorded on several threads come out of
+// ExportJson as Chrome trace events, with flows bound across threads.
+
+#include <stdio.h>
+#include <unistd.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/trace/trace_event.h"
+#include "base/trace/trace_log.h"
+#include "gtest/gtest.h"
+#include "third_party/json11/json11.hpp"
+
+namespace {
+
+using json11::Json;
+using weex::base::ScopedTraceFlow;
+using weex::base::TraceLog;
+
+// The recorded events of |category|, in export order.
+std::vector<Json> Events(const std::string& json, const std::string& category) {
+  std::string error;
+  Json trace = Json::parse(json, error);
+  EXPECT_TRUE(error.empty()) << error;
+  std::vector<Json> events;
+  for (const Json& event : trace["traceEvents"].array_items()) {
+    if (event["cat"].string_value() == category) events.push_back(event);
+  }
+  return events;
+}
+
+std::string Export() {
+  std::string json;
+  TraceLog::GetInstance()->ExportJson(&json);
+  return json;
+}
+
+class TraceLogTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    TraceLog::GetInstance()->SetEnabled(false);
+    TraceLog::GetInstance()->Clear();
+  }
+
+  void TearDown() override { TraceLog::GetInstance()->SetEnabled(false); }
+};
+
+TEST_F(TraceLogTest, RecordsSlicesWhileEnabled) {
+  { TRACE_EVENT("weex.test", "Ignored"); }
+  EXPECT_TRUE(Events(Export(), "weex.test").empty());
+
+  TraceLog::GetInstance()->SetEnabled(true);
+  {
+    TRACE_EVENT_WITH_ARG("weex.test", "Outer", "page \"1\"\n");
+    TRACE_EVENT("weex.test", "Inner");
+  }
+  TraceLog::GetInstance()->SetEnabled(false);
+
+  std::string json = Export();
+  std::vector<Json> events = Events(json, "weex.test");
+  ASSERT_EQ(4u, events.size());
+  EXPECT_EQ("B", events[0]["ph"].string_value());
+  EXPECT_EQ("Outer", events[0]["name"].string_value());
+  EXPECT_EQ("page \"1\"\n", events[0]["args"]["arg"].string_value());
+  EXPECT_EQ("B", events[1]["ph"].string_value());
+  EXPECT_EQ("Inner", events[1]["name"].string_value());
+  EXPECT_EQ("E", events[2]["ph"].string_value());
+  EXPECT_EQ("E", events[3]["ph"].string_value());
+  for (const Json& event : events) {
+    EXPECT_EQ(getpid(), event["pid"].int_value());
+    EXPECT_TRUE(event["bind_id"].is_null());
+  }
+  EXPECT_LE(events[0]["ts"].number_value(), events[3]["ts"].number_value());
+
+  // Every thread that recorded is named by a metadata event.
+  bool named = false;
+  for (const Json& event : Events(json, "")) {
+    named |= event["ph"].string_value() == "M" &&
+             event["tid"].int_value() == events[0]["tid"].int_value();
+  }
+  EXPECT_TRUE(named);
+}
+
+TEST_F(TraceLogTest, FlowIds) {
+  uint64_t first = TraceLog::NewFlowId();
+  uint64_t second = TraceLog::NewFlowId();
+  EXPECT_NE(first, second);
+  EXPECT_EQ(static_cast<uint64_t>(getpid()), first >> 32);
+  EXPECT_NE(0u, first & 0xffffffffu);
+
+  EXPECT_EQ(0u, TraceLog::CurrentFlowId());
+  {
+    ScopedTraceFlow flow(first);
+    EXPECT_EQ(first, TraceLog::CurrentFlowId());
+    {
+      ScopedTraceFlow nested(second);
+      EXPECT_EQ(second, TraceLog::CurrentFlowId());
+    }
+    EXPECT_EQ(first, TraceLog::CurrentFlowId());
+  }
+  EXPECT_EQ(0u, TraceLog::CurrentFlowId());
+}
+
+TEST_F(TraceLogTest, FlowsBindSlicesAcrossThreads) {
+  TraceLog::GetInstance()->SetEnabled(true);
+  uint64_t flow_id = TraceLog::NewFlowId();
+  {
+    ScopedTraceFlow flow(flow_id);
+    TRACE_EVENT("weex.flow", "Post");
+  }
+  // The flow is handed over the way task queues do it.
+  std::thread([flow_id] {
+    ScopedTraceFlow flow(flow_id);
+    TRACE_EVENT("weex.flow", "Run");
+  }).join();
+  TraceLog::GetInstance()->SetEnabled(false);
+
+  char bind_id[32];
+  snprintf(bind_id, sizeof(bind_id), "0x%llx",
+           static_cast<unsigned long long>(flow_id));
+  std::vector<int> tids;
+  for (const Json& event : Events(Export(), "weex.flow")) {
+    if (event["ph"].string_value() != "B") continue;
+    EXPECT_EQ(bind_id, event["bind_id"].string_value());
+    EXPECT_TRUE(event["flow_in"].bool_value());
+    EXPECT_TRUE(event["flow_out"].bool_value());
+    tids.push_back(event["tid"].int_value());
+  }
+  ASSERT_EQ(2u, tids.size());
+  EXPECT_NE(tids[0], tids[1]);
+}
+
+TEST_F(TraceLogTest, KeepsLatestEventsPerThread) {
+  const size_t kRing = TraceLog::kEventsPerThread;
+  const size_t kExtra = 10;
+  TraceLog::GetInstance()->SetEnabled(true);
+  std::thread([&] {
+    for (size_t i = 0; i < kRing + kExtra; i++) {
+      TraceLog::GetInstance()->AddEvent('i', "weex.ring",
+                                        std::to_string(i).c_str());
+    }
+  }).join();
+  TraceLog::GetInstance()->SetEnabled(false);
+
+  std::vector<Json> events = Events(Export(), "weex.ring");
+  ASSERT_EQ(kRing, events.size());
+  EXPECT_EQ(std::to_string(kExtra), events.front()["name"].string_value());
+  EXPECT_EQ(std::to_string(kRing + kExtra - 1),
+            events.back()["name"].string_value());
+  EXPECT_EQ("t", events.front()["s"].string_value());
+
+  TraceLog::GetInstance()->Clear();
+  EXPECT_TRUE(Events(Export(), "weex.ring").empty());
+}
+
+TEST_F(TraceLogTest, WriteJson) {
+  TraceLog::GetInstance()->SetEnabled(true);
+  { TRACE_EVENT("weex.file", "Write"); }
+  TraceLog::GetInstance()->SetEnabled(false);
+
+  char path[] = "/tmp/trace_log_test_XXXXXX";
+  int fd = mkstemp(path);
+  ASSERT_GE(fd, 0);
+  close(fd);
+  ASSERT_TRUE(TraceLog::GetInstance()->WriteJson(path));
+  std::string written;
+  FILE* file = fopen(path, "r");
+  ASSERT_NE(nullptr, file);
+  char buffer[4096];
+  size_t read;
+  while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    written.append(buffer, read);
+  }
+  fclose(file);
+  unlink(path);
+
+  EXPECT_EQ(Export(), written);
+  EXPECT_EQ(2u, Events(written, "weex.file").size());
+}
+
+}  // namespace
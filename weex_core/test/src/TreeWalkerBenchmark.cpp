@@ -0,0 +1,175 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+// Traversal benchmark of the explicit stack TreeWalker the core uses instead
+// of recursion: checks that a pre-order walk of a bushy layout tree matches a
+// recursive walk node for node, including the child indices handed to
+// SendLayoutAction, then walks and frees a very deep chain that a recursive
+// walk could overflow the stack on. Prints nodes per second of both walks and
+// exits non zero on any mismatch.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+
+#include "core/layout/layout.h"
+#include "core/layout/tree_walker.h"
+
+namespace {
+
+using WeexCore::Index;
+using WeexCore::TreeWalker;
+using WeexCore::WXCoreLayoutNode;
+
+struct Visit {
+  WXCoreLayoutNode* node;
+  Index index;
+  size_t depth;
+};
+
+// Every node gets |fanout| children until |count| nodes exist, breadth first.
+WXCoreLayoutNode* BuildBushy(int count, int fanout) {
+  std::vector<WXCoreLayoutNode*> nodes;
+  nodes.reserve(count);
+  nodes.push_back(new WXCoreLayoutNode());
+  for (int i = 1; i < count; ++i) {
+    WXCoreLayoutNode* parent = nodes[(i - 1) / fanout];
+    WXCoreLayoutNode* child = new WXCoreLayoutNode();
+    parent->addChildAt(child, parent->getChildCount());
+    nodes.push_back(child);
+  }
+  return nodes[0];
+}
+
+WXCoreLayoutNode* BuildChain(int depth) {
+  WXCoreLayoutNode* root = new WXCoreLayoutNode();
+  WXCoreLayoutNode* tail = root;
+  for (int i = 1; i < depth; ++i) {
+    WXCoreLayoutNode* child = new WXCoreLayoutNode();
+    tail->addChildAt(child, 0);
+    tail = child;
+  }
+  return root;
+}
+
+void WalkRecursively(WXCoreLayoutNode* node, Index index, size_t depth,
+                     std::vector<Visit>* visits) {
+  visits->push_back({node, index, depth});
+  for (Index i = 0; i < node->getChildCount(); ++i) {
+    WalkRecursively(node->getChildAt(i), i, depth + 1, visits);
+  }
+}
+
+void Walk(WXCoreLayoutNode* root, std::vector<Visit>* visits) {
+  for (TreeWalker<WXCoreLayoutNode> walker(root); !walker.Done();
+       walker.Next()) {
+    visits->push_back({walker.node(), walker.index(), walker.depth()});
+  }
+}
+
+// Same bottom-up order as the RenderObject destructor.
+void Free(WXCoreLayoutNode* root) {
+  for (TreeWalker<WXCoreLayoutNode> walker(root, 0, true); !walker.Done();
+       walker.Next()) {
+    if (walker.leaving()) {
+      walker.node()->removeAllChildren();
+      if (walker.node() != root) delete walker.node();
+    }
+  }
+  delete root;
+}
+
+template <typename Fn>
+double Time(int rounds, Fn fn) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; ++i) fn();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+             .count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int depth = 100000;
+  int node_count = 100000;
+  int rounds = 20;
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (strcmp(argv[i], "--depth") == 0) depth = atoi(argv[++i]);
+    if (strcmp(argv[i], "--nodes") == 0) node_count = atoi(argv[++i]);
+    if (strcmp(argv[i], "--rounds") == 0) rounds = atoi(argv[++i]);
+  }
+
+  int mismatches = 0;
+  WXCoreLayoutNode* bushy = BuildBushy(node_count, 4);
+  std::vector<Visit> expected, actual;
+  expected.reserve(node_count);
+  actual.reserve(node_count);
+  WalkRecursively(bushy, 0, 0, &expected);
+  Walk(bushy, &actual);
+  if (expected.size() != actual.size()) ++mismatches;
+  for (size_t i = 0; i < expected.size() && i < actual.size(); ++i) {
+    if (expected[i].node != actual[i].node ||
+        expected[i].index != actual[i].index ||
+        expected[i].depth != actual[i].depth) {
+      ++mismatches;
+    }
+  }
+
+  double recursive = Time(rounds, [&] {
+    expected.clear();
+    WalkRecursively(bushy, 0, 0, &expected);
+  });
+  double walker = Time(rounds, [&] {
+    actual.clear();
+    Walk(bushy, &actual);
+  });
+  Free(bushy);
+
+  WXCoreLayoutNode* chain = BuildChain(depth);
+  size_t entered = 0, left = 0, deepest = 0;
+  double chain_walk = Time(1, [&] {
+    for (TreeWalker<WXCoreLayoutNode> walker(chain, 0, true); !walker.Done();
+         walker.Next()) {
+      if (walker.leaving()) {
+        ++left;
+      } else {
+        ++entered;
+        if (walker.depth() > deepest) deepest = walker.depth();
+      }
+    }
+  });
+  double chain_free = Time(1, [&] { Free(chain); });
+  if (entered != static_cast<size_t>(depth) ||
+      left != static_cast<size_t>(depth) ||
+      deepest != static_cast<size_t>(depth - 1)) {
+    ++mismatches;
+  }
+
+  double visits = static_cast<double>(node_count) * rounds;
+  printf("%-26s %14s %14s %14s\n", "", "recursive", "walker", "ratio");
+  printf("%-26s %14.1f %14.1f %13.2fx\n", "bushy M nodes/s",
+         visits / recursive / 1e6, visits / walker / 1e6, recursive / walker);
+  printf("%-26s %14.2f\n", "chain walk ms", chain_walk * 1e3);
+  printf("%-26s %14.2f\n", "chain free ms", chain_free * 1e3);
+  printf("%-26s %14zu\n", "chain depth", deepest + 1);
+  if (mismatches != 0) printf("%d visits differ\n", mismatches);
+  return mismatches == 0 ? 0 : 1;
+}
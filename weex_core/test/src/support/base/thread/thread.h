@@ -0,0 +1,42 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+// Stand-in for base/thread/thread.h in host-built tests. The core headers pull
+// it in through core/manager/weex_core_manager.h, but the real thread only has
+// Android and iOS message pumps; tests never start a script thread.
+
+#ifndef BASE_THREAD_THREAD_H
+#define BASE_THREAD_THREAD_H
+
+#include "base/message_loop/message_loop.h"
+
+namespace weex {
+namespace base {
+
+class Thread {
+ public:
+  explicit Thread(MessageLoop::Type type) {}
+  void Start() {}
+  void Stop() {}
+  MessageLoop* message_loop() { return nullptr; }
+};
+
+}  // namespace base
+}  // namespace weex
+
+#endif  // BASE_THREAD_THREAD_H
@@ -0,0 +1,224 @@
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+// A PlatformSide that accepts every call and records the render actions the
+// core sends, so host-built tests can drive RenderManager and RenderPage
+// without a platform attached.
+
+#ifndef TEST_SUPPORT_TEST_PLATFORM_SIDE_H
+#define TEST_SUPPORT_TEST_PLATFORM_SIDE_H
+
+#include <string>
+#include <vector>
+
+#include "core/bridge/platform_bridge.h"
+#include "core/manager/weex_core_manager.h"
+#include "core/render/node/render_object.h"
+
+namespace WeexCore {
+
+class TestPlatformSide : public PlatformBridge::PlatformSide {
+ public:
+  int create_body_count = 0;
+  int add_element_count = 0;
+  int remove_element_count = 0;
+  int layout_count = 0;
+  int measure_count = 0;
+  std::vector<std::pair<std::string, std::string>> updated_styles;
+  std::vector<std::pair<std::string, std::string>> updated_attrs;
+
+  // Installs a fresh TestPlatformSide on the WeexCoreManager singleton and
+  // returns it; the bridge owns it.
+  static TestPlatformSide* Install() {
+    static PlatformBridge* bridge = new PlatformBridge();
+    TestPlatformSide* side = new TestPlatformSide();
+    bridge->set_platform_side(side);
+    WeexCoreManager::Instance()->set_platform_bridge(bridge);
+    return side;
+  }
+
+  void Reset() {
+    create_body_count = 0;
+    add_element_count = 0;
+    remove_element_count = 0;
+    layout_count = 0;
+    measure_count = 0;
+    updated_styles.clear();
+    updated_attrs.clear();
+  }
+
+  // Measures text as 10 by 10 per character of its value attribute.
+  WXCoreSize InvokeMeasureFunction(const char* page_id, long render_ptr,
+                                   float width, int width_measure_mode,
+                                   float height,
+                                   int height_measure_mode) override {
+    ++measure_count;
+    RenderObject* render = convert_long_to_render_object(render_ptr);
+    WXCoreSize size;
+    size.width = 10 * render->GetAttr("value").size();
+    size.height = 10;
+    return size;
+  }
+  void InvokeLayoutBefore(const char* page_id, long render_ptr) override {}
+  void InvokeLayoutPlatform(const char* page_id, long render_ptr) override {}
+  void InvokeLayoutAfter(const char* page_id, long render_ptr, float width,
+                         float height) override {}
+  void TriggerVSync(const char* page_id) override {}
+  void SetJSVersion(const char* version) override {}
+  void ReportException(const char* page_id, const char* func,
+                       const char* exception_string) override {}
+  void ReportServerCrash(const char* instance_id) override {}
+  void ReportNativeInitStatus(const char* status_code,
+                              const char* error_msg) override {}
+  int CallNative(const char* page_id, const char* task,
+                 const char* callback) override {
+    return 0;
+  }
+  std::unique_ptr<ValueWithType> CallNativeModule(
+      const char* page_id, const char* module, const char* method,
+      const char* arguments, int arguments_length, const char* options,
+      int options_length) override {
+    return std::unique_ptr<ValueWithType>();
+  }
+  void CallNativeComponent(const char* page_id, const char* ref,
+                           const char* method, const char* arguments,
+                           int arguments_length, const char* options,
+                           int options_length) override {}
+  void SetTimeout(const char* callback_id, const char* time) override {}
+  void NativeLog(const char* str_array) override {}
+  int UpdateFinish(const char* page_id, const char* task, int taskLen,
+                   const char* callback, int callbackLen) override {
+    return 0;
+  }
+  int RefreshFinish(const char* page_id, const char* task,
+                    const char* callback) override {
+    return 0;
+  }
+  int AddEvent(const char* page_id, const char* ref,
+               const char* event) override {
+    return 0;
+  }
+  int RemoveEvent(const char* page_id, const char* ref,
+                  const char* event) override {
+    return 0;
+  }
+  int CreateBody(const char* pageId, const char* componentType,
+                 const char* ref, SmallStringMap* styles,
+                 SmallStringMap* attributes, SmallStringSet* events,
+                 const WXCoreMargin& margins, const WXCorePadding& paddings,
+                 const WXCoreBorderWidth& borders) override {
+    ++create_body_count;
+    return 0;
+  }
+  int AddElement(const char* pageId, const char* componentType,
+                 const char* ref, int& index, const char* parentRef,
+                 SmallStringMap* styles, SmallStringMap* attributes,
+                 SmallStringSet* events, const WXCoreMargin& margins,
+                 const WXCorePadding& paddings,
+                 const WXCoreBorderWidth& borders,
+                 bool willLayout = true) override {
+    ++add_element_count;
+    return 0;
+  }
+  int AddChildToRichtext(const char* pageId, const char* nodeType,
+                         const char* ref, const char* parentRef,
+                         const char* richtextRef, SmallStringMap* styles,
+                         SmallStringMap* attributes) override {
+    return 0;
+  }
+  int Layout(const char* page_id, const char* ref, float top, float bottom,
+             float left, float right, float height, float width, bool isRTL,
+             int index) override {
+    ++layout_count;
+    return 0;
+  }
+  int UpdateStyle(
+      const char* pageId, const char* ref,
+      std::vector<std::pair<std::string, std::string>>* style,
+      std::vector<std::pair<std::string, std::string>>* margin,
+      std::vector<std::pair<std::string, std::string>>* padding,
+      std::vector<std::pair<std::string, std::string>>* border) override {
+    for (auto* pairs : {style, margin, padding, border}) {
+      if (pairs != nullptr) {
+        updated_styles.insert(updated_styles.end(), pairs->begin(),
+                              pairs->end());
+      }
+    }
+    return 0;
+  }
+  int UpdateAttr(
+      const char* pageId, const char* ref,
+      std::vector<std::pair<std::string, std::string>>* attrs) override {
+    if (attrs != nullptr) {
+      updated_attrs.insert(updated_attrs.end(), attrs->begin(), attrs->end());
+    }
+    return 0;
+  }
+  int UpdateRichtextChildAttr(
+      const char* pageId, const char* ref,
+      std::vector<std::pair<std::string, std::string>>* attrs,
+      const char* parent_ref, const char* richtext_ref) override {
+    return 0;
+  }
+  int UpdateRichtextStyle(
+      const char* pageId, const char* ref,
+      std::vector<std::pair<std::string, std::string>>* style,
+      const char* parent_ref, const char* richtext_ref) override {
+    return 0;
+  }
+  int CreateFinish(const char* pageId) override { return 0; }
+  int RenderSuccess(const char* pageId) override { return 0; }
+  int RemoveElement(const char* pageId, const char* ref) override {
+    ++remove_element_count;
+    return 0;
+  }
+  int RemoveChildFromRichtext(const char* pageId, const char* ref,
+                              const char* parent_ref,
+                              const char* richtext_ref) override {
+    return 0;
+  }
+  int MoveElement(const char* pageId, const char* ref, const char* parentRef,
+                  int index) override {
+    return 0;
+  }
+  int AppendTreeCreateFinish(const char* pageId, const char* ref) override {
+    return 0;
+  }
+  int HasTransitionPros(
+      const char* pageId, const char* ref,
+      std::vector<std::pair<std::string, std::string>>* style) override {
+    return 0;
+  }
+  void PostMessage(const char* vm_id, const char* data,
+                   int dataLength) override {}
+  void DispatchMessage(const char* client_id, const char* data,
+                       int dataLength, const char* callback,
+                       const char* vm_id) override {}
+  std::unique_ptr<WeexJSResult> DispatchMessageSync(const char* client_id,
+                                                    const char* data,
+                                                    int dataLength,
+                                                    const char* vm_id) override {
+    return std::unique_ptr<WeexJSResult>();
+  }
+  void OnReceivedResult(long callback_id,
+                        std::unique_ptr<WeexJSResult>& result) override {}
+};
+
+}  // namespace WeexCore
+
+#endif  // TEST_SUPPORT_TEST_PLATFORM_SIDE_H